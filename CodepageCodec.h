@@ -0,0 +1,28 @@
+#pragma once
+
+
+// Built-in table driven conversion of a codepage, used by the codepage encodings instead of
+// the conversion functions of the system.
+struct ICodepageCodec
+{
+	virtual ~ICodepageCodec() {}
+
+	// Returns the first byte of the first invalid sequence, s_end if the whole text is valid.
+	// utf16_length receives the number of UTF-16 units of the valid part.
+	virtual const char* Validate(const char* s_begin, const char* s_end, size_t& utf16_length) const = 0;
+	// Converts the text up to the first invalid sequence and returns that sequence, s_end if the
+	// whole text is valid. dst must have room for one unit per byte or for the units counted by
+	// Validate(), it is moved past the written units.
+	virtual const char* Decode(const char* s_begin, const char* s_end, wchar_t*& dst) const = 0;
+
+	// Returns the number of bytes of the encoded text.
+	virtual size_t GetEncodedSize(const wchar_t* s_begin, const wchar_t* s_end) const = 0;
+	// The characters that are missing from the codepage are written as '?', a surrogate pair
+	// is a single character. dst must have room for GetEncodedSize() or GetMaxByteCount() bytes.
+	// Returns the end of the written bytes.
+	virtual char* Encode(const wchar_t* s_begin, const wchar_t* s_end, char* dst) const = 0;
+	virtual size_t GetMaxByteCount(size_t utf16_chars) const = 0;
+
+	// The 256 entry decode table of the single byte codepages, NULL for the others.
+	virtual const unsigned short* GetSingleByteTable() const	{ return NULL; }
+};
@@ -0,0 +1,317 @@
+#include "stdafx.h"
+#include "DirectoryWalker.h"
+#include <wctype.h>
+
+
+bool WildcardMatch(const wchar_t* pattern, const wchar_t* name)
+{
+	// position after the last '*' and the name position it is currently matched to
+	const wchar_t* star = NULL;
+	const wchar_t* star_name = NULL;
+	while (*name)
+	{
+		if (*pattern == L'*')
+		{
+			star = ++pattern;
+			star_name = name;
+		}
+		else if (*pattern==L'?' || (*pattern && towlower(*pattern)==towlower(*name)))
+		{
+			++pattern;
+			++name;
+		}
+		else if (star)
+		{
+			// letting the last '*' swallow one more character
+			pattern = star;
+			name = ++star_name;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	while (*pattern == L'*')
+		++pattern;
+	return !*pattern;
+}
+
+static bool HasWildcards(const wstring& s)
+{
+	return s.find_first_of(L"*?") != wstring::npos;
+}
+
+// Splits the path at the separators, empty components are dropped.
+static void SplitPath(const wchar_t* path, std::vector<wstring>& components)
+{
+	const wchar_t* begin = path;
+	for (const wchar_t* p=path; ; ++p)
+	{
+		if (!*p || IsPathSeparator(*p))
+		{
+			if (p > begin)
+				components.push_back(wstring(begin, p));
+			if (!*p)
+				break;
+			begin = p + 1;
+		}
+	}
+}
+
+// Matches path components against pattern components where "**" matches zero or more components.
+static bool MatchPathComponents(const std::vector<wstring>& pattern, size_t pattern_index,
+								const std::vector<wstring>& path, size_t path_index)
+{
+	for (; pattern_index<pattern.size(); ++pattern_index,++path_index)
+	{
+		if (pattern[pattern_index] == L"**")
+		{
+			for (size_t i=path_index; i<=path.size(); ++i)
+			{
+				if (MatchPathComponents(pattern, pattern_index+1, path, i))
+					return true;
+			}
+			return false;
+		}
+		if (path_index >= path.size() || !WildcardMatch(pattern[pattern_index].c_str(), path[path_index].c_str()))
+			return false;
+	}
+	return path_index == path.size();
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// CPathPattern
+//-------------------------------------------------------------------------------------------------
+
+
+bool CPathPattern::Parse(const wchar_t* pattern)
+{
+	m_Pattern = pattern;
+	m_BaseDir.clear();
+	m_Components.clear();
+
+	// The base dir ends at the separator that precedes the first component with wildcards.
+	size_t base_dir_len = 0;
+	for (size_t begin=0,len=m_Pattern.size(); begin<len; )
+	{
+		size_t end = begin;
+		while (end<len && !IsPathSeparator(m_Pattern[end]))
+			++end;
+		if (HasWildcards(m_Pattern.substr(begin, end-begin)))
+			break;
+		if (end < len)
+			base_dir_len = end + 1;
+		begin = end + 1;
+	}
+	m_BaseDir = m_Pattern.substr(0, base_dir_len);
+
+	std::vector<wstring> components;
+	SplitPath(m_Pattern.c_str()+base_dir_len, components);
+	for (size_t i=0,e=components.size(); i<e; ++i)
+	{
+		// "**/**" is the same as "**"
+		if (components[i]==L"**" && !m_Components.empty() && m_Components.back()==L"**")
+			continue;
+		m_Components.push_back(components[i]);
+	}
+
+	// the last component has to match the file names
+	return !m_Components.empty() && m_Components.back()!=L"**";
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// CExcludeFilter
+//-------------------------------------------------------------------------------------------------
+
+
+bool CExcludeFilter::AddPattern(const wchar_t* pattern)
+{
+	TPathComponents components;
+	SplitPath(pattern, components);
+	if (components.empty())
+		return false;
+
+	bool has_separator = false;
+	for (const wchar_t* p=pattern; *p; ++p)
+		has_separator |= IsPathSeparator(*p);
+
+	if (has_separator)
+		m_PathPatterns.push_back(components);
+	else
+		m_NamePatterns.push_back(components[0]);
+	return true;
+}
+
+bool CExcludeFilter::IsExcluded(const wchar_t* name, const std::vector<wstring>& relative_path) const
+{
+	for (size_t i=0,e=m_NamePatterns.size(); i<e; ++i)
+	{
+		if (WildcardMatch(m_NamePatterns[i].c_str(), name))
+			return true;
+	}
+	for (size_t i=0,e=m_PathPatterns.size(); i<e; ++i)
+	{
+		if (MatchPathComponents(m_PathPatterns[i], 0, relative_path, 0))
+			return true;
+	}
+	return false;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// CDirectoryWalker
+//-------------------------------------------------------------------------------------------------
+
+
+CDirectoryWalker::CDirectoryWalker(const CPathPattern& pattern, const CExcludeFilter& exclude_filter, IFileJobSink& pool)
+: m_Pattern(pattern)
+, m_ExcludeFilter(exclude_filter)
+, m_Pool(pool)
+, m_Separator(L'\\')
+, m_PendingDirs(0)
+, m_MatchCount(0)
+, m_ErrorCount(0)
+{
+	// using the same separator as the user
+	const wstring& s = pattern.GetPattern();
+	wstring::size_type i = s.find_first_of(L"\\/");
+	if (i != wstring::npos)
+		m_Separator = s[i];
+}
+
+int CDirectoryWalker::Walk(int thread_count)
+{
+	SDirJob root;
+	root.dir = m_Pattern.GetBaseDir();
+	AddState(root.states, 0);
+	m_PendingDirs = 1;
+	m_Queue.Push(root);
+
+	std::vector<HANDLE> threads;
+	for (int i=1; i<thread_count; ++i)
+	{
+		HANDLE thread = (HANDLE)_beginthreadex(NULL, 0, WalkerThreadProc, this, 0, NULL);
+		if (!thread)
+			break;
+		threads.push_back(thread);
+	}
+
+	WalkerThread();
+
+	for (size_t i=0,e=threads.size(); i<e; ++i)
+	{
+		WaitForSingleObject(threads[i], INFINITE);
+		CloseHandle(threads[i]);
+	}
+
+	if (!m_MatchCount && !m_ErrorCount)
+	{
+		Error(L"%s: No matching files found!", m_Pattern.GetPattern().c_str());
+		return 1;
+	}
+	return (int)m_ErrorCount;
+}
+
+// Adds the state and the states reachable from it because "**" can match zero directories.
+void CDirectoryWalker::AddState(std::vector<int>& states, int state) const
+{
+	if (std::find(states.begin(), states.end(), state) != states.end())
+		return;
+	states.push_back(state);
+	if (m_Pattern.IsAnyDirs(state))
+		AddState(states, state+1);
+}
+
+void CDirectoryWalker::ListDir(const SDirJob& job)
+{
+	wstring search_pattern = job.dir + L"*";
+	WIN32_FIND_DATA find_data;
+	SFindHandle hFind = FindFirstFile(search_pattern.c_str(), &find_data);
+	if (hFind == INVALID_HANDLE_VALUE)
+	{
+		DWORD last_error = GetLastError();
+		if (last_error != ERROR_FILE_NOT_FOUND)
+			WalkError(job.dir, last_error);
+		return;
+	}
+
+	int last_component = m_Pattern.GetComponentCount() - 1;
+	std::vector<wstring> relative_path = job.relative_path;
+	relative_path.push_back(wstring());
+	do
+	{
+		const wchar_t* name = find_data.cFileName;
+		if (name[0]==L'.' && (!name[1] || (name[1]==L'.' && !name[2])))
+			continue;
+
+		relative_path.back() = name;
+		if (m_ExcludeFilter.IsExcluded(name, relative_path))
+			continue;
+
+		if (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+		{
+			// not following junctions and symlinks, they can form loops
+			if (find_data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)
+				continue;
+
+			SDirJob sub_job;
+			for (size_t i=0,e=job.states.size(); i<e; ++i)
+			{
+				int state = job.states[i];
+				if (m_Pattern.IsAnyDirs(state))
+					AddState(sub_job.states, state);
+				else if (state<last_component && m_Pattern.MatchComponent(state, name))
+					AddState(sub_job.states, state+1);
+			}
+			// pruning the directories that can't contain matching files
+			if (sub_job.states.empty())
+				continue;
+
+			sub_job.dir = job.dir + name;
+			sub_job.dir.push_back(m_Separator);
+			sub_job.relative_path = relative_path;
+			InterlockedIncrement(&m_PendingDirs);
+			m_Queue.Push(sub_job);
+		}
+		else
+		{
+			if (std::find(job.states.begin(), job.states.end(), last_component) != job.states.end() &&
+				m_Pattern.MatchComponent(last_component, name))
+			{
+				InterlockedIncrement(&m_MatchCount);
+				m_Pool.AddJob(job.dir + name);
+			}
+		}
+	}
+	while (FindNextFile(hFind, &find_data));
+
+	DWORD last_error = GetLastError();
+	if (last_error != ERROR_NO_MORE_FILES)
+		WalkError(job.dir, last_error);
+}
+
+void CDirectoryWalker::WalkError(const wstring& path, DWORD last_error)
+{
+	InterlockedIncrement(&m_ErrorCount);
+	Error(L"%s: %s", path.empty() ? L"." : path.c_str(), LastErrorToString(last_error).c_str());
+}
+
+unsigned __stdcall CDirectoryWalker::WalkerThreadProc(void* param)
+{
+	((CDirectoryWalker*)param)->WalkerThread();
+	return 0;
+}
+
+void CDirectoryWalker::WalkerThread()
+{
+	SDirJob job;
+	while (m_Queue.Pop(job))
+	{
+		ListDir(job);
+		// the last listed directory closes the queue
+		if (!InterlockedDecrement(&m_PendingDirs))
+			m_Queue.Close();
+	}
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+
+#include "JobQueue.h"
+
+
+// Case insensitive matching of a single path component against a pattern
+// that can contain the * and ? wildcards.
+bool WildcardMatch(const wchar_t* pattern, const wchar_t* name);
+
+inline bool IsPathSeparator(wchar_t c)
+{
+	return c==L'\\' || c==L'/';
+}
+
+
+// A file path pattern like "c:\code\**\*.vcproj". The components of the pattern can contain
+// the * and ? wildcards, a "**" component matches zero or more directories.
+class CPathPattern
+{
+public:
+	// Returns false if the pattern is invalid.
+	bool Parse(const wchar_t* pattern);
+
+	const wstring& GetPattern() const						{ return m_Pattern; }
+	// The leading part of the pattern without wildcards, empty or ends with a separator.
+	const wstring& GetBaseDir() const						{ return m_BaseDir; }
+	// True if the pattern has wildcards in its directory part or it has a "**" component.
+	// Non recursive patterns can be expanded with a single FindFirstFile() call.
+	bool IsRecursive() const								{ return m_Components.size() > 1; }
+
+	// The components after the base dir. The last one matches the file name.
+	int GetComponentCount() const							{ return (int)m_Components.size(); }
+	bool IsAnyDirs(int component) const						{ return m_Components[component] == L"**"; }
+	bool MatchComponent(int component, const wchar_t* name) const	{ return WildcardMatch(m_Components[component].c_str(), name); }
+
+private:
+	wstring m_Pattern;
+	wstring m_BaseDir;
+	std::vector<wstring> m_Components;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+
+// Prunes the directories and files that are matched by the -EXCLUDE patterns. A pattern without
+// path separators is matched against the name of each directory and file, other patterns
+// are matched against the path relative to the directory where the walk started.
+class CExcludeFilter
+{
+public:
+	// Returns false if the pattern is invalid.
+	bool AddPattern(const wchar_t* pattern);
+	bool IsEmpty() const									{ return m_NamePatterns.empty() && m_PathPatterns.empty(); }
+	bool IsExcluded(const wchar_t* name, const std::vector<wstring>& relative_path) const;
+
+private:
+	typedef std::vector<wstring> TPathComponents;
+	std::vector<wstring> m_NamePatterns;
+	std::vector<TPathComponents> m_PathPatterns;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+
+// Expands recursive path patterns on several threads. The directories are listed in parallel
+// and each matching file is passed to the job pool as soon as it is found.
+class CDirectoryWalker
+{
+public:
+	CDirectoryWalker(const CPathPattern& pattern, const CExcludeFilter& exclude_filter, IFileJobSink& pool);
+
+	// Lists the directories on thread_count threads including the calling thread.
+	// Returns the number of errors.
+	int Walk(int thread_count);
+
+private:
+	struct SDirJob
+	{
+		wstring dir;								// empty or ends with a separator
+		std::vector<wstring> relative_path;			// components of dir relative to the base dir
+		std::vector<int> states;					// pattern components to be matched by the entries of dir
+	};
+
+	void AddState(std::vector<int>& states, int state) const;
+	void ListDir(const SDirJob& job);
+	void WalkError(const wstring& path, DWORD last_error);
+
+	static unsigned __stdcall WalkerThreadProc(void* param);
+	void WalkerThread();
+
+private:
+	const CPathPattern& m_Pattern;
+	const CExcludeFilter& m_ExcludeFilter;
+	IFileJobSink& m_Pool;
+	wchar_t m_Separator;
+
+	CJobQueue<SDirJob> m_Queue;
+	// number of directories that are queued or being listed
+	volatile LONG m_PendingDirs;
+	volatile LONG m_MatchCount;
+	volatile LONG m_ErrorCount;
+};
@@ -0,0 +1,365 @@
+#include "stdafx.h"
+#include "DirectoryWatcher.h"
+
+#ifndef _WIN32
+#include <poll.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+#endif
+
+
+// The time a file has to be left alone after its last change before it is reported.
+static const DWORD SETTLE_TIME_MS = 500;
+// ReadDirectoryChangesW() fails with bigger buffers on network shares.
+static const DWORD NOTIFY_BUFFER_SIZE = 0x10000;
+
+static const wchar_t VCPROJ_EXT[] = L".vcproj";
+
+#ifdef __linux__
+// The removals aren't watched, the removed files are reported when they come back.
+static const uint32_t WATCH_MASK = IN_CREATE | IN_MOVED_TO | IN_MOVED_FROM | IN_MODIFY | IN_CLOSE_WRITE | IN_ONLYDIR;
+#endif
+
+
+CDirectoryWatcher::CDirectoryWatcher(const CExcludeFilter& exclude_filter)
+: m_ExcludeFilter(exclude_filter)
+, m_Separator(L'\\')
+, m_StopEvent(NULL)
+#ifdef _WIN32
+, m_ReadPending(false)
+#else
+, m_Inotify(-1)
+#endif
+, m_Rescan(false)
+{
+#ifdef _WIN32
+	memset(&m_Overlapped, 0, sizeof(m_Overlapped));
+#endif
+}
+
+CDirectoryWatcher::~CDirectoryWatcher()
+{
+#ifdef _WIN32
+	if (m_ReadPending)
+	{
+		// the buffer must stay alive until the canceled read completes
+		CancelIo(m_DirHandle);
+		DWORD bytes;
+		GetOverlappedResult(m_DirHandle, &m_Overlapped, &bytes, TRUE);
+	}
+#else
+	if (m_Inotify >= 0)
+		close(m_Inotify);
+#endif
+}
+
+bool CDirectoryWatcher::Start(const wchar_t* dir, HANDLE stop_event)
+{
+	m_ErrorMessage.clear();
+	m_Dir = dir;
+#ifndef _WIN32
+	m_Separator = L'/';
+#endif
+	// using the same separator as the user
+	wstring::size_type i = m_Dir.find_first_of(L"\\/");
+	if (i != wstring::npos)
+		m_Separator = m_Dir[i];
+	if (m_Dir.empty())
+		m_Dir = wstring(L".") + m_Separator;
+	else if (!IsPathSeparator(m_Dir[m_Dir.size()-1]))
+		m_Dir.push_back(m_Separator);
+	m_StopEvent = stop_event;
+	m_Buffer.resize(NOTIFY_BUFFER_SIZE / sizeof(DWORD));
+	return StartWatching();
+}
+
+bool CDirectoryWatcher::WaitForChanges(std::vector<wstring>& filepaths, bool& rescan)
+{
+	m_ErrorMessage.clear();
+	filepaths.clear();
+	rescan = false;
+	while (1)
+	{
+		DWORD now = GetTickCount();
+		DWORD timeout = INFINITE;
+		for (std::map<wstring,DWORD>::iterator it=m_PendingFiles.begin(); it!=m_PendingFiles.end(); )
+		{
+			DWORD age = now - it->second;
+			if (age >= SETTLE_TIME_MS)
+			{
+				filepaths.push_back(it->first);
+				m_PendingFiles.erase(it++);
+			}
+			else
+			{
+				timeout = min(timeout, SETTLE_TIME_MS-age);
+				++it;
+			}
+		}
+		if (!filepaths.empty() || m_Rescan)
+		{
+			rescan = m_Rescan;
+			m_Rescan = false;
+			return true;
+		}
+
+		if (!ReadEvents(timeout))
+			return false;
+	}
+}
+
+#ifdef _WIN32
+
+bool CDirectoryWatcher::StartWatching()
+{
+	m_DirHandle = CreateFile(m_Dir.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ|FILE_SHARE_WRITE|FILE_SHARE_DELETE,
+		NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS|FILE_FLAG_OVERLAPPED, NULL);
+	if (m_DirHandle == INVALID_HANDLE_VALUE)
+		return WinError(L"Error opening directory %s!", m_Dir.c_str());
+	m_ReadEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	if (!m_ReadEvent)
+		return WinError(L"Error creating event!");
+	return IssueRead();
+}
+
+bool CDirectoryWatcher::IssueRead()
+{
+	memset(&m_Overlapped, 0, sizeof(m_Overlapped));
+	m_Overlapped.hEvent = m_ReadEvent;
+	DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+	if (!ReadDirectoryChangesW(m_DirHandle, &m_Buffer[0], NOTIFY_BUFFER_SIZE, TRUE, filter, NULL, &m_Overlapped, NULL))
+		return WinError(L"Error watching directory %s!", m_Dir.c_str());
+	m_ReadPending = true;
+	return true;
+}
+
+bool CDirectoryWatcher::ReadEvents(DWORD timeout)
+{
+	HANDLE handles[2] = { m_ReadEvent, m_StopEvent };
+	DWORD res = WaitForMultipleObjects(2, handles, FALSE, timeout);
+	if (res == WAIT_TIMEOUT)
+		return true;
+	if (res == WAIT_OBJECT_0+1)
+		return false;
+	if (res != WAIT_OBJECT_0)
+		return WinError(L"Error waiting for directory changes!");
+
+	m_ReadPending = false;
+	DWORD bytes;
+	if (!GetOverlappedResult(m_DirHandle, &m_Overlapped, &bytes, FALSE))
+	{
+		if (GetLastError() != ERROR_NOTIFY_ENUM_DIR)
+			return WinError(L"Error watching directory %s!", m_Dir.c_str());
+		bytes = 0;
+	}
+
+	DWORD now = GetTickCount();
+	if (!bytes)
+	{
+		// the buffer overflowed, the events are lost
+		m_Rescan = true;
+	}
+	else
+	{
+		const BYTE* p = (const BYTE*)&m_Buffer[0];
+		while (1)
+		{
+			const FILE_NOTIFY_INFORMATION* info = (const FILE_NOTIFY_INFORMATION*)p;
+			// the removed files are reported by the rename and write events when they come back
+			if (info->Action!=FILE_ACTION_REMOVED && info->Action!=FILE_ACTION_RENAMED_OLD_NAME)
+				AddEvent(info->FileName, info->FileNameLength/sizeof(wchar_t), now);
+			if (!info->NextEntryOffset)
+				break;
+			p += info->NextEntryOffset;
+		}
+	}
+	return IssueRead();
+}
+
+#elif defined(__linux__)
+
+bool CDirectoryWatcher::StartWatching()
+{
+	m_Inotify = inotify_init1(IN_NONBLOCK|IN_CLOEXEC);
+	if (m_Inotify < 0)
+		return WinError(L"Error watching directory %s!", m_Dir.c_str());
+	return AddWatches(wstring(), false, 0);
+}
+
+bool CDirectoryWatcher::AddWatches(const wstring& relative_dir, bool report_files, DWORD time)
+{
+	wstring dir = m_Dir + relative_dir;
+	int wd = inotify_add_watch(m_Inotify, ToNativePath(dir.c_str()).c_str(), WATCH_MASK);
+	if (wd < 0)
+	{
+		// a subdirectory may have been removed or replaced since its event
+		if (!relative_dir.empty() && (errno==ENOENT || errno==ENOTDIR))
+			return true;
+		return WinError(L"Error watching directory %s!", dir.c_str());
+	}
+	m_Watches[wd] = relative_dir;
+
+	WIN32_FIND_DATA find_data;
+	SFindHandle hFind = FindFirstFile((dir + L"*").c_str(), &find_data);
+	if (hFind == INVALID_HANDLE_VALUE)
+		return true;
+	do
+	{
+		const wchar_t* name = find_data.cFileName;
+		if (name[0]==L'.' && (!name[1] || (name[1]==L'.' && !name[2])))
+			continue;
+		wstring relative_path = relative_dir + name;
+		if (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+		{
+			// not following symlinks like the directory walker
+			if (find_data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)
+				continue;
+			if (IsExcluded(relative_path.c_str(), relative_path.size()))
+				continue;
+			if (!AddWatches(relative_path + m_Separator, report_files, time))
+				return false;
+		}
+		else if (report_files)
+		{
+			AddEvent(relative_path.c_str(), relative_path.size(), time);
+		}
+	}
+	while (FindNextFile(hFind, &find_data));
+	return true;
+}
+
+void CDirectoryWatcher::RemoveWatches(const wstring& relative_dir)
+{
+	for (std::map<int,wstring>::iterator it=m_Watches.begin(); it!=m_Watches.end(); )
+	{
+		if (0 == it->second.compare(0, relative_dir.size(), relative_dir))
+		{
+			inotify_rm_watch(m_Inotify, it->first);
+			m_Watches.erase(it++);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+bool CDirectoryWatcher::ReadEvents(DWORD timeout)
+{
+	struct pollfd fds[2] = { { m_Inotify, POLLIN, 0 }, { GetEventDescriptor(m_StopEvent), POLLIN, 0 } };
+	int res = poll(fds, 2, timeout==INFINITE ? -1 : (int)timeout);
+	if (res < 0)
+		return errno==EINTR || WinError(L"Error waiting for directory changes!");
+	if (fds[1].revents)
+		return false;
+	if (!fds[0].revents)
+		return true;
+
+	ssize_t bytes = read(m_Inotify, &m_Buffer[0], m_Buffer.size()*sizeof(DWORD));
+	if (bytes < 0)
+		return errno==EAGAIN || errno==EINTR || WinError(L"Error watching directory %s!", m_Dir.c_str());
+
+	DWORD now = GetTickCount();
+	const char* p = (const char*)&m_Buffer[0];
+	for (const char* end=p+bytes; p<end; )
+	{
+		const struct inotify_event* event = (const struct inotify_event*)p;
+		p += sizeof(struct inotify_event) + event->len;
+		if (event->mask & IN_Q_OVERFLOW)
+		{
+			// the events are lost
+			m_Rescan = true;
+			continue;
+		}
+		std::map<int,wstring>::iterator it = m_Watches.find(event->wd);
+		if (it == m_Watches.end())
+			continue;
+		if (event->mask & IN_IGNORED)
+		{
+			// the directory has been removed
+			m_Watches.erase(it);
+			continue;
+		}
+		if (!event->len)
+			continue;
+
+		wstring relative_path = it->second + FromNativePath(event->name);
+		if (event->mask & IN_ISDIR)
+		{
+			// a moved directory is watched again under its new name
+			if (event->mask & IN_MOVED_FROM)
+				RemoveWatches(relative_path + m_Separator);
+			else if ((event->mask & (IN_CREATE|IN_MOVED_TO)) && !IsExcluded(relative_path.c_str(), relative_path.size()))
+			{
+				if (!AddWatches(relative_path + m_Separator, true, now))
+					return false;
+			}
+		}
+		else if (!(event->mask & IN_MOVED_FROM))
+		{
+			AddEvent(relative_path.c_str(), relative_path.size(), now);
+		}
+	}
+	return true;
+}
+
+#else
+
+bool CDirectoryWatcher::StartWatching()
+{
+	SetLastError(ENOSYS);
+	return WinError(L"Error watching directory %s!", m_Dir.c_str());
+}
+
+bool CDirectoryWatcher::ReadEvents(DWORD timeout)
+{
+	return false;
+}
+
+#endif
+
+void CDirectoryWatcher::AddEvent(const wchar_t* relative_path, size_t len, DWORD time)
+{
+	size_t ext_len = wcslen(VCPROJ_EXT);
+	if (len<=ext_len || _wcsnicmp(relative_path+(len-ext_len), VCPROJ_EXT, ext_len))
+		return;
+	// checking the directories too because they would have been pruned by the walker
+	if (IsExcluded(relative_path, len))
+		return;
+	m_PendingFiles[m_Dir + wstring(relative_path, len)] = time;
+}
+
+bool CDirectoryWatcher::IsExcluded(const wchar_t* relative_path, size_t len) const
+{
+	if (m_ExcludeFilter.IsEmpty())
+		return false;
+	std::vector<wstring> path;
+	const wchar_t* end = relative_path + len;
+	for (const wchar_t* begin=relative_path; begin<end; )
+	{
+		const wchar_t* p = begin;
+		while (p<end && !IsPathSeparator(*p))
+			++p;
+		path.push_back(wstring(begin, p));
+		if (m_ExcludeFilter.IsExcluded(path.back().c_str(), path))
+			return true;
+		begin = p + 1;
+	}
+	return false;
+}
+
+bool CDirectoryWatcher::WinError(const wchar_t* fmtstr, ...)
+{
+	DWORD last_error = GetLastError();
+	wchar_t buf[0x400];
+	va_list args;
+	va_start(args, fmtstr);
+	vswprintf(buf, sizeof(buf)/sizeof(buf[0]), fmtstr, args);
+	va_end(args);
+	m_ErrorMessage = buf;
+	m_ErrorMessage.append(L" ");
+	m_ErrorMessage.append(LastErrorToString(last_error));
+	return false;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+
+#include "DirectoryWalker.h"
+
+
+// Reports the .vcproj files that are changed under a directory tree. The events of a file are
+// merged until the file has been left alone for a short time because the IDE and the editors
+// often save a file with several writes or with a delete and a rename.
+// Uses ReadDirectoryChangesW() on Windows and a recursive set of inotify watches on Linux.
+class CDirectoryWatcher
+{
+public:
+	CDirectoryWatcher(const CExcludeFilter& exclude_filter);
+	~CDirectoryWatcher();
+
+	// stop_event makes WaitForChanges() return.
+	bool Start(const wchar_t* dir, HANDLE stop_event);
+	// Blocks until some changed files settle. rescan is set if the change notifications
+	// overflowed and the whole tree has to be checked. Returns false on error or when the
+	// stop event is signaled, the error message is empty in the latter case.
+	bool WaitForChanges(std::vector<wstring>& filepaths, bool& rescan);
+	const wstring& GetErrorMessage() const				{ return m_ErrorMessage; }
+	// Ends with a separator.
+	const wstring& GetDir() const						{ return m_Dir; }
+
+private:
+	bool StartWatching();
+	// Waits at most timeout milliseconds for the notifications and processes them. Returns false
+	// on error or when the stop event is signaled.
+	bool ReadEvents(DWORD timeout);
+#ifdef _WIN32
+	bool IssueRead();
+#else
+	// Watches the directory and its subdirectories. report_files adds the .vcproj files in them
+	// because they could have been written before the watches were added.
+	bool AddWatches(const wstring& relative_dir, bool report_files, DWORD time);
+	void RemoveWatches(const wstring& relative_dir);
+#endif
+	void AddEvent(const wchar_t* relative_path, size_t len, DWORD time);
+	bool IsExcluded(const wchar_t* relative_path, size_t len) const;
+	bool WinError(const wchar_t* fmtstr, ...);
+
+private:
+	const CExcludeFilter& m_ExcludeFilter;
+	wstring m_Dir;
+	wchar_t m_Separator;
+	HANDLE m_StopEvent;
+#ifdef _WIN32
+	SWinHandle m_DirHandle;
+	SWinHandle m_ReadEvent;
+	OVERLAPPED m_Overlapped;
+	bool m_ReadPending;
+#else
+	int m_Inotify;
+	// the watched directories relative to m_Dir by watch descriptor, ending with a separator
+	std::map<int,wstring> m_Watches;
+#endif
+	// DWORD aligned as required by ReadDirectoryChangesW() and struct inotify_event
+	std::vector<DWORD> m_Buffer;
+
+	// changed files and the time of their last event
+	std::map<wstring,DWORD> m_PendingFiles;
+	bool m_Rescan;
+	wstring m_ErrorMessage;
+};
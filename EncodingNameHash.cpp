@@ -0,0 +1,190 @@
+#include "stdafx.h"
+#include "EncodingNameHash.h"
+
+
+// Generated from the names of the UTF-16, UTF-8 and the EncodingList.h encodings, it has to be
+// regenerated with Tools/GenEncodingNameHash.py after editing EncodingList.h.
+
+const unsigned short ENCODING_NAME_SEEDS[ENCODING_NAME_BUCKETS] =
+{
+	203,1,61,111,52,130,21,301,243,18,14,9,4,32,4,9,
+	22,10,306,5,10,248,104,7,202,7,22,112,198,49,1,1,
+	6,7,127,179,295,11,5,17,2,1,2,151,8,10,125,124,
+	23,29,2,26,2,5,1,145,94,27,21,45,7,1,77,1,
+	1,84,1,30,39,7,2,191,1,36,1,16,4,9,0,384,
+	3,34,13,49,98,37,1816,2,27,180,50,46,76,76,81,2,
+	133,5,36,1,65,15,227,228,63,2,24,5,93,27,1,1,
+	1,143,1,256,111,20,448,54,1,37,13,205,26,9,81,2,
+	72,26,66,7,1,64,35,4,1,4,148,475,16,125,47,46,
+	128,7,375,102,51,233,1,8,13,47,33,9,71,51,13,56,
+	1,1,75,0,258,75,7,5,7,9,253,0,10,30,10,103,
+	129,1021,55,13,10,2,20,2758,20,25,179,496,418,19,460,134,
+	180,2,627,4,906,520,4,2,16,2,19,9,436,1,47,319,
+	1,308,346,1,4,20,2,510,609,7,1,198,5,723,114,2,
+	47,2714,12,88,49,459,211,16,74,96,3,299,115,61,1653,6,
+	679,2669,8,482,12,20,21,20,49,388,0,7,0,16,1993,1042,
+	0,17,158,0,4843,50,888,866,584,48,1,74,1,0,41,1,
+	1133,263,400,68,17,11,0,257,7,133,3,5,5,20,866,25,
+	10,136,198,228,9,497,111,16,1,493,273,251,263,909,278,122,
+	2484,91,1,1032,259,78,9974,31,
+};
+
+const SEncodingNameSlot ENCODING_NAME_SLOTS[ENCODING_NAME_COUNT] =
+{
+	{ 293, 14 }, { 122, 0 }, { 12, 1 }, { 136, 0 }, { 72, 2 }, { 217, 1 }, { 110, 1 }, { 103, 5 },
+	{ 73, 2 }, { 98, 4 }, { 53, 1 }, { 130, 1 }, { 290, 3 }, { 183, 1 }, { 2, 3 }, { 184, 0 },
+	{ 101, 1 }, { 174, 0 }, { 73, 4 }, { 166, 0 }, { 23, 3 }, { 44, 6 }, { 6, 1 }, { 40, 3 },
+	{ 106, 0 }, { 125, 3 }, { 34, 0 }, { 38, 0 }, { 144, 0 }, { 290, 5 }, { 94, 0 }, { 183, 0 },
+	{ 290, 11 }, { 213, 2 }, { 144, 4 }, { 269, 0 }, { 126, 2 }, { 83, 4 }, { 289, 0 }, { 114, 5 },
+	{ 188, 1 }, { 218, 0 }, { 159, 1 }, { 227, 2 }, { 294, 1 }, { 292, 2 }, { 297, 0 }, { 82, 11 },
+	{ 115, 0 }, { 42, 6 }, { 191, 1 }, { 190, 1 }, { 107, 1 }, { 256, 0 }, { 12, 8 }, { 293, 2 },
+	{ 284, 0 }, { 205, 1 }, { 8, 4 }, { 92, 4 }, { 82, 14 }, { 290, 8 }, { 311, 2 }, { 295, 0 },
+	{ 116, 2 }, { 73, 1 }, { 146, 2 }, { 62, 2 }, { 214, 5 }, { 165, 2 }, { 129, 2 }, { 281, 0 },
+	{ 61, 1 }, { 57, 5 }, { 2, 10 }, { 84, 0 }, { 42, 2 }, { 293, 6 }, { 42, 4 }, { 142, 3 },
+	{ 186, 3 }, { 175, 2 }, { 164, 4 }, { 77, 0 }, { 290, 0 }, { 176, 2 }, { 89, 0 }, { 65, 1 },
+	{ 276, 7 }, { 4, 0 }, { 289, 5 }, { 7, 4 }, { 9, 4 }, { 98, 1 }, { 98, 3 }, { 234, 0 },
+	{ 119, 0 }, { 23, 0 }, { 145, 6 }, { 132, 0 }, { 201, 5 }, { 103, 3 }, { 166, 1 }, { 221, 1 },
+	{ 23, 5 }, { 257, 0 }, { 121, 1 }, { 16, 2 }, { 112, 3 }, { 45, 5 }, { 148, 2 }, { 66, 0 },
+	{ 26, 6 }, { 291, 11 }, { 227, 0 }, { 70, 0 }, { 106, 1 }, { 251, 1 }, { 228, 0 }, { 143, 1 },
+	{ 12, 3 }, { 16, 4 }, { 201, 1 }, { 57, 0 }, { 82, 12 }, { 25, 0 }, { 298, 7 }, { 279, 2 },
+	{ 79, 1 }, { 297, 2 }, { 27, 2 }, { 306, 0 }, { 144, 2 }, { 181, 1 }, { 176, 1 }, { 32, 1 },
+	{ 309, 7 }, { 97, 2 }, { 310, 0 }, { 312, 2 }, { 75, 3 }, { 80, 2 }, { 39, 6 }, { 192, 0 },
+	{ 95, 5 }, { 297, 5 }, { 38, 1 }, { 52, 5 }, { 133, 1 }, { 66, 4 }, { 10, 0 }, { 41, 3 },
+	{ 18, 0 }, { 76, 1 }, { 72, 1 }, { 296, 10 }, { 101, 6 }, { 240, 1 }, { 40, 0 }, { 8, 5 },
+	{ 103, 7 }, { 161, 1 }, { 298, 2 }, { 185, 2 }, { 165, 1 }, { 235, 1 }, { 225, 0 }, { 68, 0 },
+	{ 22, 3 }, { 140, 3 }, { 124, 0 }, { 34, 2 }, { 96, 6 }, { 286, 3 }, { 296, 5 }, { 203, 1 },
+	{ 309, 0 }, { 9, 1 }, { 186, 2 }, { 112, 0 }, { 111, 1 }, { 314, 0 }, { 296, 7 }, { 294, 9 },
+	{ 57, 1 }, { 204, 1 }, { 173, 1 }, { 40, 5 }, { 30, 2 }, { 103, 4 }, { 213, 1 }, { 52, 3 },
+	{ 190, 0 }, { 72, 0 }, { 57, 4 }, { 56, 7 }, { 43, 3 }, { 300, 0 }, { 45, 7 }, { 40, 1 },
+	{ 131, 4 }, { 117, 0 }, { 176, 4 }, { 10, 3 }, { 293, 12 }, { 43, 1 }, { 48, 0 }, { 307, 5 },
+	{ 233, 0 }, { 216, 0 }, { 96, 5 }, { 127, 2 }, { 307, 0 }, { 208, 1 }, { 51, 1 }, { 130, 4 },
+	{ 224, 1 }, { 66, 2 }, { 71, 9 }, { 291, 0 }, { 3, 3 }, { 50, 3 }, { 200, 2 }, { 55, 1 },
+	{ 135, 0 }, { 3, 1 }, { 201, 2 }, { 86, 2 }, { 58, 1 }, { 211, 0 }, { 295, 9 }, { 83, 9 },
+	{ 201, 7 }, { 26, 0 }, { 151, 1 }, { 138, 0 }, { 84, 1 }, { 219, 1 }, { 216, 1 }, { 298, 9 },
+	{ 41, 6 }, { 315, 1 }, { 228, 2 }, { 12, 7 }, { 100, 0 }, { 182, 1 }, { 264, 0 }, { 92, 2 },
+	{ 70, 1 }, { 65, 0 }, { 185, 3 }, { 293, 4 }, { 148, 6 }, { 208, 0 }, { 105, 3 }, { 117, 4 },
+	{ 26, 1 }, { 298, 12 }, { 260, 0 }, { 278, 2 }, { 89, 3 }, { 202, 0 }, { 206, 2 }, { 154, 1 },
+	{ 115, 2 }, { 9, 0 }, { 107, 0 }, { 122, 4 }, { 35, 0 }, { 189, 0 }, { 74, 3 }, { 204, 0 },
+	{ 27, 3 }, { 145, 1 }, { 103, 8 }, { 135, 1 }, { 12, 10 }, { 171, 1 }, { 129, 1 }, { 293, 11 },
+	{ 48, 6 }, { 136, 1 }, { 144, 5 }, { 292, 3 }, { 205, 0 }, { 27, 4 }, { 126, 4 }, { 113, 3 },
+	{ 130, 0 }, { 114, 1 }, { 194, 0 }, { 297, 4 }, { 162, 0 }, { 149, 3 }, { 6, 5 }, { 51, 0 },
+	{ 185, 0 }, { 120, 0 }, { 322, 0 }, { 293, 1 }, { 155, 1 }, { 293, 8 }, { 194, 1 }, { 205, 6 },
+	{ 82, 9 }, { 197, 1 }, { 53, 4 }, { 228, 1 }, { 300, 1 }, { 296, 2 }, { 197, 0 }, { 179, 0 },
+	{ 296, 0 }, { 107, 4 }, { 289, 6 }, { 113, 5 }, { 252, 1 }, { 67, 2 }, { 58, 0 }, { 96, 1 },
+	{ 56, 6 }, { 199, 1 }, { 284, 1 }, { 45, 0 }, { 85, 1 }, { 11, 1 }, { 298, 6 }, { 140, 1 },
+	{ 214, 3 }, { 55, 4 }, { 286, 4 }, { 175, 1 }, { 81, 2 }, { 97, 0 }, { 235, 0 }, { 172, 2 },
+	{ 12, 9 }, { 298, 0 }, { 192, 1 }, { 54, 2 }, { 298, 10 }, { 59, 0 }, { 83, 7 }, { 240, 2 },
+	{ 65, 3 }, { 56, 4 }, { 107, 3 }, { 82, 3 }, { 313, 0 }, { 109, 0 }, { 50, 1 }, { 152, 1 },
+	{ 14, 2 }, { 35, 1 }, { 308, 0 }, { 83, 3 }, { 291, 5 }, { 263, 0 }, { 169, 2 }, { 141, 0 },
+	{ 276, 3 }, { 170, 1 }, { 311, 0 }, { 112, 2 }, { 295, 8 }, { 182, 2 }, { 125, 2 }, { 51, 3 },
+	{ 211, 1 }, { 153, 1 }, { 100, 2 }, { 28, 0 }, { 290, 6 }, { 150, 2 }, { 53, 5 }, { 147, 6 },
+	{ 140, 4 }, { 2, 12 }, { 128, 0 }, { 146, 1 }, { 293, 9 }, { 143, 6 }, { 262, 0 }, { 244, 1 },
+	{ 295, 6 }, { 98, 7 }, { 42, 5 }, { 129, 0 }, { 248, 1 }, { 295, 4 }, { 67, 4 }, { 118, 2 },
+	{ 101, 4 }, { 304, 0 }, { 83, 6 }, { 32, 2 }, { 149, 0 }, { 62, 3 }, { 93, 0 }, { 221, 3 },
+	{ 293, 5 }, { 11, 0 }, { 5, 2 }, { 149, 4 }, { 279, 5 }, { 114, 2 }, { 42, 3 }, { 50, 0 },
+	{ 2, 14 }, { 49, 5 }, { 71, 4 }, { 55, 6 }, { 212, 1 }, { 289, 1 }, { 75, 1 }, { 143, 5 },
+	{ 7, 3 }, { 22, 6 }, { 27, 0 }, { 82, 13 }, { 142, 0 }, { 52, 2 }, { 144, 1 }, { 227, 1 },
+	{ 146, 4 }, { 226, 0 }, { 188, 2 }, { 178, 2 }, { 229, 0 }, { 111, 2 }, { 246, 1 }, { 176, 5 },
+	{ 221, 2 }, { 12, 5 }, { 181, 2 }, { 295, 5 }, { 317, 1 }, { 118, 1 }, { 11, 5 }, { 287, 0 },
+	{ 41, 2 }, { 312, 0 }, { 74, 5 }, { 49, 1 }, { 218, 1 }, { 66, 1 }, { 99, 2 }, { 157, 0 },
+	{ 30, 0 }, { 9, 2 }, { 309, 9 }, { 119, 1 }, { 294, 2 }, { 226, 2 }, { 271, 0 }, { 295, 1 },
+	{ 68, 1 }, { 142, 7 }, { 143, 3 }, { 209, 0 }, { 205, 3 }, { 245, 1 }, { 291, 10 }, { 289, 7 },
+	{ 115, 1 }, { 44, 2 }, { 113, 1 }, { 290, 9 }, { 71, 1 }, { 33, 1 }, { 92, 1 }, { 97, 1 },
+	{ 164, 3 }, { 7, 2 }, { 143, 0 }, { 73, 3 }, { 22, 2 }, { 40, 2 }, { 201, 3 }, { 108, 5 },
+	{ 82, 2 }, { 105, 1 }, { 60, 5 }, { 50, 4 }, { 164, 1 }, { 29, 1 }, { 19, 0 }, { 110, 2 },
+	{ 289, 4 }, { 243, 0 }, { 294, 6 }, { 303, 0 }, { 282, 0 }, { 143, 7 }, { 280, 0 }, { 321, 1 },
+	{ 8, 0 }, { 278, 6 }, { 285, 0 }, { 86, 1 }, { 94, 1 }, { 207, 0 }, { 71, 14 }, { 142, 1 },
+	{ 147, 3 }, { 56, 1 }, { 179, 2 }, { 309, 8 }, { 319, 0 }, { 145, 0 }, { 200, 0 }, { 206, 0 },
+	{ 82, 0 }, { 56, 0 }, { 91, 0 }, { 127, 0 }, { 97, 3 }, { 213, 3 }, { 170, 0 }, { 259, 0 },
+	{ 82, 1 }, { 195, 1 }, { 292, 0 }, { 290, 4 }, { 276, 4 }, { 134, 1 }, { 228, 3 }, { 2, 0 },
+	{ 147, 1 }, { 102, 0 }, { 273, 2 }, { 278, 1 }, { 141, 3 }, { 113, 0 }, { 10, 2 }, { 26, 2 },
+	{ 168, 0 }, { 199, 0 }, { 234, 2 }, { 27, 5 }, { 167, 3 }, { 130, 2 }, { 60, 3 }, { 178, 0 },
+	{ 224, 0 }, { 55, 5 }, { 71, 11 }, { 145, 3 }, { 215, 1 }, { 214, 0 }, { 152, 0 }, { 289, 8 },
+	{ 117, 3 }, { 307, 3 }, { 74, 1 }, { 39, 4 }, { 173, 2 }, { 83, 2 }, { 105, 7 }, { 307, 1 },
+	{ 141, 2 }, { 105, 0 }, { 320, 0 }, { 186, 0 }, { 83, 0 }, { 47, 1 }, { 13, 0 }, { 193, 1 },
+	{ 129, 3 }, { 23, 2 }, { 71, 17 }, { 62, 5 }, { 2, 11 }, { 162, 1 }, { 2, 6 }, { 72, 4 },
+	{ 78, 0 }, { 276, 0 }, { 41, 0 }, { 131, 2 }, { 100, 1 }, { 69, 1 }, { 279, 1 }, { 87, 3 },
+	{ 238, 0 }, { 201, 4 }, { 147, 2 }, { 156, 1 }, { 110, 0 }, { 143, 4 }, { 103, 1 }, { 109, 1 },
+	{ 149, 2 }, { 295, 3 }, { 39, 3 }, { 316, 2 }, { 33, 0 }, { 245, 0 }, { 92, 3 }, { 82, 4 },
+	{ 87, 2 }, { 114, 3 }, { 5, 4 }, { 169, 0 }, { 16, 0 }, { 123, 1 }, { 48, 1 }, { 2, 15 },
+	{ 2, 2 }, { 201, 8 }, { 272, 0 }, { 29, 0 }, { 2, 4 }, { 4, 3 }, { 15, 5 }, { 54, 0 },
+	{ 215, 0 }, { 142, 5 }, { 4, 4 }, { 288, 0 }, { 140, 5 }, { 14, 3 }, { 171, 0 }, { 297, 3 },
+	{ 89, 4 }, { 123, 0 }, { 25, 2 }, { 248, 0 }, { 292, 7 }, { 10, 4 }, { 66, 5 }, { 307, 4 },
+	{ 78, 1 }, { 316, 0 }, { 186, 1 }, { 71, 18 }, { 142, 2 }, { 6, 4 }, { 71, 13 }, { 80, 1 },
+	{ 276, 2 }, { 74, 6 }, { 122, 2 }, { 149, 6 }, { 28, 1 }, { 184, 2 }, { 67, 0 }, { 111, 0 },
+	{ 101, 2 }, { 184, 1 }, { 45, 4 }, { 249, 0 }, { 120, 1 }, { 149, 1 }, { 296, 3 }, { 319, 1 },
+	{ 62, 0 }, { 289, 3 }, { 221, 0 }, { 279, 4 }, { 163, 1 }, { 221, 5 }, { 294, 4 }, { 290, 10 },
+	{ 200, 5 }, { 22, 4 }, { 212, 0 }, { 250, 1 }, { 196, 0 }, { 62, 4 }, { 71, 16 }, { 61, 0 },
+	{ 100, 4 }, { 130, 3 }, { 71, 8 }, { 163, 0 }, { 103, 6 }, { 291, 6 }, { 166, 2 }, { 85, 0 },
+	{ 183, 3 }, { 114, 0 }, { 221, 4 }, { 25, 3 }, { 277, 0 }, { 46, 2 }, { 295, 2 }, { 49, 7 },
+	{ 82, 5 }, { 105, 2 }, { 80, 0 }, { 118, 0 }, { 168, 1 }, { 250, 0 }, { 43, 5 }, { 25, 4 },
+	{ 129, 4 }, { 236, 0 }, { 198, 1 }, { 71, 12 }, { 210, 1 }, { 53, 2 }, { 47, 5 }, { 286, 1 },
+	{ 316, 1 }, { 140, 0 }, { 125, 1 }, { 100, 5 }, { 163, 2 }, { 267, 0 }, { 148, 1 }, { 268, 0 },
+	{ 72, 3 }, { 121, 0 }, { 146, 5 }, { 299, 0 }, { 157, 1 }, { 307, 2 }, { 12, 6 }, { 34, 1 },
+	{ 81, 1 }, { 161, 0 }, { 232, 0 }, { 40, 4 }, { 195, 0 }, { 39, 1 }, { 2, 1 }, { 181, 0 },
+	{ 145, 2 }, { 240, 4 }, { 41, 1 }, { 71, 2 }, { 223, 0 }, { 180, 1 }, { 305, 0 }, { 1, 2 },
+	{ 116, 0 }, { 0, 1 }, { 164, 0 }, { 27, 6 }, { 292, 6 }, { 296, 1 }, { 289, 2 }, { 200, 4 },
+	{ 49, 0 }, { 95, 1 }, { 95, 0 }, { 86, 0 }, { 3, 4 }, { 146, 6 }, { 294, 3 }, { 108, 0 },
+	{ 203, 0 }, { 22, 1 }, { 273, 1 }, { 66, 3 }, { 39, 2 }, { 31, 0 }, { 116, 1 }, { 77, 4 },
+	{ 95, 6 }, { 141, 6 }, { 205, 5 }, { 239, 0 }, { 235, 3 }, { 237, 0 }, { 49, 2 }, { 47, 2 },
+	{ 235, 2 }, { 32, 0 }, { 285, 1 }, { 251, 0 }, { 41, 4 }, { 12, 0 }, { 124, 1 }, { 219, 0 },
+	{ 226, 1 }, { 114, 4 }, { 47, 4 }, { 242, 1 }, { 81, 0 }, { 131, 3 }, { 293, 7 }, { 36, 1 },
+	{ 128, 1 }, { 193, 0 }, { 309, 5 }, { 126, 3 }, { 19, 2 }, { 1, 1 }, { 289, 10 }, { 202, 1 },
+	{ 118, 3 }, { 35, 2 }, { 292, 8 }, { 15, 4 }, { 6, 3 }, { 71, 5 }, { 150, 3 }, { 156, 0 },
+	{ 164, 5 }, { 242, 3 }, { 170, 3 }, { 7, 5 }, { 45, 2 }, { 26, 4 }, { 67, 5 }, { 149, 5 },
+	{ 82, 10 }, { 201, 6 }, { 48, 5 }, { 276, 6 }, { 138, 1 }, { 20, 2 }, { 96, 0 }, { 77, 2 },
+	{ 309, 6 }, { 165, 0 }, { 117, 2 }, { 7, 1 }, { 228, 5 }, { 101, 0 }, { 5, 5 }, { 254, 0 },
+	{ 100, 3 }, { 3, 0 }, { 97, 5 }, { 147, 4 }, { 242, 2 }, { 56, 3 }, { 87, 4 }, { 43, 0 },
+	{ 21, 0 }, { 90, 1 }, { 15, 0 }, { 90, 0 }, { 139, 1 }, { 1, 0 }, { 252, 0 }, { 113, 2 },
+	{ 296, 9 }, { 69, 2 }, { 309, 1 }, { 75, 4 }, { 5, 3 }, { 53, 0 }, { 95, 3 }, { 104, 1 },
+	{ 96, 2 }, { 99, 4 }, { 173, 0 }, { 214, 2 }, { 289, 11 }, { 206, 1 }, { 137, 0 }, { 278, 5 },
+	{ 289, 9 }, { 87, 1 }, { 296, 8 }, { 45, 1 }, { 55, 0 }, { 103, 2 }, { 14, 1 }, { 222, 1 },
+	{ 31, 4 }, { 291, 4 }, { 292, 5 }, { 200, 3 }, { 320, 1 }, { 150, 0 }, { 75, 0 }, { 160, 0 },
+	{ 87, 0 }, { 112, 1 }, { 37, 1 }, { 39, 0 }, { 56, 5 }, { 64, 0 }, { 148, 0 }, { 71, 0 },
+	{ 63, 1 }, { 45, 6 }, { 164, 2 }, { 59, 2 }, { 3, 5 }, { 274, 0 }, { 183, 4 }, { 69, 0 },
+	{ 109, 2 }, { 43, 2 }, { 3, 2 }, { 23, 4 }, { 293, 13 }, { 189, 2 }, { 290, 1 }, { 294, 10 },
+	{ 309, 4 }, { 99, 0 }, { 134, 0 }, { 12, 2 }, { 210, 0 }, { 283, 0 }, { 177, 1 }, { 198, 0 },
+	{ 153, 0 }, { 145, 4 }, { 200, 7 }, { 63, 0 }, { 228, 4 }, { 23, 6 }, { 131, 0 }, { 74, 0 },
+	{ 107, 5 }, { 220, 1 }, { 291, 2 }, { 292, 10 }, { 177, 2 }, { 196, 1 }, { 31, 3 }, { 318, 1 },
+	{ 309, 3 }, { 104, 0 }, { 191, 0 }, { 142, 6 }, { 240, 0 }, { 278, 4 }, { 253, 0 }, { 101, 5 },
+	{ 48, 3 }, { 44, 1 }, { 312, 1 }, { 234, 1 }, { 187, 0 }, { 290, 7 }, { 154, 0 }, { 67, 1 },
+	{ 182, 0 }, { 10, 5 }, { 172, 1 }, { 261, 0 }, { 77, 3 }, { 88, 0 }, { 139, 0 }, { 9, 5 },
+	{ 2, 7 }, { 30, 1 }, { 31, 2 }, { 79, 0 }, { 22, 0 }, { 8, 2 }, { 143, 2 }, { 105, 4 },
+	{ 206, 3 }, { 247, 0 }, { 295, 7 }, { 77, 1 }, { 258, 0 }, { 172, 3 }, { 293, 10 }, { 214, 1 },
+	{ 148, 3 }, { 125, 0 }, { 22, 5 }, { 75, 2 }, { 290, 2 }, { 36, 2 }, { 55, 3 }, { 20, 0 },
+	{ 279, 0 }, { 176, 3 }, { 145, 5 }, { 247, 1 }, { 47, 0 }, { 140, 6 }, { 17, 2 }, { 185, 1 },
+	{ 298, 8 }, { 169, 1 }, { 105, 5 }, { 71, 3 }, { 294, 7 }, { 189, 1 }, { 183, 2 }, { 148, 4 },
+	{ 76, 0 }, { 14, 0 }, { 317, 0 }, { 6, 2 }, { 128, 2 }, { 59, 1 }, { 146, 0 }, { 273, 0 },
+	{ 96, 3 }, { 18, 1 }, { 187, 1 }, { 291, 9 }, { 116, 3 }, { 15, 3 }, { 107, 2 }, { 99, 5 },
+	{ 98, 5 }, { 44, 0 }, { 82, 7 }, { 50, 2 }, { 298, 1 }, { 167, 1 }, { 2, 9 }, { 49, 3 },
+	{ 170, 2 }, { 2, 13 }, { 71, 10 }, { 83, 1 }, { 141, 5 }, { 312, 3 }, { 279, 6 }, { 48, 4 },
+	{ 108, 3 }, { 11, 2 }, { 57, 3 }, { 230, 0 }, { 91, 1 }, { 276, 5 }, { 266, 0 }, { 244, 0 },
+	{ 17, 0 }, { 0, 0 }, { 241, 0 }, { 155, 0 }, { 82, 8 }, { 11, 3 }, { 126, 1 }, { 242, 0 },
+	{ 188, 0 }, { 227, 3 }, { 25, 1 }, { 60, 0 }, { 151, 0 }, { 62, 1 }, { 74, 4 }, { 113, 4 },
+	{ 42, 7 }, { 53, 3 }, { 228, 6 }, { 54, 1 }, { 205, 2 }, { 160, 1 }, { 292, 9 }, { 246, 0 },
+	{ 44, 4 }, { 291, 3 }, { 131, 1 }, { 117, 1 }, { 298, 5 }, { 200, 6 }, { 141, 1 }, { 291, 1 },
+	{ 11, 4 }, { 286, 0 }, { 118, 4 }, { 275, 0 }, { 44, 3 }, { 298, 3 }, { 97, 4 }, { 20, 1 },
+	{ 122, 3 }, { 48, 2 }, { 206, 4 }, { 88, 1 }, { 217, 0 }, { 159, 0 }, { 302, 0 }, { 108, 2 },
+	{ 49, 6 }, { 172, 0 }, { 214, 4 }, { 23, 1 }, { 59, 4 }, { 270, 0 }, { 291, 8 }, { 46, 0 },
+	{ 234, 3 }, { 52, 1 }, { 101, 3 }, { 167, 2 }, { 49, 4 }, { 51, 2 }, { 57, 6 }, { 126, 0 },
+	{ 205, 7 }, { 116, 4 }, { 15, 1 }, { 315, 0 }, { 71, 7 }, { 148, 5 }, { 146, 3 }, { 60, 4 },
+	{ 67, 3 }, { 207, 1 }, { 294, 8 }, { 98, 0 }, { 177, 0 }, { 318, 0 }, { 64, 1 }, { 41, 5 },
+	{ 84, 2 }, { 96, 4 }, { 33, 2 }, { 144, 3 }, { 294, 5 }, { 9, 3 }, { 292, 4 }, { 99, 3 },
+	{ 89, 2 }, { 286, 2 }, { 99, 1 }, { 297, 1 }, { 45, 3 }, { 55, 2 }, { 10, 1 }, { 108, 4 },
+	{ 65, 2 }, { 142, 4 }, { 24, 0 }, { 51, 4 }, { 117, 5 }, { 201, 0 }, { 8, 3 }, { 141, 4 },
+	{ 178, 1 }, { 4, 2 }, { 74, 2 }, { 296, 11 }, { 278, 0 }, { 52, 4 }, { 321, 0 }, { 108, 1 },
+	{ 89, 1 }, { 276, 1 }, { 127, 1 }, { 292, 1 }, { 6, 0 }, { 60, 1 }, { 27, 1 }, { 175, 0 },
+	{ 222, 0 }, { 50, 5 }, { 21, 1 }, { 42, 1 }, { 311, 1 }, { 180, 0 }, { 101, 7 }, { 26, 5 },
+	{ 37, 0 }, { 53, 6 }, { 167, 0 }, { 73, 0 }, { 176, 0 }, { 98, 2 }, { 12, 4 }, { 231, 0 },
+	{ 293, 3 }, { 13, 1 }, { 93, 1 }, { 144, 6 }, { 31, 1 }, { 181, 3 }, { 158, 0 }, { 179, 1 },
+	{ 298, 11 }, { 102, 1 }, { 291, 7 }, { 140, 2 }, { 254, 1 }, { 125, 4 }, { 42, 0 }, { 105, 6 },
+	{ 92, 0 }, { 5, 0 }, { 17, 1 }, { 16, 3 }, { 278, 3 }, { 301, 0 }, { 209, 1 }, { 200, 1 },
+	{ 59, 3 }, { 249, 1 }, { 47, 3 }, { 71, 6 }, { 56, 2 }, { 225, 1 }, { 36, 0 }, { 213, 0 },
+	{ 44, 5 }, { 309, 2 }, { 2, 5 }, { 205, 4 }, { 137, 1 }, { 43, 4 }, { 4, 1 }, { 279, 3 },
+	{ 60, 2 }, { 16, 5 }, { 48, 7 }, { 98, 6 }, { 39, 5 }, { 223, 1 }, { 9, 6 }, { 132, 1 },
+	{ 52, 0 }, { 5, 1 }, { 57, 2 }, { 298, 4 }, { 133, 0 }, { 8, 1 }, { 82, 6 }, { 46, 1 },
+	{ 71, 15 }, { 147, 5 }, { 4, 5 }, { 17, 3 }, { 296, 4 }, { 220, 0 }, { 147, 0 }, { 83, 5 },
+	{ 103, 0 }, { 294, 0 }, { 26, 3 }, { 255, 0 }, { 19, 1 }, { 265, 0 }, { 2, 8 }, { 296, 6 },
+	{ 83, 8 }, { 122, 1 }, { 95, 2 }, { 95, 4 }, { 125, 5 }, { 16, 1 }, { 150, 1 }, { 314, 1 },
+	{ 158, 1 }, { 293, 0 }, { 7, 0 }, { 92, 5 }, { 240, 3 }, { 235, 4 }, { 15, 2 },
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+
+// The minimal perfect hash of the encoding names, generated from the names of the UTF-16, UTF-8
+// and the EncodingList.h encodings with Tools/GenEncodingNameHash.py. The name is in slot
+// HashEncodingName(ENCODING_NAME_SEEDS[HashEncodingName(0, name) % ENCODING_NAME_BUCKETS], name)
+// % ENCODING_NAME_COUNT if it is a known name.
+
+static const int ENCODING_COUNT = 323;
+static const int ENCODING_NAME_COUNT = 1247;
+static const int ENCODING_NAME_BUCKETS = 312;
+
+struct SEncodingNameSlot
+{
+	unsigned short encoding;
+	unsigned short name;
+};
+
+extern const unsigned short ENCODING_NAME_SEEDS[ENCODING_NAME_BUCKETS];
+extern const SEncodingNameSlot ENCODING_NAME_SLOTS[ENCODING_NAME_COUNT];
+
+// FNV-1a hash of the name with its ASCII letters lowercased.
+inline unsigned HashEncodingName(unsigned seed, const wchar_t* name)
+{
+	unsigned h = 2166136261u ^ seed;
+	for (; *name; ++name)
+	{
+		unsigned c = (unsigned)*name;
+		if (c>='A' && c<='Z')
+			c += 'a' - 'A';
+		h = (h ^ c) * 16777619u;
+	}
+	return h;
+}
@@ -0,0 +1,363 @@
+#include "stdafx.h"
+#include "FileCommit.h"
+#include "Manifest.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#endif
+
+
+// A bigger batch means fewer directory flushes but more temp files left behind by a crash.
+static const size_t COMMIT_BATCH_SIZE = 64;
+// A batch whose temp files are written by the queue is committed early if its data is bigger.
+static const size_t MAX_BATCH_DATA_SIZE = 0x4000000;
+// The length of a single write is 32 bit.
+static const size_t MAX_WRITE_CHUNK_SIZE = 0x40000000;
+
+// The directory handle is used to rename the files on POSIX and to commit the renames to the
+// disk. Not every file system supports flushing a directory handle (FAT and some network
+// redirectors don't) so the flush is only best effort.
+static HANDLE OpenDirectory(const wstring& dir)
+{
+	return CreateFile(dir.empty() ? L"." : dir.c_str(), GENERIC_WRITE, FILE_SHARE_READ|FILE_SHARE_WRITE|FILE_SHARE_DELETE,
+		NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL);
+}
+
+// The paths are in the directory of the handle, dir_length is the length of its path. On POSIX
+// the names are renamed with renameat() relative to the directory so the kernel doesn't look up
+// the directory path again for every file.
+static BOOL RenameInDirectory(HANDLE dir_handle, size_t dir_length, const wstring& temp_path, const wstring& filepath)
+{
+	assert(temp_path.compare(0, dir_length, filepath, 0, dir_length) == 0);
+#ifndef _WIN32
+	int dir_fd = GetFileDescriptor(dir_handle);
+	if (dir_fd >= 0)
+	{
+		return !renameat(dir_fd, ToNativePath(temp_path.c_str()+dir_length).c_str(),
+			dir_fd, ToNativePath(filepath.c_str()+dir_length).c_str());
+	}
+#endif
+	return MoveFileEx(temp_path.c_str(), filepath.c_str(), MOVEFILE_REPLACE_EXISTING);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+
+CFileCommitQueue::CFileCommitQueue(CFormatManifest* manifest)
+: m_Manifest(manifest)
+, m_BatchDataSize(0)
+, m_ErrorCount(0)
+{
+	m_Batch.reserve(COMMIT_BATCH_SIZE);
+}
+
+CFileCommitQueue::~CFileCommitQueue()
+{
+	Finish();
+}
+
+bool CFileCommitQueue::EnableBatchedWrites()
+{
+#ifdef _WIN32
+	return false;
+#else
+	SAutoLock lock(m_RingLock);
+	// a phase of a batch has an operation per file at most
+	return m_Ring.IsInitialized() || m_Ring.Init(COMMIT_BATCH_SIZE);
+#endif
+}
+
+bool CFileCommitQueue::HasBatchedWrites() const
+{
+#ifdef _WIN32
+	return false;
+#else
+	return m_Ring.IsInitialized();
+#endif
+}
+
+void CFileCommitQueue::AddFile(const wstring& filepath, const wstring& temp_path, ULONGLONG hash)
+{
+	SFile file;
+	file.filepath = filepath;
+	file.temp_path = temp_path;
+	file.hash = hash;
+	AddToBatch(file);
+}
+
+void CFileCommitQueue::AddFileData(const wstring& filepath, const wstring& temp_path, std::vector<char>& data, ULONGLONG hash)
+{
+	assert(HasBatchedWrites());
+	SFile file;
+	file.filepath = filepath;
+	file.temp_path = temp_path;
+	file.hash = hash;
+	file.write_temp_file = true;
+	file.data.swap(data);
+	AddToBatch(file);
+}
+
+void CFileCommitQueue::AddToBatch(SFile& file)
+{
+	TFileVec full_batch;
+	{
+		SAutoLock lock(m_Lock);
+		m_BatchDataSize += file.data.size();
+		m_Batch.push_back(SFile());
+		m_Batch.back().Swap(file);
+		if (m_Batch.size()<COMMIT_BATCH_SIZE && m_BatchDataSize<MAX_BATCH_DATA_SIZE)
+			return;
+		full_batch.swap(m_Batch);
+		m_Batch.reserve(COMMIT_BATCH_SIZE);
+		m_BatchDataSize = 0;
+	}
+	// the other threads can fill the next batch in the meantime
+	Commit(full_batch);
+}
+
+int CFileCommitQueue::Finish()
+{
+	TFileVec batch;
+	{
+		SAutoLock lock(m_Lock);
+		batch.swap(m_Batch);
+		m_BatchDataSize = 0;
+	}
+	Commit(batch);
+	return (int)m_ErrorCount;
+}
+
+void CFileCommitQueue::Commit(const TFileVec& files)
+{
+	assert(files.size() <= COMMIT_BATCH_SIZE);
+	// each directory of the batch is opened once for its renames and its flush
+	std::vector<wstring> dirs;
+	SWinHandle dir_handles[COMMIT_BATCH_SIZE];
+	std::vector<size_t> file_dirs;
+	for (TFileVec::const_iterator it=files.begin(),eit=files.end(); it!=eit; ++it)
+	{
+		wstring dir = DirName(it->filepath.c_str());
+		size_t index = std::find(dirs.begin(), dirs.end(), dir) - dirs.begin();
+		if (index == dirs.size())
+		{
+			dirs.push_back(dir);
+			dir_handles[index] = OpenDirectory(dir);
+		}
+		file_dirs.push_back(index);
+	}
+	std::vector<bool> dirs_changed(dirs.size(), false);
+
+#ifndef _WIN32
+	if (HasBatchedWrites())
+	{
+		SAutoLock lock(m_RingLock);
+		CommitOnRing(files, dirs, dir_handles, file_dirs, dirs_changed);
+		return;
+	}
+#endif
+
+	for (size_t i=0; i<files.size(); ++i)
+	{
+		size_t index = file_dirs[i];
+		if (!CommitFile(files[i], dir_handles[index], dirs[index].size()))
+		{
+			InterlockedIncrement(&m_ErrorCount);
+			continue;
+		}
+		dirs_changed[index] = true;
+	}
+	for (size_t i=0; i<dirs.size(); ++i)
+	{
+		if (dirs_changed[i] && dir_handles[i]!=INVALID_HANDLE_VALUE)
+			FlushFileBuffers(dir_handles[i]);
+	}
+}
+
+bool CFileCommitQueue::CommitFile(const SFile& file, HANDLE dir_handle, size_t dir_length)
+{
+	assert(!file.write_temp_file);
+	BOOL renamed = RenameInDirectory(dir_handle, dir_length, file.temp_path, file.filepath);
+	return FinishFile(file, renamed, renamed ? 0 : GetLastError());
+}
+
+bool CFileCommitQueue::FinishFile(const SFile& file, BOOL renamed, DWORD last_error)
+{
+	const wchar_t* filepath = file.filepath.c_str();
+	if (!renamed)
+	{
+		DeleteFile(file.temp_path.c_str());
+		Log(L"Formatting %s... Error moving \"%s\" to \"%s\"! %s", filepath, file.temp_path.c_str(), filepath, LastErrorToString(last_error).c_str());
+		return false;
+	}
+
+	if (m_Manifest)
+	{
+		WIN32_FILE_ATTRIBUTE_DATA file_data;
+		if (!GetFileAttributesEx(filepath, GetFileExInfoStandard, &file_data))
+		{
+			Log(L"Formatting %s... Error updating the manifest! %s", filepath, LastErrorToString(GetLastError()).c_str());
+			return false;
+		}
+		m_Manifest->SetEntry(filepath, SFileStat(file_data), file.hash);
+	}
+
+	Log(L"Formatting %s... OK", filepath);
+	return true;
+}
+
+#ifndef _WIN32
+
+void CFileCommitQueue::CommitOnRing(const TFileVec& files, const std::vector<wstring>& dirs, const SWinHandle* dir_handles,
+									const std::vector<size_t>& file_dirs, std::vector<bool>& dirs_changed)
+{
+	size_t count = files.size();
+	// the paths relative to the directory handle, or the whole paths if it couldn't be opened
+	std::vector<int> dir_fds(count);
+	std::vector<std::string> temp_names(count), names(count);
+	for (size_t i=0; i<count; ++i)
+	{
+		int dir_fd = GetFileDescriptor(dir_handles[file_dirs[i]]);
+		size_t dir_length = dir_fd>=0 ? dirs[file_dirs[i]].size() : 0;
+		dir_fds[i] = dir_fd>=0 ? dir_fd : AT_FDCWD;
+		temp_names[i] = ToNativePath(files[i].temp_path.c_str()+dir_length);
+		names[i] = ToNativePath(files[i].filepath.c_str()+dir_length);
+	}
+
+	// the temp files are written like CVcprojFile::SaveVcprojFile() does it, the message
+	// of the failed step is set for the files that couldn't be written
+	std::vector<const wchar_t*> write_errors(count, (const wchar_t*)NULL);
+	std::vector<int> last_errors(count, 0);
+	std::vector<int> fds(count, -1);
+	std::vector<int> results(count);
+	for (size_t i=0; i<count; ++i)
+	{
+		if (files[i].write_temp_file)
+			m_Ring.QueueOpenAt(dir_fds[i], temp_names[i].c_str(), O_WRONLY|O_CREAT|O_TRUNC|O_CLOEXEC, 0666, i+1);
+	}
+	RunRing(results);
+	for (size_t i=0; i<count; ++i)
+	{
+		if (!files[i].write_temp_file)
+			continue;
+		if (results[i] >= 0)
+		{
+			fds[i] = results[i];
+		}
+		else
+		{
+			write_errors[i] = L"Error opening file for writing!";
+			last_errors[i] = -results[i];
+		}
+	}
+
+	// the short writes are continued in the next round
+	std::vector<size_t> written(count, 0);
+	for (;;)
+	{
+		bool queued = false;
+		for (size_t i=0; i<count; ++i)
+		{
+			const std::vector<char>& data = files[i].data;
+			if (fds[i]<0 || write_errors[i] || written[i]==data.size())
+				continue;
+			unsigned size = (unsigned)min(data.size()-written[i], (size_t)MAX_WRITE_CHUNK_SIZE);
+			m_Ring.QueueWrite(fds[i], &data[written[i]], size, written[i], i+1);
+			queued = true;
+		}
+		if (!queued)
+			break;
+		RunRing(results);
+		for (size_t i=0; i<count; ++i)
+		{
+			if (fds[i]<0 || write_errors[i] || written[i]==files[i].data.size())
+				continue;
+			if (results[i] > 0)
+			{
+				written[i] += (size_t)results[i];
+			}
+			else
+			{
+				write_errors[i] = L"Error writing file!";
+				last_errors[i] = results[i] ? -results[i] : EIO;
+			}
+		}
+	}
+
+	// the data must be on the disk before the file is renamed over the original
+	for (size_t i=0; i<count; ++i)
+	{
+		if (fds[i]>=0 && !write_errors[i])
+			m_Ring.QueueFsync(fds[i], i+1);
+	}
+	RunRing(results);
+	for (size_t i=0; i<count; ++i)
+	{
+		if (fds[i]>=0 && !write_errors[i] && results[i]<0)
+		{
+			write_errors[i] = L"Error flushing file!";
+			last_errors[i] = -results[i];
+		}
+	}
+	for (size_t i=0; i<count; ++i)
+	{
+		if (fds[i] >= 0)
+			m_Ring.QueueClose(fds[i], 0);
+	}
+	RunRing(results);
+
+	for (size_t i=0; i<count; ++i)
+	{
+		if (write_errors[i])
+		{
+			const wchar_t* filepath = files[i].filepath.c_str();
+			DeleteFile(files[i].temp_path.c_str());
+			Log(L"Formatting %s... Error saving temp file: %s %s [LastError: %d] %s", filepath, files[i].temp_path.c_str(),
+				write_errors[i], last_errors[i], LastErrorToString(last_errors[i]).c_str());
+			InterlockedIncrement(&m_ErrorCount);
+		}
+		else
+		{
+			m_Ring.QueueRenameAt(dir_fds[i], temp_names[i].c_str(), dir_fds[i], names[i].c_str(), i+1);
+		}
+	}
+	RunRing(results);
+	for (size_t i=0; i<count; ++i)
+	{
+		if (write_errors[i])
+			continue;
+		if (!FinishFile(files[i], results[i]>=0, results[i]>=0 ? 0 : -results[i]))
+		{
+			InterlockedIncrement(&m_ErrorCount);
+			continue;
+		}
+		dirs_changed[file_dirs[i]] = true;
+	}
+
+	for (size_t i=0; i<dirs.size(); ++i)
+	{
+		int dir_fd = GetFileDescriptor(dir_handles[i]);
+		if (dirs_changed[i] && dir_fd>=0)
+			m_Ring.QueueFsync(dir_fd, 0);
+	}
+	RunRing(results);
+}
+
+void CFileCommitQueue::RunRing(std::vector<int>& results)
+{
+	if (!m_Ring.GetPendingCount())
+		return;
+	// the operations that don't complete fail with the error of the submission
+	int submit_error = m_Ring.Submit(m_Ring.GetPendingCount()) ? 0 : errno;
+	std::fill(results.begin(), results.end(), -(submit_error ? submit_error : EIO));
+	ULONGLONG user_data;
+	int result;
+	while (m_Ring.TakeCompletion(user_data, result))
+	{
+		if (user_data)
+			results[(size_t)user_data-1] = result;
+	}
+}
+
+#endif
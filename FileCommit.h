@@ -0,0 +1,88 @@
+#pragma once
+
+#ifndef _WIN32
+#include "IoUring.h"
+#endif
+
+
+class CFormatManifest;
+
+
+// Replaces the original files with their formatted temp files in batches. Each temp file is
+// renamed over its original with a single atomic MoveFileEx() call (renameat() relative to the
+// directory on POSIX) so a crash leaves either the old or the new file in place, then the
+// directories of the batch are flushed once.
+// After EnableBatchedWrites() (-IO:BATCHED on Linux) the workers can pass the formatted data
+// instead of a temp file. The temp files of a batch are then created, written, flushed and
+// closed, and the batch is renamed and its directories flushed on an io_uring ring, with one
+// submission for each of these steps instead of a system call for each file.
+class CFileCommitQueue
+{
+public:
+	// The manifest is NULL if there is no -MANIFEST option.
+	explicit CFileCommitQueue(CFormatManifest* manifest);
+	~CFileCommitQueue();
+
+	// Returns false if io_uring isn't available, the workers write the temp files then.
+	bool EnableBatchedWrites();
+	bool HasBatchedWrites() const;
+	// Called by the worker threads after the temp file has been written and flushed.
+	// hash is the hash of the temp file data for the manifest.
+	void AddFile(const wstring& filepath, const wstring& temp_path, ULONGLONG hash);
+	// Called by the worker threads if HasBatchedWrites(), the temp file is written by the commit
+	// queue. The data is swapped out.
+	void AddFileData(const wstring& filepath, const wstring& temp_path, std::vector<char>& data, ULONGLONG hash);
+	// Commits the remaining files. Returns the number of files that couldn't be replaced.
+	int Finish();
+
+private:
+	struct SFile
+	{
+		wstring filepath;
+		wstring temp_path;
+		ULONGLONG hash;
+		// the data of the temp file if it hasn't been written by the worker
+		bool write_temp_file;
+		std::vector<char> data;
+
+		SFile() : hash(0), write_temp_file(false) {}
+		void Swap(SFile& other)
+		{
+			filepath.swap(other.filepath);
+			temp_path.swap(other.temp_path);
+			std::swap(hash, other.hash);
+			std::swap(write_temp_file, other.write_temp_file);
+			data.swap(other.data);
+		}
+	};
+	typedef std::vector<SFile> TFileVec;
+
+	// Swaps the file into the batch and commits the batch if it is full.
+	void AddToBatch(SFile& file);
+	void Commit(const TFileVec& files);
+	// dir_handle is the directory of the file, dir_length is the length of its path.
+	bool CommitFile(const SFile& file, HANDLE dir_handle, size_t dir_length);
+	// Logs the result of the rename and updates the manifest.
+	bool FinishFile(const SFile& file, BOOL renamed, DWORD last_error);
+#ifndef _WIN32
+	// Writes the temp files and renames the files of the batch on the ring.
+	void CommitOnRing(const TFileVec& files, const std::vector<wstring>& dirs, const SWinHandle* dir_handles,
+					  const std::vector<size_t>& file_dirs, std::vector<bool>& dirs_changed);
+	// Submits the queued operations and waits for them. The result of an operation is stored at
+	// the index of its user data minus one, the operations with zero user data are ignored.
+	void RunRing(std::vector<int>& results);
+#endif
+
+private:
+	CFormatManifest* m_Manifest;
+	CCriticalSection m_Lock;
+	TFileVec m_Batch;
+	// the size of the data in m_Batch
+	size_t m_BatchDataSize;
+	volatile LONG m_ErrorCount;
+#ifndef _WIN32
+	// the batches are committed on the ring one at a time
+	CCriticalSection m_RingLock;
+	CIoUring m_Ring;
+#endif
+};
@@ -0,0 +1,133 @@
+#include "stdafx.h"
+#include "FileList.h"
+#include "XmlEncoding.h"
+
+
+static const size_t READ_CHUNK_SIZE = 0x10000;
+static const char UTF8_BOM[] = "\xEF\xBB\xBF";
+
+
+CFileListReader::CFileListReader()
+: m_Input(NULL)
+, m_Pos(0)
+, m_End(0)
+, m_FirstChunk(true)
+{
+}
+
+bool CFileListReader::Open(const wchar_t* filepath)
+{
+	m_ErrorMessage.clear();
+	m_FilePath = filepath;
+	if (0 == wcscmp(filepath, L"-"))
+	{
+		m_FilePath = L"<stdin>";
+		m_Input = GetStdHandle(STD_INPUT_HANDLE);
+		if (m_Input==NULL || m_Input==INVALID_HANDLE_VALUE)
+			return Error(L"stdin isn't available!");
+	}
+	else
+	{
+		m_File = CreateFile(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (m_File == INVALID_HANDLE_VALUE)
+			return Error(L"Error opening file list %s! %s", filepath, LastErrorToString(GetLastError()).c_str());
+		m_Input = m_File;
+	}
+	m_Buffer.resize(READ_CHUNK_SIZE);
+	m_Pos = m_End = 0;
+	m_FirstChunk = true;
+	return true;
+}
+
+bool CFileListReader::FillBuffer()
+{
+	// keeping the unfinished path at the beginning of the buffer
+	if (m_Pos)
+	{
+		memmove(&m_Buffer[0], &m_Buffer[m_Pos], m_End-m_Pos);
+		m_End -= m_Pos;
+		m_Pos = 0;
+	}
+	if (m_Buffer.size()-m_End < READ_CHUNK_SIZE)
+		m_Buffer.resize(m_End + READ_CHUNK_SIZE);
+
+	// ReadFile() returns as soon as some data is available in the pipe
+	DWORD read;
+	if (!ReadFile(m_Input, &m_Buffer[m_End], (DWORD)READ_CHUNK_SIZE, &read, NULL))
+	{
+		// the writer closed the pipe
+		if (GetLastError() != ERROR_BROKEN_PIPE)
+			return Error(L"Error reading file list %s! %s", m_FilePath.c_str(), LastErrorToString(GetLastError()).c_str());
+		read = 0;
+	}
+	m_End += read;
+	if (m_FirstChunk && m_End>=3)
+	{
+		m_FirstChunk = false;
+		if (0 == memcmp(&m_Buffer[0], UTF8_BOM, 3))
+			m_Pos = 3;
+	}
+	return read != 0;
+}
+
+bool CFileListReader::ReadPath(wstring& path)
+{
+	IEncoding* encoding = CEncodings::GetInstance().FindEncoding(L"UTF-8");
+	assert(encoding);
+	path.clear();
+	size_t scan_pos = m_Pos;
+	while (1)
+	{
+		size_t sep = scan_pos;
+		while (sep<m_End && m_Buffer[sep]!='\n' && m_Buffer[sep]!='\r' && m_Buffer[sep]!=0)
+			++sep;
+
+		bool end_of_input = false;
+		if (sep == m_End)
+		{
+			size_t scanned = sep - m_Pos;
+			if (!m_Input)
+				end_of_input = true;
+			else if (!FillBuffer())
+			{
+				if (!m_ErrorMessage.empty())
+					return false;
+				// the last path may be unterminated
+				m_Input = NULL;
+				m_File.Close();
+				end_of_input = true;
+			}
+			if (!end_of_input)
+			{
+				scan_pos = m_Pos + scanned;
+				continue;
+			}
+			sep = m_End;
+		}
+
+		size_t begin = m_Pos;
+		m_Pos = sep<m_End ? sep+1 : sep;
+		// empty lines and the \n of \r\n are skipped
+		if (sep > begin)
+		{
+			wstring error_message;
+			if (!DecodeToUTF16(encoding, &m_Buffer[begin], sep-begin, path, &error_message))
+				return Error(L"Error decoding file list %s! %s", m_FilePath.c_str(), error_message.c_str());
+			return true;
+		}
+		if (end_of_input)
+			return false;
+		scan_pos = m_Pos;
+	}
+}
+
+bool CFileListReader::Error(const wchar_t* fmtstr, ...)
+{
+	wchar_t buf[0x400];
+	va_list args;
+	va_start(args, fmtstr);
+	vswprintf(buf, sizeof(buf)/sizeof(buf[0]), fmtstr, args);
+	va_end(args);
+	m_ErrorMessage = buf;
+	return false;
+}
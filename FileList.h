@@ -0,0 +1,36 @@
+#pragma once
+
+
+// Reads a list of UTF-8 paths separated by newlines or NUL characters from a file or from stdin.
+// The paths are returned as soon as they arrive so the files can be processed while the producer
+// (eg.: git ls-files, find) is still writing the list.
+class CFileListReader
+{
+public:
+	CFileListReader();
+
+	// "-" reads the list from stdin.
+	bool Open(const wchar_t* filepath);
+	// Returns false at the end of the list with an empty error message and on error.
+	bool ReadPath(wstring& path);
+	const wstring& GetErrorMessage() const				{ return m_ErrorMessage; }
+	const wstring& GetFilePath() const					{ return m_FilePath; }
+
+private:
+	// Returns false at the end of the input with an empty error message and on error.
+	bool FillBuffer();
+	bool Error(const wchar_t* fmtstr, ...);
+
+private:
+	wstring m_FilePath;
+	// NULL when reading stdin, stdin isn't closed
+	SWinHandle m_File;
+	HANDLE m_Input;
+
+	std::vector<char> m_Buffer;
+	size_t m_Pos;
+	size_t m_End;
+	bool m_FirstChunk;
+
+	wstring m_ErrorMessage;
+};
@@ -0,0 +1,477 @@
+#include "stdafx.h"
+#include "FileReader.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
+
+
+// The number of files that are opened and read at the same time.
+static const LONG MAX_READS_IN_FLIGHT = 64;
+// Bigger files are mapped by the workers instead of being read into memory here.
+static const ULONGLONG MAX_PRELOAD_SIZE = 0x4000000;
+// No more files are read while the results that the workers haven't taken yet and the reads in
+// flight use more memory than this.
+static const ULONGLONG MAX_RESERVED_MEMORY = 0x8000000;
+// The memory charged for a result besides its data, this limits the number of results too.
+static const ULONGLONG RESULT_MEMORY = 0x400;
+
+#ifdef _WIN32
+// The number of threads that open and stat the files at the same time.
+static const int OPENER_THREAD_COUNT = 8;
+
+static const ULONG_PTR KEY_READ = 1;
+static const ULONG_PTR KEY_FINISH = 2;
+#else
+// Every file has at most one operation in flight besides the closes of the finished files.
+static const unsigned RING_ENTRIES = 4*MAX_READS_IN_FLIGHT;
+#endif
+
+
+struct CBatchedFileReader::SRead
+{
+#ifdef _WIN32
+	OVERLAPPED overlapped;
+	SWinHandle file;
+#else
+	enum EState
+	{
+		eS_Open,
+		eS_Stat,
+		eS_Read,
+	};
+	EState state;
+	std::string native_path;
+	int fd;
+	bool needs_data;
+	// the memory reserved for the result
+	ULONGLONG memory;
+	size_t bytes_read;
+#ifdef __linux__
+	struct statx stx;
+#endif
+#endif
+	wstring filepath;
+	SPreloadedFile result;
+
+	SRead(const wstring& _filepath) : filepath(_filepath)
+	{
+#ifdef _WIN32
+		memset(&overlapped, 0, sizeof(overlapped));
+#else
+		state = eS_Open;
+		native_path = ToNativePath(filepath.c_str());
+		fd = -1;
+		needs_data = false;
+		memory = 0;
+		bytes_read = 0;
+#endif
+	}
+};
+
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+
+CBatchedFileReader::CBatchedFileReader(IPreloadFilter* filter, IFileJobSink* next)
+: m_Filter(filter)
+, m_Next(next)
+, m_ReadsInFlight(0)
+#ifdef _WIN32
+, m_CompletionThread(NULL)
+#endif
+, m_ReservedMemory(0)
+, m_MemoryWaiters(0)
+, m_MemoryReleased(CreateSemaphore(NULL, 0, 0x7FFFFFFF, NULL))
+{
+	assert(m_MemoryReleased != NULL);
+}
+
+CBatchedFileReader::~CBatchedFileReader()
+{
+	Finish();
+}
+
+bool CBatchedFileReader::Start()
+{
+	assert(m_Threads.empty());
+#ifdef _WIN32
+	m_Port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1);
+	m_ReadSlots = CreateSemaphore(NULL, MAX_READS_IN_FLIGHT, MAX_READS_IN_FLIGHT, NULL);
+	if (!m_Port || !m_ReadSlots)
+		return false;
+	m_CompletionThread = (HANDLE)_beginthreadex(NULL, 0, CompletionThreadProc, this, 0, NULL);
+	if (!m_CompletionThread)
+		return false;
+	for (int i=0; i<OPENER_THREAD_COUNT; ++i)
+	{
+		HANDLE thread = (HANDLE)_beginthreadex(NULL, 0, OpenerThreadProc, this, 0, NULL);
+		if (!thread)
+		{
+			// no file has been queued yet, the caller passes the files to the next sink
+			Finish();
+			return false;
+		}
+		m_Threads.push_back(thread);
+	}
+#else
+	// fails on the kernels without io_uring and where it is disabled by seccomp or sysctl
+	if (!m_Ring.Init(RING_ENTRIES))
+		return false;
+	HANDLE thread = (HANDLE)_beginthreadex(NULL, 0, RingThreadProc, this, 0, NULL);
+	if (!thread)
+		return false;
+	m_Threads.push_back(thread);
+#endif
+	return true;
+}
+
+void CBatchedFileReader::AddJob(const wstring& filepath)
+{
+	if (m_Threads.empty())
+		m_Next->AddJob(filepath);
+	else
+		m_Paths.Push(filepath);
+}
+
+void CBatchedFileReader::Finish()
+{
+	m_Paths.Close();
+	for (size_t i=0,e=m_Threads.size(); i<e; ++i)
+	{
+		WaitForSingleObject(m_Threads[i], INFINITE);
+		CloseHandle(m_Threads[i]);
+	}
+	m_Threads.clear();
+
+#ifdef _WIN32
+	// no read is started after this, the completion thread exits after the reads in flight
+	if (m_CompletionThread)
+	{
+		if (PostQueuedCompletionStatus(m_Port, 0, KEY_FINISH, NULL))
+			WaitForSingleObject(m_CompletionThread, INFINITE);
+		CloseHandle(m_CompletionThread);
+		m_CompletionThread = NULL;
+	}
+	m_Port.Close();
+#endif
+}
+
+bool CBatchedFileReader::TakeFile(const wstring& filepath, SPreloadedFile& file)
+{
+	ULONGLONG memory;
+	{
+		SAutoLock lock(m_Lock);
+		TFileMap::iterator it = m_Files.find(filepath);
+		if (it == m_Files.end())
+			return false;
+		memory = RESULT_MEMORY + it->second.data.size();
+		file.Swap(it->second);
+		m_Files.erase(it);
+	}
+	ReleaseMemory(memory);
+	return true;
+}
+
+void CBatchedFileReader::CompleteRead(SRead* read, bool opened)
+{
+	if (opened)
+	{
+		SAutoLock lock(m_Lock);
+		m_Files[read->filepath].Swap(read->result);
+	}
+	m_Next->AddJob(read->filepath);
+	delete read;
+}
+
+void CBatchedFileReader::DropData(SPreloadedFile& result)
+{
+	ReleaseMemory(result.data.size());
+	std::vector<char>().swap(result.data);
+}
+
+bool CBatchedFileReader::ReserveMemory(ULONGLONG size, bool wait)
+{
+	for (;;)
+	{
+		{
+			SAutoLock lock(m_Lock);
+			// a file bigger than the budget is read when nothing else is held
+			if (!m_ReservedMemory || m_ReservedMemory+size<=MAX_RESERVED_MEMORY)
+			{
+				m_ReservedMemory += size;
+				return true;
+			}
+			if (!wait)
+				return false;
+			++m_MemoryWaiters;
+		}
+		WaitForSingleObject(m_MemoryReleased, INFINITE);
+	}
+}
+
+void CBatchedFileReader::ReleaseMemory(ULONGLONG size)
+{
+	SAutoLock lock(m_Lock);
+	assert(m_ReservedMemory >= size);
+	m_ReservedMemory -= size;
+	// the waiting threads check the budget again
+	if (m_MemoryWaiters)
+	{
+		ReleaseSemaphore(m_MemoryReleased, m_MemoryWaiters, NULL);
+		m_MemoryWaiters = 0;
+	}
+}
+
+#ifdef _WIN32
+
+unsigned __stdcall CBatchedFileReader::OpenerThreadProc(void* param)
+{
+	((CBatchedFileReader*)param)->OpenerThread();
+	return 0;
+}
+
+void CBatchedFileReader::OpenerThread()
+{
+	wstring filepath;
+	while (m_Paths.Pop(filepath))
+	{
+		WaitForSingleObject(m_ReadSlots, INFINITE);
+		if (!StartRead(new SRead(filepath)))
+			ReleaseSemaphore(m_ReadSlots, 1, NULL);
+	}
+}
+
+bool CBatchedFileReader::StartRead(SRead* read)
+{
+	SPreloadedFile& result = read->result;
+	read->file = CreateFile(read->filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+		FILE_FLAG_OVERLAPPED|FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	BY_HANDLE_FILE_INFORMATION info;
+	if (read->file==INVALID_HANDLE_VALUE || !GetFileInformationByHandle(read->file, &info))
+	{
+		read->file.Close();
+		CompleteRead(read, false);
+		return false;
+	}
+	result.file_attributes = info.dwFileAttributes;
+	result.stat = SFileStat(info);
+
+	bool needs_data = result.stat.size && result.stat.size<=MAX_PRELOAD_SIZE &&
+		m_Filter->NeedsData(read->filepath.c_str(), result.file_attributes, result.stat);
+	ReserveMemory(RESULT_MEMORY + (needs_data ? result.stat.size : 0), true);
+	if (!needs_data)
+	{
+		read->file.Close();
+		CompleteRead(read, true);
+		return false;
+	}
+	result.data.resize((size_t)result.stat.size);
+
+	InterlockedIncrement(&m_ReadsInFlight);
+	if (CreateIoCompletionPort(read->file, m_Port, KEY_READ, 0) &&
+		(ReadFile(read->file, &result.data[0], (DWORD)result.data.size(), NULL, &read->overlapped) ||
+		 GetLastError()==ERROR_IO_PENDING))
+	{
+		return true;
+	}
+	InterlockedDecrement(&m_ReadsInFlight);
+	DropData(result);
+	read->file.Close();
+	CompleteRead(read, true);
+	return false;
+}
+
+unsigned __stdcall CBatchedFileReader::CompletionThreadProc(void* param)
+{
+	((CBatchedFileReader*)param)->CompletionThread();
+	return 0;
+}
+
+void CBatchedFileReader::CompletionThread()
+{
+	bool finishing = false;
+	while (!finishing || m_ReadsInFlight)
+	{
+		DWORD transferred;
+		ULONG_PTR key;
+		OVERLAPPED* overlapped;
+		BOOL ok = GetQueuedCompletionStatus(m_Port, &transferred, &key, &overlapped, INFINITE);
+		if (!overlapped)
+		{
+			if (key == KEY_FINISH)
+				finishing = true;
+			else if (!ok)
+				break;
+			continue;
+		}
+
+		SRead* read = CONTAINING_RECORD(overlapped, SRead, overlapped);
+		// a short read means the file has been truncated since the stat, the worker reads it again
+		read->result.loaded = ok && transferred==read->result.data.size();
+		if (!read->result.loaded)
+			DropData(read->result);
+		read->file.Close();
+		CompleteRead(read, true);
+		InterlockedDecrement(&m_ReadsInFlight);
+		ReleaseSemaphore(m_ReadSlots, 1, NULL);
+	}
+}
+
+#else
+
+unsigned __stdcall CBatchedFileReader::RingThreadProc(void* param)
+{
+	((CBatchedFileReader*)param)->RingThread();
+	return 0;
+}
+
+void CBatchedFileReader::RingThread()
+{
+	bool closed = false;
+	for (;;)
+	{
+		while (!m_WaitingReads.empty() && ReserveMemory(m_WaitingReads.front()->memory, false))
+		{
+			StartRead(m_WaitingReads.front());
+			m_WaitingReads.pop_front();
+		}
+		// the new files wait until the stat'ed ones fit into the memory budget
+		wstring filepath;
+		while (m_WaitingReads.empty() && m_ReadsInFlight<MAX_READS_IN_FLIGHT &&
+			m_Ring.GetPendingCount()<(unsigned)MAX_READS_IN_FLIGHT && !closed && m_Paths.TryPop(filepath, closed))
+		{
+			StartOpen(new SRead(filepath));
+		}
+
+		if (!m_Ring.GetPendingCount())
+		{
+			// nothing can complete on the ring, waiting for the workers to take the results
+			// or for the next path
+			if (!m_WaitingReads.empty())
+			{
+				ReserveMemory(m_WaitingReads.front()->memory, true);
+				StartRead(m_WaitingReads.front());
+				m_WaitingReads.pop_front();
+			}
+			else if (!closed && m_Paths.Pop(filepath))
+			{
+				StartOpen(new SRead(filepath));
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		if (!m_Ring.Submit(1))
+		{
+			// the operations in flight are lost, the remaining files are passed on
+			WinError(L"Error submitting the batched reads!");
+			while (m_Paths.Pop(filepath))
+				m_Next->AddJob(filepath);
+			break;
+		}
+		ULONGLONG user_data;
+		int result;
+		while (m_Ring.TakeCompletion(user_data, result))
+		{
+			// the closes have no user data
+			if (user_data)
+				OnCompletion((SRead*)(uintptr_t)user_data, result);
+		}
+	}
+}
+
+void CBatchedFileReader::StartOpen(SRead* read)
+{
+	++m_ReadsInFlight;
+	m_Ring.QueueOpenAt(AT_FDCWD, read->native_path.c_str(), O_RDONLY|O_CLOEXEC, 0, (ULONGLONG)(uintptr_t)read);
+}
+
+void CBatchedFileReader::OnCompletion(SRead* read, int result)
+{
+	SPreloadedFile& preloaded = read->result;
+	switch (read->state)
+	{
+	case SRead::eS_Open:
+		if (result < 0)
+		{
+			FinishRead(read, false);
+			break;
+		}
+		read->fd = result;
+		read->state = SRead::eS_Stat;
+#ifdef __linux__
+		m_Ring.QueueStatx(read->fd, &read->stx, (ULONGLONG)(uintptr_t)read);
+#endif
+		break;
+
+	case SRead::eS_Stat:
+	{
+		if (result < 0)
+		{
+			FinishRead(read, false);
+			break;
+		}
+		BY_HANDLE_FILE_INFORMATION info;
+#ifdef __linux__
+		GetFileInformationFromStatx(read->stx, &info);
+#endif
+		preloaded.file_attributes = info.dwFileAttributes;
+		preloaded.stat = SFileStat(info);
+		read->needs_data = preloaded.stat.size && preloaded.stat.size<=MAX_PRELOAD_SIZE &&
+			m_Filter->NeedsData(read->filepath.c_str(), preloaded.file_attributes, preloaded.stat);
+		read->memory = RESULT_MEMORY + (read->needs_data ? preloaded.stat.size : 0);
+		if (m_WaitingReads.empty() && ReserveMemory(read->memory, false))
+			StartRead(read);
+		else
+			m_WaitingReads.push_back(read);
+		break;
+	}
+
+	case SRead::eS_Read:
+		if (result > 0)
+		{
+			read->bytes_read += (size_t)result;
+			if (read->bytes_read < preloaded.data.size())
+			{
+				m_Ring.QueueRead(read->fd, &preloaded.data[read->bytes_read], (unsigned)(preloaded.data.size()-read->bytes_read),
+					read->bytes_read, (ULONGLONG)(uintptr_t)read);
+				break;
+			}
+		}
+		// a short read means the file has been truncated since the stat, the worker reads it again
+		preloaded.loaded = read->bytes_read == preloaded.data.size();
+		if (!preloaded.loaded)
+			DropData(preloaded);
+		FinishRead(read, true);
+		break;
+	}
+}
+
+void CBatchedFileReader::StartRead(SRead* read)
+{
+	if (!read->needs_data)
+	{
+		FinishRead(read, true);
+		return;
+	}
+	SPreloadedFile& preloaded = read->result;
+	preloaded.data.resize((size_t)preloaded.stat.size);
+	read->state = SRead::eS_Read;
+	m_Ring.QueueRead(read->fd, &preloaded.data[0], (unsigned)preloaded.data.size(), 0, (ULONGLONG)(uintptr_t)read);
+}
+
+void CBatchedFileReader::FinishRead(SRead* read, bool opened)
+{
+	// the fd isn't used after this, so the file can be passed on before the close completes
+	if (read->fd >= 0)
+		m_Ring.QueueClose(read->fd, 0);
+	--m_ReadsInFlight;
+	CompleteRead(read, opened);
+}
+
+#endif
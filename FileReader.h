@@ -0,0 +1,116 @@
+#pragma once
+
+#include "JobQueue.h"
+#include "Manifest.h"
+#ifndef _WIN32
+#include "IoUring.h"
+#endif
+
+
+// A file opened by CBatchedFileReader.
+struct SPreloadedFile
+{
+	DWORD file_attributes;
+	SFileStat stat;
+	// false if the filter didn't need the data or the file is too big to be read at once
+	bool loaded;
+	std::vector<char> data;
+
+	SPreloadedFile() : file_attributes(0), loaded(false) {}
+	void Swap(SPreloadedFile& other)
+	{
+		std::swap(file_attributes, other.file_attributes);
+		std::swap(stat, other.stat);
+		std::swap(loaded, other.loaded);
+		data.swap(other.data);
+	}
+};
+
+
+// Tells the reader whether the data of an opened file is needed.
+struct IPreloadFilter
+{
+	// Called on the reader threads.
+	virtual bool NeedsData(const wchar_t* filepath, DWORD file_attributes, const SFileStat& stat) = 0;
+};
+
+
+// -IO:BATCHED: Opens, stats and reads many files at the same time, so the worker threads don't
+// wait for the disk one file at a time. On Windows a few opener threads open and stat the files
+// and start overlapped reads on a single completion port, the completion thread collects them.
+// On Linux a single thread queues the openat, statx, read and close calls of the files on an
+// io_uring ring and submits them in batches. Start() fails where io_uring isn't available.
+// The paths are passed to the next sink after the file has been read and the workers take
+// the results with TakeFile(). No more reads are started while the results that haven't been
+// taken use too much memory. A file that couldn't be opened here is passed on without a result
+// and the worker falls back to the blocking calls that report the error.
+class CBatchedFileReader : public IFileJobSink
+{
+public:
+	CBatchedFileReader(IPreloadFilter* filter, IFileJobSink* next);
+	~CBatchedFileReader();
+
+	// Returns false on error.
+	bool Start();
+	virtual void AddJob(const wstring& filepath);
+	// Waits until all files have been passed to the next sink.
+	void Finish();
+	// Called by the workers. Returns false if the file hasn't been opened by the reader.
+	bool TakeFile(const wstring& filepath, SPreloadedFile& file);
+
+private:
+	struct SRead;
+
+	void CompleteRead(SRead* read, bool opened);
+	void DropData(SPreloadedFile& result);
+	// Reserves size bytes of the memory budget of the results. If they don't fit, it waits until
+	// they do or returns false if wait is false.
+	bool ReserveMemory(ULONGLONG size, bool wait);
+	void ReleaseMemory(ULONGLONG size);
+#ifdef _WIN32
+	static unsigned __stdcall OpenerThreadProc(void* param);
+	void OpenerThread();
+	// Returns true if the read is in flight on the completion port, otherwise the file has
+	// been passed on.
+	bool StartRead(SRead* read);
+	static unsigned __stdcall CompletionThreadProc(void* param);
+	void CompletionThread();
+#else
+	static unsigned __stdcall RingThreadProc(void* param);
+	void RingThread();
+	void StartOpen(SRead* read);
+	void OnCompletion(SRead* read, int result);
+	// Called after the memory of the result has been reserved.
+	void StartRead(SRead* read);
+	// Queues the close of the file and passes it on.
+	void FinishRead(SRead* read, bool opened);
+#endif
+
+private:
+	IPreloadFilter* m_Filter;
+	IFileJobSink* m_Next;
+	CFileJobQueue m_Paths;
+	// the opener threads on Windows, the ring thread on POSIX
+	std::vector<HANDLE> m_Threads;
+	// the reads on the completion port on Windows, the files on the ring that haven't been passed on yet on POSIX
+	volatile LONG m_ReadsInFlight;
+#ifdef _WIN32
+	SWinHandle m_Port;
+	HANDLE m_CompletionThread;
+	// Its count is the number of reads that can be started on the completion port.
+	SWinHandle m_ReadSlots;
+#else
+	CIoUring m_Ring;
+	// the stat'ed files whose data didn't fit into the memory budget, they are read in order
+	std::deque<SRead*> m_WaitingReads;
+#endif
+
+	CCriticalSection m_Lock;
+	typedef std::map<wstring,SPreloadedFile> TFileMap;
+	TFileMap m_Files;
+	// the memory of the results in m_Files and of the reads in flight
+	ULONGLONG m_ReservedMemory;
+	// the number of threads waiting for m_MemoryReleased
+	LONG m_MemoryWaiters;
+	SWinHandle m_MemoryReleased;
+};
@@ -0,0 +1,290 @@
+#include "stdafx.h"
+#include "GitFilter.h"
+#include "XmlEncoding.h"
+
+
+// Packet size limit of git including the 4 length digits.
+static const size_t MAX_PACKET_SIZE = 65520;
+static const size_t MAX_PACKET_DATA_SIZE = MAX_PACKET_SIZE - 4;
+static const size_t INPUT_BUFFER_SIZE = 0x10000;
+
+// git passes the paths as UTF-8.
+static wstring PathnameToUTF16(const std::string& pathname)
+{
+	IEncoding* encoding = CEncodings::GetInstance().FindEncoding(L"UTF-8");
+	assert(encoding);
+	wstring s;
+	DecodeToUTF16(encoding, pathname.data(), pathname.size(), s);
+	return s;
+}
+
+static bool StartsWith(const std::string& s, const char* prefix, std::string& rest)
+{
+	size_t len = strlen(prefix);
+	if (s.compare(0, len, prefix) != 0)
+		return false;
+	rest = s.substr(len);
+	return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+
+CGitFilterProcess::CGitFilterProcess(IGitBlobFilter* filter)
+: m_Filter(filter)
+, m_Input(GetStdHandle(STD_INPUT_HANDLE))
+, m_Output(GetStdHandle(STD_OUTPUT_HANDLE))
+, m_CanClean(false)
+, m_CanSmudge(false)
+, m_InputPos(0)
+, m_InputEnd(0)
+, m_EndOfInput(false)
+{
+}
+
+bool CGitFilterProcess::Run()
+{
+	m_ErrorMessage.clear();
+	if (m_Input==NULL || m_Input==INVALID_HANDLE_VALUE || m_Output==NULL || m_Output==INVALID_HANDLE_VALUE)
+		return Error(L"The standard handles aren't available!");
+	m_InputBuffer.resize(INPUT_BUFFER_SIZE);
+
+	if (!Handshake())
+		return false;
+	while (ProcessCommand())
+	{
+	}
+	return m_ErrorMessage.empty();
+}
+
+bool CGitFilterProcess::Handshake()
+{
+	std::vector<std::string> lines;
+	if (!ReadTextList(lines))
+		return Error(L"Missing git filter handshake!");
+	if (lines.empty() || lines[0]!="git-filter-client")
+		return Error(L"Invalid git filter handshake!");
+	if (std::find(lines.begin(), lines.end(), "version=2") == lines.end())
+		return Error(L"git doesn't support version 2 of the filter protocol!");
+
+	WriteText("git-filter-server\n");
+	WriteText("version=2\n");
+	WriteFlush();
+	if (!FlushOutput())
+		return false;
+
+	if (!ReadTextList(lines))
+		return Error(L"Missing git filter capabilities!");
+	m_CanClean = std::find(lines.begin(), lines.end(), "capability=clean") != lines.end();
+	m_CanSmudge = std::find(lines.begin(), lines.end(), "capability=smudge") != lines.end();
+	if (m_CanClean)
+		WriteText("capability=clean\n");
+	if (m_CanSmudge)
+		WriteText("capability=smudge\n");
+	WriteFlush();
+	return FlushOutput();
+}
+
+bool CGitFilterProcess::ProcessCommand()
+{
+	std::vector<std::string> lines;
+	if (!ReadTextList(lines))
+	{
+		// git closed the pipe between two commands
+		if (m_EndOfInput && lines.empty())
+			m_ErrorMessage.clear();
+		return false;
+	}
+
+	std::string command, pathname, value;
+	for (size_t i=0,e=lines.size(); i<e; ++i)
+	{
+		if (StartsWith(lines[i], "command=", value))
+			command = value;
+		else if (StartsWith(lines[i], "pathname=", value))
+			pathname = value;
+	}
+
+	std::vector<char> data;
+	if (!ReadContent(data))
+		return false;
+
+	wstring path = PathnameToUTF16(pathname);
+	wstring error_message;
+	bool success;
+	if (command=="clean" && m_CanClean)
+		success = m_Filter->Clean(path.c_str(), data, error_message);
+	else if (command=="smudge" && m_CanSmudge)
+		success = m_Filter->Smudge(path.c_str(), data, error_message);
+	else
+	{
+		success = false;
+		error_message = L"Unsupported git filter command: ";
+		error_message.append(PathnameToUTF16(command));
+	}
+
+	if (success)
+	{
+		WriteText("status=success\n");
+		WriteFlush();
+		WriteContent(data);
+		WriteFlush();
+		// the empty list keeps the status
+		WriteFlush();
+	}
+	else
+	{
+		// stdout belongs to the protocol, git keeps the original blob
+		::Error(L"Filtering %s... %s", path.c_str(), error_message.c_str());
+		WriteText("status=error\n");
+		WriteFlush();
+	}
+	return FlushOutput();
+}
+
+bool CGitFilterProcess::ReadBytes(void* dst, size_t size)
+{
+	char* p = (char*)dst;
+	while (size)
+	{
+		if (m_InputPos == m_InputEnd)
+		{
+			DWORD read;
+			if (!ReadFile(m_Input, &m_InputBuffer[0], (DWORD)m_InputBuffer.size(), &read, NULL))
+			{
+				if (GetLastError() != ERROR_BROKEN_PIPE)
+					return Error(L"Error reading stdin! %s", LastErrorToString(GetLastError()).c_str());
+				read = 0;
+			}
+			if (!read)
+			{
+				m_EndOfInput = true;
+				return Error(L"Unexpected end of the git filter input!");
+			}
+			m_InputPos = 0;
+			m_InputEnd = read;
+		}
+		size_t count = min(size, m_InputEnd-m_InputPos);
+		memcpy(p, &m_InputBuffer[m_InputPos], count);
+		m_InputPos += count;
+		p += count;
+		size -= count;
+	}
+	return true;
+}
+
+bool CGitFilterProcess::ReadPacket(std::vector<char>& packet, bool& flush)
+{
+	char len_str[4];
+	if (!ReadBytes(len_str, sizeof(len_str)))
+		return false;
+	size_t len = 0;
+	for (int i=0; i<4; ++i)
+	{
+		char c = len_str[i];
+		if (c>='0' && c<='9')
+			c -= '0';
+		else if (c>='a' && c<='f')
+			c = c - 'a' + 10;
+		else if (c>='A' && c<='F')
+			c = c - 'A' + 10;
+		else
+			return Error(L"Invalid pkt-line length!");
+		len = (len << 4) | c;
+	}
+
+	flush = len == 0;
+	packet.clear();
+	if (flush)
+		return true;
+	if (len<=4 || len>MAX_PACKET_SIZE)
+		return Error(L"Invalid pkt-line length: %d", (int)len);
+	packet.resize(len-4);
+	return ReadBytes(&packet[0], packet.size());
+}
+
+bool CGitFilterProcess::ReadTextList(std::vector<std::string>& lines)
+{
+	lines.clear();
+	std::vector<char> packet;
+	bool flush;
+	while (1)
+	{
+		if (!ReadPacket(packet, flush))
+			return false;
+		if (flush)
+			return true;
+		size_t len = packet.size();
+		while (len && packet[len-1]=='\n')
+			--len;
+		lines.push_back(std::string(packet.begin(), packet.begin()+len));
+	}
+}
+
+bool CGitFilterProcess::ReadContent(std::vector<char>& data)
+{
+	data.clear();
+	std::vector<char> packet;
+	bool flush;
+	while (1)
+	{
+		if (!ReadPacket(packet, flush))
+			return false;
+		if (flush)
+			return true;
+		data.insert(data.end(), packet.begin(), packet.end());
+	}
+}
+
+void CGitFilterProcess::WritePacket(const void* data, size_t size)
+{
+	assert(size>0 && size<=MAX_PACKET_DATA_SIZE);
+	char len_str[5];
+	sprintf(len_str, "%04x", (unsigned)(size+4));
+	m_OutputBuffer.insert(m_OutputBuffer.end(), len_str, len_str+4);
+	m_OutputBuffer.insert(m_OutputBuffer.end(), (const char*)data, (const char*)data+size);
+}
+
+void CGitFilterProcess::WriteText(const char* line)
+{
+	WritePacket(line, strlen(line));
+}
+
+void CGitFilterProcess::WriteFlush()
+{
+	m_OutputBuffer.insert(m_OutputBuffer.end(), 4, '0');
+}
+
+void CGitFilterProcess::WriteContent(const std::vector<char>& data)
+{
+	for (size_t pos=0,size=data.size(); pos<size; pos+=MAX_PACKET_DATA_SIZE)
+		WritePacket(&data[pos], min(size-pos, MAX_PACKET_DATA_SIZE));
+}
+
+bool CGitFilterProcess::FlushOutput()
+{
+	for (size_t pos=0,size=m_OutputBuffer.size(); pos<size; )
+	{
+		DWORD written;
+		if (!WriteFile(m_Output, &m_OutputBuffer[pos], (DWORD)(size-pos), &written, NULL) || !written)
+			return Error(L"Error writing stdout! %s", LastErrorToString(GetLastError()).c_str());
+		pos += written;
+	}
+	m_OutputBuffer.clear();
+	return true;
+}
+
+bool CGitFilterProcess::Error(const wchar_t* fmtstr, ...)
+{
+	if (!m_ErrorMessage.empty())
+		return false;
+	wchar_t buf[0x400];
+	va_list args;
+	va_start(args, fmtstr);
+	vswprintf(buf, sizeof(buf)/sizeof(buf[0]), fmtstr, args);
+	va_end(args);
+	m_ErrorMessage = buf;
+	return false;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+
+// Transforms the blobs passed by git. Returns false with an error message if the blob can't be
+// transformed, git keeps the original blob in that case unless the filter is required.
+struct IGitBlobFilter
+{
+	virtual bool Clean(const wchar_t* pathname, std::vector<char>& data, wstring& error_message) = 0;
+	virtual bool Smudge(const wchar_t* pathname, std::vector<char>& data, wstring& error_message) = 0;
+};
+
+
+// Serves git's long running filter process protocol (filter.<driver>.process) on stdin and
+// stdout so a single process can filter all blobs of a git command. The messages are pkt-lines:
+// 4 hex digits of length (including the 4 digits) followed by the data, "0000" is a flush packet.
+class CGitFilterProcess
+{
+public:
+	CGitFilterProcess(IGitBlobFilter* filter);
+
+	// Serves the requests until git closes the pipe. Returns false on a protocol or I/O error.
+	bool Run();
+	const wstring& GetErrorMessage() const				{ return m_ErrorMessage; }
+
+private:
+	bool Handshake();
+	// Returns false at the end of the input with an empty error message.
+	bool ProcessCommand();
+
+	bool ReadBytes(void* dst, size_t size);
+	// flush is set for a flush packet.
+	bool ReadPacket(std::vector<char>& packet, bool& flush);
+	// Reads text packets until a flush packet, the trailing newlines are removed.
+	bool ReadTextList(std::vector<std::string>& lines);
+	bool ReadContent(std::vector<char>& data);
+
+	void WritePacket(const void* data, size_t size);
+	void WriteText(const char* line);
+	void WriteFlush();
+	void WriteContent(const std::vector<char>& data);
+	bool FlushOutput();
+
+	bool Error(const wchar_t* fmtstr, ...);
+
+private:
+	IGitBlobFilter* m_Filter;
+	HANDLE m_Input;
+	HANDLE m_Output;
+	bool m_CanClean;
+	bool m_CanSmudge;
+
+	std::vector<char> m_InputBuffer;
+	size_t m_InputPos;
+	size_t m_InputEnd;
+	bool m_EndOfInput;
+	std::vector<char> m_OutputBuffer;
+
+	wstring m_ErrorMessage;
+};
@@ -0,0 +1,270 @@
+#include "stdafx.h"
+
+#ifndef _WIN32
+
+#include "IoUring.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+
+
+#ifdef __linux__
+// The operations used by the batched reader and the commit queue.
+static const int REQUIRED_OPS[] =
+{
+	IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ, IORING_OP_WRITE,
+	IORING_OP_FSYNC, IORING_OP_CLOSE, IORING_OP_RENAMEAT,
+};
+
+static bool HasRequiredOps(int fd)
+{
+	const unsigned OP_COUNT = 256;
+	std::vector<char> buf(sizeof(io_uring_probe) + OP_COUNT*sizeof(io_uring_probe_op));
+	io_uring_probe* probe = (io_uring_probe*)&buf[0];
+	if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, OP_COUNT) < 0)
+		return false;
+	for (size_t i=0; i<sizeof(REQUIRED_OPS)/sizeof(REQUIRED_OPS[0]); ++i)
+	{
+		int op = REQUIRED_OPS[i];
+		if (op>probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED))
+		{
+			errno = EOPNOTSUPP;
+			return false;
+		}
+	}
+	return true;
+}
+
+static void* MapRing(int fd, size_t size, off_t offset)
+{
+	void* p = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, fd, offset);
+	return p==MAP_FAILED ? NULL : p;
+}
+#endif
+
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+
+CIoUring::CIoUring()
+: m_Fd(-1)
+, m_SqRing(NULL)
+, m_SqRingSize(0)
+, m_CqRing(NULL)
+, m_CqRingSize(0)
+, m_Sqes(NULL)
+, m_SqesSize(0)
+, m_SqHead(NULL)
+, m_SqTail(NULL)
+, m_SqMask(0)
+, m_SqEntries(0)
+, m_CqHead(NULL)
+, m_CqTail(NULL)
+, m_CqMask(0)
+, m_Cqes(NULL)
+, m_QueuedCount(0)
+, m_PendingCount(0)
+{
+}
+
+CIoUring::~CIoUring()
+{
+	Close();
+}
+
+void CIoUring::Close()
+{
+	if (m_Sqes)
+		munmap(m_Sqes, m_SqesSize);
+	if (m_CqRing && m_CqRing!=m_SqRing)
+		munmap(m_CqRing, m_CqRingSize);
+	if (m_SqRing)
+		munmap(m_SqRing, m_SqRingSize);
+	if (m_Fd >= 0)
+		close(m_Fd);
+	m_Fd = -1;
+	m_SqRing = m_CqRing = NULL;
+	m_Sqes = NULL;
+	m_QueuedCount = m_PendingCount = 0;
+}
+
+#ifdef __linux__
+
+bool CIoUring::Init(unsigned entries)
+{
+	assert(m_Fd < 0);
+	io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	m_Fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+	if (m_Fd < 0)
+		return false;
+
+	m_SqRingSize = params.sq_off.array + params.sq_entries*sizeof(unsigned);
+	m_CqRingSize = params.cq_off.cqes + params.cq_entries*sizeof(io_uring_cqe);
+	// the kernels since 5.4 map both rings with a single mapping
+	if (params.features & IORING_FEAT_SINGLE_MMAP)
+		m_SqRingSize = m_CqRingSize = max(m_SqRingSize, m_CqRingSize);
+	m_SqRing = MapRing(m_Fd, m_SqRingSize, IORING_OFF_SQ_RING);
+	if (m_SqRing)
+	{
+		m_CqRing = (params.features & IORING_FEAT_SINGLE_MMAP) ? m_SqRing : MapRing(m_Fd, m_CqRingSize, IORING_OFF_CQ_RING);
+		m_SqesSize = params.sq_entries*sizeof(io_uring_sqe);
+		m_Sqes = (io_uring_sqe*)MapRing(m_Fd, m_SqesSize, IORING_OFF_SQES);
+	}
+	if (!m_CqRing || !m_Sqes || !HasRequiredOps(m_Fd))
+	{
+		int last_error = errno;
+		Close();
+		errno = last_error;
+		return false;
+	}
+
+	char* sq = (char*)m_SqRing;
+	m_SqHead = (unsigned*)(sq + params.sq_off.head);
+	m_SqTail = (unsigned*)(sq + params.sq_off.tail);
+	m_SqMask = *(unsigned*)(sq + params.sq_off.ring_mask);
+	m_SqEntries = params.sq_entries;
+	// the submission queue entries are used in ring order
+	unsigned* sq_array = (unsigned*)(sq + params.sq_off.array);
+	for (unsigned i=0; i<m_SqEntries; ++i)
+		sq_array[i] = i;
+
+	char* cq = (char*)m_CqRing;
+	m_CqHead = (unsigned*)(cq + params.cq_off.head);
+	m_CqTail = (unsigned*)(cq + params.cq_off.tail);
+	m_CqMask = *(unsigned*)(cq + params.cq_off.ring_mask);
+	m_Cqes = (io_uring_cqe*)(cq + params.cq_off.cqes);
+	return true;
+}
+
+io_uring_sqe* CIoUring::QueueSqe(int opcode, int fd, ULONGLONG user_data)
+{
+	assert(m_Fd>=0 && m_PendingCount<m_SqEntries);
+	// the kernel copies the entries at submission, so all of them are free when nothing is queued
+	unsigned tail = *m_SqTail;
+	io_uring_sqe* sqe = &m_Sqes[tail & m_SqMask];
+	memset(sqe, 0, sizeof(*sqe));
+	sqe->opcode = (__u8)opcode;
+	sqe->fd = fd;
+	sqe->user_data = user_data;
+	__atomic_store_n(m_SqTail, tail+1, __ATOMIC_RELEASE);
+	++m_QueuedCount;
+	++m_PendingCount;
+	return sqe;
+}
+
+void CIoUring::QueueOpenAt(int dir_fd, const char* path, int flags, unsigned mode, ULONGLONG user_data)
+{
+	io_uring_sqe* sqe = QueueSqe(IORING_OP_OPENAT, dir_fd, user_data);
+	sqe->addr = (ULONGLONG)(uintptr_t)path;
+	sqe->len = mode;
+	sqe->open_flags = (__u32)flags;
+}
+
+void CIoUring::QueueStatx(int fd, struct statx* stx, ULONGLONG user_data)
+{
+	io_uring_sqe* sqe = QueueSqe(IORING_OP_STATX, fd, user_data);
+	sqe->addr = (ULONGLONG)(uintptr_t)"";
+	sqe->len = STATX_BASIC_STATS;
+	sqe->addr2 = (ULONGLONG)(uintptr_t)stx;
+	sqe->statx_flags = AT_EMPTY_PATH;
+}
+
+void CIoUring::QueueRead(int fd, void* buffer, unsigned size, ULONGLONG offset, ULONGLONG user_data)
+{
+	io_uring_sqe* sqe = QueueSqe(IORING_OP_READ, fd, user_data);
+	sqe->addr = (ULONGLONG)(uintptr_t)buffer;
+	sqe->len = size;
+	sqe->off = offset;
+}
+
+void CIoUring::QueueWrite(int fd, const void* buffer, unsigned size, ULONGLONG offset, ULONGLONG user_data)
+{
+	io_uring_sqe* sqe = QueueSqe(IORING_OP_WRITE, fd, user_data);
+	sqe->addr = (ULONGLONG)(uintptr_t)buffer;
+	sqe->len = size;
+	sqe->off = offset;
+}
+
+void CIoUring::QueueFsync(int fd, ULONGLONG user_data)
+{
+	QueueSqe(IORING_OP_FSYNC, fd, user_data);
+}
+
+void CIoUring::QueueClose(int fd, ULONGLONG user_data)
+{
+	QueueSqe(IORING_OP_CLOSE, fd, user_data);
+}
+
+void CIoUring::QueueRenameAt(int old_dir_fd, const char* old_path, int new_dir_fd, const char* new_path, ULONGLONG user_data)
+{
+	io_uring_sqe* sqe = QueueSqe(IORING_OP_RENAMEAT, old_dir_fd, user_data);
+	sqe->addr = (ULONGLONG)(uintptr_t)old_path;
+	sqe->len = (__u32)new_dir_fd;
+	sqe->addr2 = (ULONGLONG)(uintptr_t)new_path;
+}
+
+bool CIoUring::Submit(unsigned wait_count)
+{
+	assert(wait_count <= m_PendingCount);
+	for (;;)
+	{
+		unsigned ready = __atomic_load_n(m_CqTail, __ATOMIC_ACQUIRE) - *m_CqHead;
+		bool wait = ready < wait_count;
+		if (!m_QueuedCount && !wait)
+			return true;
+		int res = (int)syscall(__NR_io_uring_enter, m_Fd, m_QueuedCount, wait ? wait_count : 0,
+			wait ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+		if (res < 0)
+		{
+			// interrupted by a signal or the kernel is short of memory for the requests
+			if (errno==EINTR || errno==EAGAIN)
+				continue;
+			return false;
+		}
+		assert((unsigned)res <= m_QueuedCount);
+		m_QueuedCount -= (unsigned)res;
+	}
+}
+
+bool CIoUring::TakeCompletion(ULONGLONG& user_data, int& result)
+{
+	unsigned head = *m_CqHead;
+	if (head == __atomic_load_n(m_CqTail, __ATOMIC_ACQUIRE))
+		return false;
+	const io_uring_cqe& cqe = m_Cqes[head & m_CqMask];
+	user_data = cqe.user_data;
+	result = cqe.res;
+	__atomic_store_n(m_CqHead, head+1, __ATOMIC_RELEASE);
+	assert(m_PendingCount);
+	--m_PendingCount;
+	return true;
+}
+
+#else
+
+bool CIoUring::Init(unsigned entries)
+{
+	errno = ENOSYS;
+	return false;
+}
+
+// Init() always fails, so these are never called.
+void CIoUring::QueueOpenAt(int dir_fd, const char* path, int flags, unsigned mode, ULONGLONG user_data)	{ assert(0); }
+void CIoUring::QueueStatx(int fd, struct statx* stx, ULONGLONG user_data)								{ assert(0); }
+void CIoUring::QueueRead(int fd, void* buffer, unsigned size, ULONGLONG offset, ULONGLONG user_data)		{ assert(0); }
+void CIoUring::QueueWrite(int fd, const void* buffer, unsigned size, ULONGLONG offset, ULONGLONG user_data)	{ assert(0); }
+void CIoUring::QueueFsync(int fd, ULONGLONG user_data)													{ assert(0); }
+void CIoUring::QueueClose(int fd, ULONGLONG user_data)													{ assert(0); }
+void CIoUring::QueueRenameAt(int old_dir_fd, const char* old_path, int new_dir_fd, const char* new_path, ULONGLONG user_data)	{ assert(0); }
+bool CIoUring::Submit(unsigned wait_count)																{ errno = ENOSYS; return false; }
+bool CIoUring::TakeCompletion(ULONGLONG& user_data, int& result)										{ return false; }
+
+#endif
+
+#endif
@@ -0,0 +1,67 @@
+#pragma once
+
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct statx;
+
+
+// An io_uring submission and completion ring on top of the raw system calls. The operations are
+// queued and then submitted together, so a batch of opens, reads, writes or renames costs a single
+// io_uring_enter() call instead of one system call each. Used by one thread at a time.
+// Linux only, Init() fails with ENOSYS on the other POSIX systems.
+class CIoUring
+{
+public:
+	CIoUring();
+	~CIoUring();
+
+	// At most entries operations can be pending. Fails with errno set if the kernel doesn't have
+	// io_uring or one of the operations below, the callers fall back to the blocking calls then.
+	bool Init(unsigned entries);
+	bool IsInitialized() const							{ return m_Fd >= 0; }
+
+	// The paths and the buffers must stay valid until the completion has been taken.
+	void QueueOpenAt(int dir_fd, const char* path, int flags, unsigned mode, ULONGLONG user_data);
+	// Stats an open file.
+	void QueueStatx(int fd, struct statx* stx, ULONGLONG user_data);
+	void QueueRead(int fd, void* buffer, unsigned size, ULONGLONG offset, ULONGLONG user_data);
+	void QueueWrite(int fd, const void* buffer, unsigned size, ULONGLONG offset, ULONGLONG user_data);
+	void QueueFsync(int fd, ULONGLONG user_data);
+	void QueueClose(int fd, ULONGLONG user_data);
+	void QueueRenameAt(int old_dir_fd, const char* old_path, int new_dir_fd, const char* new_path, ULONGLONG user_data);
+
+	// Submits the queued operations and waits until at least wait_count completions can be taken.
+	// Returns false with errno set on error.
+	bool Submit(unsigned wait_count);
+	// Takes the next completion. result is the return value of the system call or -errno.
+	bool TakeCompletion(ULONGLONG& user_data, int& result);
+	// The number of the queued and submitted operations whose completion hasn't been taken yet.
+	unsigned GetPendingCount() const					{ return m_PendingCount; }
+
+private:
+	io_uring_sqe* QueueSqe(int opcode, int fd, ULONGLONG user_data);
+	void Close();
+
+private:
+	int m_Fd;
+	void* m_SqRing;
+	size_t m_SqRingSize;
+	void* m_CqRing;
+	size_t m_CqRingSize;
+	io_uring_sqe* m_Sqes;
+	size_t m_SqesSize;
+
+	unsigned* m_SqHead;
+	unsigned* m_SqTail;
+	unsigned m_SqMask;
+	unsigned m_SqEntries;
+	unsigned* m_CqHead;
+	unsigned* m_CqTail;
+	unsigned m_CqMask;
+	io_uring_cqe* m_Cqes;
+
+	// queued but not submitted yet
+	unsigned m_QueuedCount;
+	unsigned m_PendingCount;
+};
@@ -0,0 +1,63 @@
+#include "stdafx.h"
+#include "JobQueue.h"
+
+
+CFileJobPool::CFileJobPool(IFileJobProcessor* processor)
+: m_Processor(processor)
+, m_ErrorCount(0)
+{
+}
+
+CFileJobPool::~CFileJobPool()
+{
+	Finish();
+}
+
+int CFileJobPool::GetDefaultThreadCount()
+{
+	SYSTEM_INFO system_info;
+	GetSystemInfo(&system_info);
+	return max(1, (int)system_info.dwNumberOfProcessors);
+}
+
+bool CFileJobPool::Start(int thread_count)
+{
+	assert(m_Threads.empty());
+	assert(thread_count > 0);
+	for (int i=0; i<thread_count; ++i)
+	{
+		HANDLE thread = (HANDLE)_beginthreadex(NULL, 0, WorkerThreadProc, this, 0, NULL);
+		if (!thread)
+			return false;
+		m_Threads.push_back(thread);
+	}
+	return true;
+}
+
+int CFileJobPool::Finish()
+{
+	m_Queue.Close();
+	for (size_t i=0,e=m_Threads.size(); i<e; ++i)
+	{
+		WaitForSingleObject(m_Threads[i], INFINITE);
+		CloseHandle(m_Threads[i]);
+	}
+	m_Threads.clear();
+	return (int)m_ErrorCount;
+}
+
+unsigned __stdcall CFileJobPool::WorkerThreadProc(void* param)
+{
+	((CFileJobPool*)param)->WorkerThread();
+	return 0;
+}
+
+void CFileJobPool::WorkerThread()
+{
+	wstring filepath;
+	while (m_Queue.Pop(filepath))
+	{
+		if (!m_Processor->ProcessFile(filepath.c_str()))
+			InterlockedIncrement(&m_ErrorCount);
+	}
+}
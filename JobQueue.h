@@ -0,0 +1,155 @@
+#pragma once
+
+
+// Thread safe FIFO. Any number of threads can push and pop.
+template <typename T>
+class CJobQueue
+{
+public:
+	CJobQueue();
+
+	void Push(const T& job);
+	// Blocks until a job is available. Returns false if the queue is closed and there are
+	// no more jobs in it.
+	bool Pop(T& job);
+	// Doesn't block, returns false if no job is available. closed is set if there won't be more.
+	bool TryPop(T& job, bool& closed);
+	// Call this after the last Push() to release the threads that are waiting in Pop().
+	void Close();
+
+private:
+	CCriticalSection m_Lock;
+	// Its count is the number of jobs in the queue (plus one after Close()).
+	SWinHandle m_Semaphore;
+	std::vector<T> m_Jobs;
+	size_t m_FirstJob;
+	bool m_Closed;
+};
+
+template <typename T>
+CJobQueue<T>::CJobQueue()
+: m_Semaphore(CreateSemaphore(NULL, 0, 0x7FFFFFFF, NULL))
+, m_FirstJob(0)
+, m_Closed(false)
+{
+	assert(m_Semaphore != NULL);
+}
+
+template <typename T>
+void CJobQueue<T>::Push(const T& job)
+{
+	{
+		SAutoLock lock(m_Lock);
+		assert(!m_Closed);
+		m_Jobs.push_back(job);
+	}
+	ReleaseSemaphore(m_Semaphore, 1, NULL);
+}
+
+template <typename T>
+bool CJobQueue<T>::Pop(T& job)
+{
+	WaitForSingleObject(m_Semaphore, INFINITE);
+
+	SAutoLock lock(m_Lock);
+	if (m_FirstJob >= m_Jobs.size())
+	{
+		assert(m_Closed);
+		// passing the close signal to the next waiting thread
+		ReleaseSemaphore(m_Semaphore, 1, NULL);
+		return false;
+	}
+
+	std::swap(job, m_Jobs[m_FirstJob++]);
+	if (m_FirstJob == m_Jobs.size())
+	{
+		m_Jobs.clear();
+		m_FirstJob = 0;
+	}
+	return true;
+}
+
+template <typename T>
+bool CJobQueue<T>::TryPop(T& job, bool& closed)
+{
+	closed = false;
+	if (WaitForSingleObject(m_Semaphore, 0) != WAIT_OBJECT_0)
+		return false;
+
+	SAutoLock lock(m_Lock);
+	if (m_FirstJob >= m_Jobs.size())
+	{
+		assert(m_Closed);
+		ReleaseSemaphore(m_Semaphore, 1, NULL);
+		closed = true;
+		return false;
+	}
+
+	std::swap(job, m_Jobs[m_FirstJob++]);
+	if (m_FirstJob == m_Jobs.size())
+	{
+		m_Jobs.clear();
+		m_FirstJob = 0;
+	}
+	return true;
+}
+
+template <typename T>
+void CJobQueue<T>::Close()
+{
+	{
+		SAutoLock lock(m_Lock);
+		if (m_Closed)
+			return;
+		m_Closed = true;
+	}
+	ReleaseSemaphore(m_Semaphore, 1, NULL);
+}
+
+typedef CJobQueue<wstring> CFileJobQueue;
+
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+
+struct IFileJobProcessor
+{
+	// Called from the worker threads. Returns false on error.
+	virtual bool ProcessFile(const wchar_t* filepath) = 0;
+};
+
+
+// Receives the paths found by the directory walker, the file patterns and the file lists.
+struct IFileJobSink
+{
+	virtual void AddJob(const wstring& filepath) = 0;
+};
+
+
+// Processes the queued files on several threads.
+class CFileJobPool : public IFileJobSink
+{
+public:
+	CFileJobPool(IFileJobProcessor* processor);
+	~CFileJobPool();
+
+	// Returns the number of logical processors.
+	static int GetDefaultThreadCount();
+
+	// Returns false on error.
+	bool Start(int thread_count);
+	virtual void AddJob(const wstring& filepath)		{ m_Queue.Push(filepath); }
+	// Waits for the completion of all jobs and returns the number of failed jobs.
+	int Finish();
+
+private:
+	static unsigned __stdcall WorkerThreadProc(void* param);
+	void WorkerThread();
+
+private:
+	IFileJobProcessor* m_Processor;
+	CFileJobQueue m_Queue;
+	std::vector<HANDLE> m_Threads;
+	volatile LONG m_ErrorCount;
+};
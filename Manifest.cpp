@@ -0,0 +1,266 @@
+#include "stdafx.h"
+#include "Manifest.h"
+#include "XmlEncoding.h"
+
+
+// Manifest file format (UTF-8):
+//   VcprojFormatter manifest 1
+//   options: <options signature>
+//   <size>\t<last write time>\t<hash>\t<full path>
+//   ...
+// The numbers are 16 digit hexadecimal numbers.
+static const wchar_t MANIFEST_HEADER[] = L"VcprojFormatter manifest 1";
+static const wchar_t MANIFEST_OPTIONS[] = L"options: ";
+
+// Not a static because CEncodings is constructed during the static initialization of another file.
+static IEncoding* GetManifestEncoding()
+{
+	return CEncodings::GetInstance().FindEncoding(L"UTF-8");
+}
+
+
+static bool ParseHex(const wchar_t*& p, const wchar_t* p_end, ULONGLONG& value)
+{
+	value = 0;
+	const wchar_t* begin = p;
+	for (; p<p_end && p-begin<16; ++p)
+	{
+		wchar_t c = *p;
+		if (c>=L'0' && c<=L'9')
+			c -= L'0';
+		else if (c>=L'a' && c<=L'f')
+			c = c - L'a' + 10;
+		else if (c>=L'A' && c<=L'F')
+			c = c - L'A' + 10;
+		else
+			break;
+		value = (value << 4) | c;
+	}
+	return p > begin;
+}
+
+static bool ParseTab(const wchar_t*& p, const wchar_t* p_end)
+{
+	if (p>=p_end || *p!=L'\t')
+		return false;
+	++p;
+	return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+
+CFormatManifest::CFormatManifest()
+: m_Modified(false)
+{
+}
+
+wstring CFormatManifest::GetKey(const wchar_t* filepath)
+{
+	wstring key;
+	key.resize(MAX_PATH);
+	DWORD len = GetFullPathName(filepath, (DWORD)key.size(), &key[0], NULL);
+	if (len > key.size())
+	{
+		key.resize(len);
+		len = GetFullPathName(filepath, (DWORD)key.size(), &key[0], NULL);
+	}
+	if (!len || len>key.size())
+		key = filepath;
+	else
+		key.resize(len);
+
+#ifdef _WIN32
+	for (size_t i=0,e=key.size(); i<e; ++i)
+	{
+		if (key[i]>=L'A' && key[i]<=L'Z')
+			key[i] = key[i] - L'A' + L'a';
+		else if (key[i] == L'/')
+			key[i] = L'\\';
+	}
+#endif
+	return key;
+}
+
+bool CFormatManifest::Load(const wchar_t* filepath, const wstring& options_signature)
+{
+	IEncoding* encoding = GetManifestEncoding();
+	assert(encoding);
+	m_ErrorMessage.clear();
+	m_FilePath = filepath;
+	m_OptionsSignature = options_signature;
+	m_Entries.clear();
+	m_Modified = true;
+
+	SWinHandle handle = CreateFile(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
+	if (handle == INVALID_HANDLE_VALUE)
+	{
+		DWORD last_error = GetLastError();
+		if (last_error==ERROR_FILE_NOT_FOUND || last_error==ERROR_PATH_NOT_FOUND)
+			return true;
+		return Error(L"Error opening manifest %s! %s", filepath, LastErrorToString(last_error).c_str());
+	}
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(handle, &file_size))
+		return Error(L"Error retrieving the size of manifest %s! %s", filepath, LastErrorToString(GetLastError()).c_str());
+	if (file_size.HighPart || file_size.LowPart>=0x80000000)
+		return Error(L"Manifest %s is too big!", filepath);
+	if (!file_size.LowPart)
+		return true;
+
+	std::vector<char> buf;
+	buf.resize(file_size.LowPart);
+	DWORD read;
+	if (!ReadFile(handle, &buf[0], file_size.LowPart, &read, NULL) || read!=file_size.LowPart)
+		return Error(L"Error reading manifest %s! %s", filepath, LastErrorToString(GetLastError()).c_str());
+	handle.Close();
+
+	wstring error_message;
+	wstring text;
+	if (!DecodeToUTF16(encoding, &buf[0], buf.size(), text, &error_message) || text.empty())
+		return Error(L"Error decoding manifest %s! %s", filepath, error_message.c_str());
+
+	const wchar_t* p = text.data();
+	const wchar_t* p_end = p + text.size();
+	for (int line_index=0; p<p_end; ++line_index)
+	{
+		const wchar_t* line = p;
+		while (p<p_end && *p!=L'\r' && *p!=L'\n')
+			++p;
+		const wchar_t* line_end = p;
+		while (p<p_end && (*p==L'\r' || *p==L'\n'))
+			++p;
+
+		wstring s(line, line_end);
+		switch (line_index)
+		{
+		case 0:
+			if (s != MANIFEST_HEADER)
+				return Error(L"%s is not a manifest file of this program!", filepath);
+			break;
+		case 1:
+			// the canonical form of the files was different with the previous options
+			if (s != MANIFEST_OPTIONS + m_OptionsSignature)
+				return true;
+			break;
+		default:
+			ParseLine(line, line_end);
+			break;
+		}
+	}
+
+	m_Modified = false;
+	return true;
+}
+
+void CFormatManifest::ParseLine(const wchar_t* line, const wchar_t* line_end)
+{
+	// Invalid lines are dropped, they can't do any harm.
+	const wchar_t* p = line;
+	SEntry entry;
+	if (!ParseHex(p, line_end, entry.stat.size) || !ParseTab(p, line_end))
+		return;
+	if (!ParseHex(p, line_end, entry.stat.last_write_time) || !ParseTab(p, line_end))
+		return;
+	if (!ParseHex(p, line_end, entry.hash) || !ParseTab(p, line_end))
+		return;
+	if (p >= line_end)
+		return;
+	m_Entries[wstring(p, line_end)] = entry;
+}
+
+bool CFormatManifest::Save()
+{
+	IEncoding* encoding = GetManifestEncoding();
+	assert(encoding);
+	m_ErrorMessage.clear();
+	SAutoLock lock(m_Lock);
+	if (!m_Modified)
+		return true;
+
+	wstring text = MANIFEST_HEADER;
+	text.append(L"\r\n");
+	text.append(MANIFEST_OPTIONS);
+	text.append(m_OptionsSignature);
+	text.append(L"\r\n");
+	for (TEntryMap::const_iterator it=m_Entries.begin(),eit=m_Entries.end(); it!=eit; ++it)
+	{
+		wchar_t buf[0x40];
+		swprintf(buf, sizeof(buf)/sizeof(buf[0]), L"%016llx\t%016llx\t%016llx\t",
+			it->second.stat.size, it->second.stat.last_write_time, it->second.hash);
+		text.append(buf);
+		text.append(it->first);
+		text.append(L"\r\n");
+	}
+
+	wstring error_message;
+	std::vector<char> data;
+	if (!EncodeFromUTF16(encoding, text.data(), text.size(), data, &error_message))
+		return Error(L"Error encoding manifest! %s", error_message.c_str());
+
+	wstring temp_path = m_FilePath;
+	temp_path += L"_$temp$";
+	{
+		SWinHandle handle = CreateFile(temp_path.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (handle == INVALID_HANDLE_VALUE)
+			return Error(L"Error creating %s! %s", temp_path.c_str(), LastErrorToString(GetLastError()).c_str());
+		DWORD written;
+		if (!WriteFile(handle, &data[0], (DWORD)data.size(), &written, NULL) || written!=(DWORD)data.size())
+		{
+			handle.Close();
+			DeleteFile(temp_path.c_str());
+			return Error(L"Error writing %s!", temp_path.c_str());
+		}
+	}
+
+	if (!MoveFileEx(temp_path.c_str(), m_FilePath.c_str(), MOVEFILE_REPLACE_EXISTING))
+	{
+		DWORD last_error = GetLastError();
+		DeleteFile(temp_path.c_str());
+		return Error(L"Error moving \"%s\" to \"%s\"! %s", temp_path.c_str(), m_FilePath.c_str(), LastErrorToString(last_error).c_str());
+	}
+
+	m_Modified = false;
+	return true;
+}
+
+bool CFormatManifest::IsUpToDate(const wchar_t* filepath, const SFileStat& stat) const
+{
+	wstring key = GetKey(filepath);
+	SAutoLock lock(m_Lock);
+	TEntryMap::const_iterator it = m_Entries.find(key);
+	return it!=m_Entries.end() && it->second.stat==stat;
+}
+
+bool CFormatManifest::IsCanonicalData(const wchar_t* filepath, ULONGLONG size, ULONGLONG hash) const
+{
+	wstring key = GetKey(filepath);
+	SAutoLock lock(m_Lock);
+	TEntryMap::const_iterator it = m_Entries.find(key);
+	return it!=m_Entries.end() && it->second.stat.size==size && it->second.hash==hash;
+}
+
+void CFormatManifest::SetEntry(const wchar_t* filepath, const SFileStat& stat, ULONGLONG hash)
+{
+	wstring key = GetKey(filepath);
+	SAutoLock lock(m_Lock);
+	SEntry& entry = m_Entries[key];
+	entry.stat = stat;
+	entry.hash = hash;
+	m_Modified = true;
+}
+
+bool CFormatManifest::Error(const wchar_t* fmtstr, ...)
+{
+	if (!m_ErrorMessage.empty())
+		return false;
+	wchar_t buf[0x400];
+	va_list args;
+	va_start(args, fmtstr);
+	vswprintf(buf, sizeof(buf)/sizeof(buf[0]), fmtstr, args);
+	va_end(args);
+	m_ErrorMessage = buf;
+	return false;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+
+// The size and the last write time of a file, both retrieved by a single GetFileAttributesEx() call.
+struct SFileStat
+{
+	ULONGLONG size;
+	ULONGLONG last_write_time;
+
+	SFileStat() : size(0), last_write_time(0) {}
+	explicit SFileStat(const WIN32_FILE_ATTRIBUTE_DATA& data)
+		: size(((ULONGLONG)data.nFileSizeHigh << 32) | data.nFileSizeLow)
+		, last_write_time(((ULONGLONG)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime)
+	{}
+	explicit SFileStat(const BY_HANDLE_FILE_INFORMATION& info)
+		: size(((ULONGLONG)info.nFileSizeHigh << 32) | info.nFileSizeLow)
+		, last_write_time(((ULONGLONG)info.ftLastWriteTime.dwHighDateTime << 32) | info.ftLastWriteTime.dwLowDateTime)
+	{}
+	bool operator==(const SFileStat& other) const	{ return size==other.size && last_write_time==other.last_write_time; }
+	bool operator!=(const SFileStat& other) const	{ return !(*this == other); }
+};
+
+
+// Remembers the files that were written or found in canonical form by a previous run so they
+// can be skipped after a single stat if they haven't been modified since then. The methods that
+// query and update the entries can be called from the worker threads.
+class CFormatManifest
+{
+public:
+	CFormatManifest();
+
+	// A missing manifest file isn't an error, it is created by Save(). The options signature
+	// describes the formatting options: the canonical form of a file depends on them so the
+	// entries of a manifest that was saved with different options are dropped.
+	bool Load(const wchar_t* filepath, const wstring& options_signature);
+	// Saves the manifest to the file it was loaded from.
+	bool Save();
+	const wstring& GetErrorMessage() const				{ return m_ErrorMessage; }
+
+	// True if the file hasn't changed since it was last seen in canonical form.
+	bool IsUpToDate(const wchar_t* filepath, const SFileStat& stat) const;
+	// True if the file was touched but its contents are still the same canonical data.
+	bool IsCanonicalData(const wchar_t* filepath, ULONGLONG size, ULONGLONG hash) const;
+	void SetEntry(const wchar_t* filepath, const SFileStat& stat, ULONGLONG hash);
+
+	// The full path of the file, lowercase on Windows. Two spellings of a path have the same key.
+	static wstring GetKey(const wchar_t* filepath);
+
+private:
+	struct SEntry
+	{
+		SFileStat stat;
+		ULONGLONG hash;
+	};
+	typedef std::map<wstring,SEntry> TEntryMap;
+
+	void ParseLine(const wchar_t* line, const wchar_t* line_end);
+	bool Error(const wchar_t* fmtstr, ...);
+
+private:
+	wstring m_FilePath;
+	wstring m_OptionsSignature;
+	wstring m_ErrorMessage;
+
+	mutable CCriticalSection m_Lock;
+	// the keys are lowercase full paths
+	TEntryMap m_Entries;
+	bool m_Modified;
+};
@@ -0,0 +1,560 @@
+#include "stdafx.h"
+#include "MultiByteCodec.h"
+#include "UTF8.h"
+
+
+static const unsigned short UNDEFINED_CODE = 0xFFFF;
+// the linear index of the four byte GB18030 code of U+10000
+static const unsigned GB18030_SUPPLEMENTARY_BASE = 189000;
+static const unsigned GB18030_BMP_CODES = 39420;
+
+ILINE static bool IsEUCByte(unsigned b)
+{
+	return b>=0xA1 && b<=0xFE;
+}
+
+// Returns true if the two byte GBK code is a GB2312 code.
+ILINE static bool IsGB2312Code(unsigned b1, unsigned b2)
+{
+	if (b1<0xA1 || b1>0xF7 || !IsEUCByte(b2))
+		return false;
+	unsigned column = b2 - 0xA1;
+	return (GB2312_CODES[b1-0xA1][column/8] & (1 << (column&7))) != 0;
+}
+
+// The index of a two byte code in the tables that are indexed like GBK_TABLE, -1 if the
+// bytes are out of the range of the tables.
+ILINE static int GetGBKIndex(unsigned b1, unsigned b2)
+{
+	if (b1<0x81 || b1>0xFE || b2<0x40 || b2==0x7F || b2>0xFE)
+		return -1;
+	return (b1-0x81)*190 + b2 - (b2<0x7F ? 0x40 : 0x41);
+}
+
+// Returns the index of the last range of GB18030_RANGES that starts at or before value
+// in the specified column.
+static int FindGB18030Range(unsigned value, int column)
+{
+	int lo = 0;
+	int hi = GB18030_RANGE_COUNT;
+	while (hi-lo > 1)
+	{
+		int mid = (lo + hi) / 2;
+		if (GB18030_RANGES[mid][column] <= value)
+			lo = mid;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+// Returns the code point at s and sets len to the number of code units it takes.
+// Unpaired surrogates are returned as they are.
+ILINE static unsigned ReadChar(const wchar_t* s, const wchar_t* s_end, size_t& len)
+{
+	unsigned c = (unsigned)s[0];
+	len = 1;
+	if (c>=0xD800 && c<0xDC00 && s+1<s_end && ((unsigned)s[1]&~0x3FFu)==0xDC00)
+	{
+		len = 2;
+		return 0x10000 + ((c & 0x3FF) << 10) + ((unsigned)s[1] & 0x3FF);
+	}
+	return c;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+
+CMultiByteCodec::CMultiByteCodec(EType type)
+: m_Type(type)
+, m_DoubleByteTable(NULL)
+{
+	memset(m_PageIndex, 0, sizeof(m_PageIndex));
+	m_Pages.resize(0x100);
+	switch (type)
+	{
+	case eT_EUC_JP:
+		for (int i=0; i<94*94; ++i)
+			AddReverse(JIS0208_TABLE[i], (unsigned short)(((0xA1 + i/94) << 8) | (0xA1 + i%94)));
+		for (unsigned c=0xFF61; c<=0xFF9F; ++c)
+			AddReverse(c, (unsigned short)(0x8E00 | (c - 0xFF61 + 0xA1)));
+		for (int i=0; i<94*94; ++i)
+			AddReverse(JIS0212_TABLE[i], (unsigned short)(((0xA1 + i/94) << 8) | (0x21 + i%94)));
+		break;
+	case eT_EUC_KR:
+		for (int i=0; i<94*94; ++i)
+			AddReverse(KSC5601_TABLE[i], (unsigned short)(((0xA1 + i/94) << 8) | (0xA1 + i%94)));
+		break;
+	case eT_GB18030:
+		for (int i=0; i<126*190; ++i)
+		{
+			int trail = i % 190;
+			trail += trail<0x3F ? 0x40 : 0x41;
+			AddReverse(GBK_TABLE[i], (unsigned short)(((0x81 + i/190) << 8) | trail));
+		}
+		break;
+	case eT_HZ:
+		// only the GB2312 codes of the table
+		for (int lead=0xA1; lead<=0xF7; ++lead)
+		{
+			for (int trail=0xA1; trail<=0xFE; ++trail)
+			{
+				if (IsGB2312Code(lead, trail))
+					AddReverse(GBK_TABLE[(lead-0x81)*190 + trail-0x41], (unsigned short)((lead << 8) | trail));
+			}
+		}
+		break;
+	case eT_SHIFT_JIS:
+		m_DoubleByteTable = &CP932_TABLES;
+		break;
+	case eT_GBK:
+		m_DoubleByteTable = &CP936_TABLES;
+		break;
+	case eT_UHC:
+		m_DoubleByteTable = &CP949_TABLES;
+		break;
+	case eT_BIG5:
+		m_DoubleByteTable = &CP950_TABLES;
+		break;
+	default:
+		assert(0);
+	}
+	if (m_DoubleByteTable)
+		AddDoubleByteReverse();
+}
+
+void CMultiByteCodec::AddDoubleByteReverse()
+{
+	const SDoubleByteTable& table = *m_DoubleByteTable;
+	for (int b=0x80; b<0x100; ++b)
+		AddReverse(table.single_bytes[b-0x80], (unsigned short)b);
+	for (int i=0; i<126*190; ++i)
+	{
+		int trail = i % 190;
+		trail += trail<0x3F ? 0x40 : 0x41;
+		AddReverse(table.double_bytes[i], (unsigned short)(((0x81 + i/190) << 8) | trail));
+	}
+	for (int i=0; i<table.extra_encoding_count; ++i)
+		AddReverse(table.extra_encodings[i][0], table.extra_encodings[i][1], true);
+}
+
+void CMultiByteCodec::AddReverse(unsigned c, unsigned short code, bool replace)
+{
+	if (c == UNDEFINED_CODE)
+		return;
+	unsigned high = c >> 8;
+	if (!m_PageIndex[high])
+	{
+		m_PageIndex[high] = (unsigned short)(m_Pages.size() / 0x100);
+		m_Pages.resize(m_Pages.size() + 0x100);
+	}
+	unsigned short& entry = m_Pages[m_PageIndex[high]*0x100 + (c & 0xFF)];
+	// the first code wins if more codes are decoded to the same character
+	if (!entry || replace)
+		entry = code;
+}
+
+ILINE unsigned short CMultiByteCodec::FindReverse(unsigned c) const
+{
+	if (c >= 0x10000)
+		return 0;
+	return m_Pages[m_PageIndex[c >> 8]*0x100 + (c & 0xFF)];
+}
+
+size_t CMultiByteCodec::GetMaxByteCount(size_t utf16_chars) const
+{
+	switch (m_Type)
+	{
+	case eT_EUC_JP: return utf16_chars * 3;
+	case eT_EUC_KR: return utf16_chars * 2;
+	case eT_GB18030: return utf16_chars * 4;
+	case eT_SHIFT_JIS:
+	case eT_GBK:
+	case eT_UHC:
+	case eT_BIG5:
+		return utf16_chars * 2;
+	// a shift sequence and a character for every unit, and the final shift back to ASCII
+	default: return utf16_chars*4 + 2;
+	}
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// decoding
+//-------------------------------------------------------------------------------------------------
+
+
+const char* CMultiByteCodec::Validate(const char* s_begin, const char* s_end, size_t& utf16_length) const
+{
+	return DecodeText(s_begin, s_end, NULL, utf16_length);
+}
+
+const char* CMultiByteCodec::Decode(const char* s_begin, const char* s_end, wchar_t*& dst) const
+{
+	size_t utf16_length;
+	const char* invalid = DecodeText(s_begin, s_end, dst, utf16_length);
+	dst += utf16_length;
+	return invalid;
+}
+
+size_t CMultiByteCodec::DecodeSequence(const unsigned char* s, const unsigned char* s_end, unsigned& code) const
+{
+	unsigned b1 = s[0];
+	size_t size = s_end - s;
+	if (m_DoubleByteTable)
+	{
+		code = m_DoubleByteTable->single_bytes[b1-0x80];
+		if (code != UNDEFINED_CODE)
+			return 1;
+		int index = size<2 ? -1 : GetGBKIndex(b1, s[1]);
+		if (index < 0)
+			return 0;
+		code = m_DoubleByteTable->double_bytes[index];
+		return code==UNDEFINED_CODE ? 0 : 2;
+	}
+	if (m_Type == eT_GB18030)
+	{
+		if (b1<0x81 || b1>0xFE || size<2)
+			return 0;
+		unsigned b2 = s[1];
+		if (b2>=0x30 && b2<=0x39)
+		{
+			if (size<4 || s[2]<0x81 || s[2]>0xFE || s[3]<0x30 || s[3]>0x39)
+				return 0;
+			unsigned linear = (((b1-0x81)*10 + b2-0x30)*126 + s[2]-0x81)*10 + s[3]-0x30;
+			if (linear < GB18030_BMP_CODES)
+			{
+				int range = FindGB18030Range(linear, 0);
+				code = GB18030_RANGES[range][1] + linear - GB18030_RANGES[range][0];
+				return 4;
+			}
+			if (linear>=GB18030_SUPPLEMENTARY_BASE && linear<GB18030_SUPPLEMENTARY_BASE+0x100000)
+			{
+				code = 0x10000 + linear - GB18030_SUPPLEMENTARY_BASE;
+				return 4;
+			}
+			return 0;
+		}
+		int index = GetGBKIndex(b1, b2);
+		if (index < 0)
+			return 0;
+		code = GBK_TABLE[index];
+		return code==UNDEFINED_CODE ? 0 : 2;
+	}
+
+	const unsigned short* table = KSC5601_TABLE;
+	if (m_Type == eT_EUC_JP)
+	{
+		if (b1 == 0x8E)
+		{
+			// half width katakana
+			if (size<2 || s[1]<0xA1 || s[1]>0xDF)
+				return 0;
+			code = 0xFF61 + s[1] - 0xA1;
+			return 2;
+		}
+		if (b1 == 0x8F)
+		{
+			if (size<3 || !IsEUCByte(s[1]) || !IsEUCByte(s[2]))
+				return 0;
+			code = JIS0212_TABLE[(s[1]-0xA1)*94 + s[2]-0xA1];
+			return code==UNDEFINED_CODE ? 0 : 3;
+		}
+		table = JIS0208_TABLE;
+	}
+	if (size<2 || !IsEUCByte(b1) || !IsEUCByte(s[1]))
+		return 0;
+	code = table[(b1-0xA1)*94 + s[1]-0xA1];
+	return code==UNDEFINED_CODE ? 0 : 2;
+}
+
+const char* CMultiByteCodec::DecodeText(const char* s_begin, const char* s_end, wchar_t* dst, size_t& utf16_length) const
+{
+	if (m_Type == eT_HZ)
+		return DecodeHZ(s_begin, s_end, dst, utf16_length);
+
+	const unsigned char* s = (const unsigned char*)s_begin;
+	const unsigned char* e = (const unsigned char*)s_end;
+	size_t length = 0;
+	const char* invalid = s_end;
+	while (s < e)
+	{
+		size_t ascii = 0;
+		if (dst)
+			ascii = WidenASCII((const char*)s, s_end, dst+length);
+		else
+			while (s+ascii<e && s[ascii]<0x80) ++ascii;
+		s += ascii;
+		length += ascii;
+		if (s >= e)
+			break;
+
+		unsigned code;
+		size_t len = DecodeSequence(s, e, code);
+		if (!len)
+		{
+			invalid = (const char*)s;
+			break;
+		}
+		s += len;
+		if (code >= 0x10000)
+		{
+			if (dst)
+			{
+				code -= 0x10000;
+				dst[length] = (wchar_t)(0xD800 | (code >> 10));
+				dst[length+1] = (wchar_t)(0xDC00 | (code & 0x3FF));
+			}
+			length += 2;
+		}
+		else
+		{
+			if (dst)
+				dst[length] = (wchar_t)code;
+			++length;
+		}
+	}
+	utf16_length = length;
+	return invalid;
+}
+
+// RFC 1843: "~{" switches to GB2312 mode where the characters are written as two 7 bit bytes,
+// "~}" switches back to ASCII mode. In ASCII mode "~~" is '~' and "~\n" is a line continuation.
+const char* CMultiByteCodec::DecodeHZ(const char* s_begin, const char* s_end, wchar_t* dst, size_t& utf16_length) const
+{
+	const unsigned char* s = (const unsigned char*)s_begin;
+	const unsigned char* e = (const unsigned char*)s_end;
+	size_t length = 0;
+	bool gb_mode = false;
+	while (s < e)
+	{
+		unsigned c = s[0];
+		if (c == '~')
+		{
+			if (e-s < 2)
+				break;
+			unsigned c2 = s[1];
+			if (c2=='~' && !gb_mode)
+			{
+				if (dst)
+					dst[length] = L'~';
+				++length;
+			}
+			else if (c2=='{' && !gb_mode)
+			{
+				gb_mode = true;
+			}
+			else if (c2=='}' && gb_mode)
+			{
+				gb_mode = false;
+			}
+			else if (c2!='\n' || gb_mode)
+			{
+				break;
+			}
+			s += 2;
+			continue;
+		}
+		if (c >= 0x80)
+			break;
+		if (!gb_mode)
+		{
+			if (dst)
+				dst[length] = (wchar_t)c;
+			++length;
+			++s;
+			continue;
+		}
+		if (e-s<2 || s[1]>=0x80 || !IsGB2312Code(c|0x80, s[1]|0x80))
+			break;
+		unsigned short code = GBK_TABLE[((c|0x80)-0x81)*190 + (s[1]|0x80)-0x41];
+		if (dst)
+			dst[length] = (wchar_t)code;
+		++length;
+		s += 2;
+	}
+	utf16_length = length;
+	return (const char*)s;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// encoding
+//-------------------------------------------------------------------------------------------------
+
+
+size_t CMultiByteCodec::GetEncodedSize(const wchar_t* s_begin, const wchar_t* s_end) const
+{
+	return EncodeText(s_begin, s_end, NULL);
+}
+
+char* CMultiByteCodec::Encode(const wchar_t* s_begin, const wchar_t* s_end, char* dst) const
+{
+	return dst + EncodeText(s_begin, s_end, dst);
+}
+
+size_t CMultiByteCodec::EncodeChar(unsigned c, size_t len, unsigned char* dst) const
+{
+	unsigned short code = FindReverse(c);
+	if (code)
+	{
+		if (code < 0x100)
+		{
+			// a single byte of a double byte codepage
+			if (dst)
+				dst[0] = (unsigned char)code;
+			return 1;
+		}
+		if (m_Type==eT_EUC_JP && !(code & 0x80))
+		{
+			// JIS X 0212
+			if (dst)
+			{
+				dst[0] = 0x8F;
+				dst[1] = (unsigned char)(code >> 8);
+				dst[2] = (unsigned char)(code | 0x80);
+			}
+			return 3;
+		}
+		if (dst)
+		{
+			dst[0] = (unsigned char)(code >> 8);
+			dst[1] = (unsigned char)code;
+		}
+		return 2;
+	}
+
+	if (m_Type == eT_GB18030)
+	{
+		unsigned linear = 0xFFFFFFFF;
+		if (len == 2)
+		{
+			linear = GB18030_SUPPLEMENTARY_BASE + c - 0x10000;
+		}
+		else if (c<0xD800 || c>=0xE000)
+		{
+			int range = FindGB18030Range(c, 1);
+			unsigned offset = c - GB18030_RANGES[range][1];
+			unsigned range_end = range+1<GB18030_RANGE_COUNT ? GB18030_RANGES[range+1][0] : GB18030_BMP_CODES;
+			if (GB18030_RANGES[range][0]+offset < range_end)
+				linear = GB18030_RANGES[range][0] + offset;
+		}
+		if (linear != 0xFFFFFFFF)
+		{
+			if (dst)
+			{
+				dst[3] = (unsigned char)(0x30 + linear%10);
+				linear /= 10;
+				dst[2] = (unsigned char)(0x81 + linear%126);
+				linear /= 126;
+				dst[1] = (unsigned char)(0x30 + linear%10);
+				dst[0] = (unsigned char)(0x81 + linear/10);
+			}
+			return 4;
+		}
+	}
+
+	if (dst)
+		dst[0] = '?';
+	return 1;
+}
+
+size_t CMultiByteCodec::EncodeText(const wchar_t* s_begin, const wchar_t* s_end, char* dst) const
+{
+	if (m_Type == eT_HZ)
+		return EncodeHZ(s_begin, s_end, dst);
+
+	size_t size = 0;
+	const wchar_t* s = s_begin;
+	while (s < s_end)
+	{
+		size_t ascii = 0;
+		if (dst)
+			ascii = NarrowASCII(s, s_end, dst+size);
+		else
+			while (s+ascii<s_end && (unsigned)s[ascii]<0x80) ++ascii;
+		s += ascii;
+		size += ascii;
+		if (s >= s_end)
+			break;
+
+		size_t len;
+		unsigned c = ReadChar(s, s_end, len);
+		s += len;
+		size += EncodeChar(c, len, dst ? (unsigned char*)dst+size : NULL);
+	}
+	return size;
+}
+
+size_t CMultiByteCodec::EncodeHZ(const wchar_t* s_begin, const wchar_t* s_end, char* dst) const
+{
+	size_t size = 0;
+	bool gb_mode = false;
+	for (const wchar_t* s=s_begin; s<s_end; )
+	{
+		size_t len;
+		unsigned c = ReadChar(s, s_end, len);
+		s += len;
+		unsigned short code = c<0x80 ? 0 : FindReverse(c);
+		if (code && !gb_mode)
+		{
+			if (dst)
+			{
+				dst[size] = '~';
+				dst[size+1] = '{';
+			}
+			size += 2;
+			gb_mode = true;
+		}
+		else if (!code && gb_mode)
+		{
+			if (dst)
+			{
+				dst[size] = '~';
+				dst[size+1] = '}';
+			}
+			size += 2;
+			gb_mode = false;
+		}
+
+		if (code)
+		{
+			if (dst)
+			{
+				dst[size] = (char)((code >> 8) & 0x7F);
+				dst[size+1] = (char)(code & 0x7F);
+			}
+			size += 2;
+		}
+		else if (c < 0x80)
+		{
+			if (dst)
+				dst[size] = (char)c;
+			++size;
+			if (c == '~')
+			{
+				if (dst)
+					dst[size] = '~';
+				++size;
+			}
+		}
+		else
+		{
+			if (dst)
+				dst[size] = '?';
+			++size;
+		}
+	}
+	if (gb_mode)
+	{
+		if (dst)
+		{
+			dst[size] = '~';
+			dst[size+1] = '}';
+		}
+		size += 2;
+	}
+	return size;
+}
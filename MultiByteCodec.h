@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CodepageCodec.h"
+
+
+// The generated tables of MultiByteTables.cpp.
+extern const unsigned short JIS0208_TABLE[94*94];
+extern const unsigned short JIS0212_TABLE[94*94];
+extern const unsigned short KSC5601_TABLE[94*94];
+extern const unsigned short GBK_TABLE[126*190];
+static const int GB18030_RANGE_COUNT = 206;
+extern const unsigned short GB18030_RANGES[GB18030_RANGE_COUNT][2];
+extern const unsigned char GB2312_CODES[87][12];
+
+// The tables of a double byte Windows codepage.
+struct SDoubleByteTable
+{
+	// the bytes 0x80-0xFF, 0xFFFF for the lead bytes and the undefined bytes
+	const unsigned short* single_bytes;
+	// the two byte codes indexed like GBK_TABLE
+	const unsigned short* double_bytes;
+	// (character, code) pairs where the character isn't encoded to the first code that is
+	// decoded to it: the preferred codes of duplicates and the best fit codes
+	const unsigned short (*extra_encodings)[2];
+	int extra_encoding_count;
+};
+
+extern const SDoubleByteTable CP932_TABLES;
+extern const SDoubleByteTable CP936_TABLES;
+extern const SDoubleByteTable CP949_TABLES;
+extern const SDoubleByteTable CP950_TABLES;
+
+
+// Table driven conversion of the EUC-JP, EUC-KR, GB18030 and HZ codepages and the double byte
+// Windows codepages. The characters are decoded with the generated tables and encoded with a
+// two level reverse table built from them that is indexed by the high and the low byte of the
+// UTF-16 unit. The four byte codes of GB18030 are calculated from GB18030_RANGES. Runs of ASCII
+// are converted with the SSE2 helpers of UTF8.h except in HZ where '~' is an escape character.
+class CMultiByteCodec : public ICodepageCodec
+{
+public:
+	enum EType
+	{
+		eT_EUC_JP,
+		eT_EUC_KR,
+		eT_GB18030,
+		eT_HZ,
+		// the double byte Windows codepages 932, 936, 949 and 950
+		eT_SHIFT_JIS,
+		eT_GBK,
+		eT_UHC,
+		eT_BIG5,
+	};
+	CMultiByteCodec(EType type);
+
+	virtual const char* Validate(const char* s_begin, const char* s_end, size_t& utf16_length) const;
+	virtual const char* Decode(const char* s_begin, const char* s_end, wchar_t*& dst) const;
+	virtual size_t GetEncodedSize(const wchar_t* s_begin, const wchar_t* s_end) const;
+	virtual char* Encode(const wchar_t* s_begin, const wchar_t* s_end, char* dst) const;
+	virtual size_t GetMaxByteCount(size_t utf16_chars) const;
+
+private:
+	// Only counts the units if dst is NULL.
+	const char* DecodeText(const char* s_begin, const char* s_end, wchar_t* dst, size_t& utf16_length) const;
+	const char* DecodeHZ(const char* s_begin, const char* s_end, wchar_t* dst, size_t& utf16_length) const;
+	// Decodes the sequence of a non-ASCII lead byte. Returns its length, zero if it is invalid.
+	size_t DecodeSequence(const unsigned char* s, const unsigned char* s_end, unsigned& code) const;
+
+	// Only counts the bytes if dst is NULL. Returns the number of bytes.
+	size_t EncodeText(const wchar_t* s_begin, const wchar_t* s_end, char* dst) const;
+	size_t EncodeHZ(const wchar_t* s_begin, const wchar_t* s_end, char* dst) const;
+	// Encodes the non-ASCII character c that takes len code units, writes '?' if the codepage
+	// doesn't have it. dst may be NULL. Returns the number of bytes.
+	size_t EncodeChar(unsigned c, size_t len, unsigned char* dst) const;
+
+	// The first code of a character is kept unless replace is set.
+	void AddReverse(unsigned c, unsigned short code, bool replace=false);
+	void AddDoubleByteReverse();
+	// Returns 0 if the codepage doesn't have the character.
+	unsigned short FindReverse(unsigned c) const;
+
+private:
+	EType m_Type;
+	// NULL if the codepage isn't a double byte Windows codepage
+	const SDoubleByteTable* m_DoubleByteTable;
+	// page index of each high byte, page 0 is empty
+	unsigned short m_PageIndex[0x100];
+	// Two byte codes, the JIS X 0212 codes of EUC-JP are stored without the 0x8F
+	// prefix and with the top bit of their last byte cleared. The single bytes of the
+	// double byte codepages are below 0x100.
+	std::vector<unsigned short> m_Pages;
+};
@@ -0,0 +1,306 @@
+#include "stdafx.h"
+#include "ParallelTranscoder.h"
+#include "JobQueue.h"
+
+
+// A thread converts at least this many bytes or UTF-16 units at once.
+static const size_t MIN_CHUNK_SIZE = 0x40000;
+// Each thread gets about this many chunks so the threads finish at about the same time
+// even if the chunks take different times.
+static const size_t CHUNKS_PER_THREAD = 4;
+
+static int g_TranscodeThreadCount = 1;
+
+int GetTranscodeThreadCount()
+{
+	return g_TranscodeThreadCount;
+}
+
+void SetTranscodeThreadCount(int thread_count)
+{
+	assert(thread_count > 0);
+	g_TranscodeThreadCount = thread_count;
+}
+
+static size_t GetChunkSize(const IEncoding* encoding, const char* s, size_t size, size_t max_size)
+{
+	return encoding->GetDecodeChunkSize(s, size, max_size);
+}
+
+static size_t GetChunkSize(const IEncoding* encoding, const wchar_t* s, size_t size, size_t max_size)
+{
+	return encoding->GetEncodeChunkSize(s, size, max_size);
+}
+
+static LONGLONG Convert(const IEncoding* encoding, const char* s, size_t size, wchar_t* dst, size_t dst_size)
+{
+	return encoding->BytesToUTF16(s, size, dst, dst_size);
+}
+
+static LONGLONG Convert(const IEncoding* encoding, const wchar_t* s, size_t size, char* dst, size_t dst_size)
+{
+	return encoding->UTF16ToBytes(s, size, dst, dst_size);
+}
+
+static size_t GetMaxConvertedSize(const IEncoding* encoding, const char* s, size_t size)
+{
+	return encoding->GetMaxUTF16Chars(size);
+}
+
+static size_t GetMaxConvertedSize(const IEncoding* encoding, const wchar_t* s, size_t size)
+{
+	return encoding->GetMaxByteCount(size);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+
+struct ITranscodeJob
+{
+	// Called on the helper threads, converts chunks until there are none left.
+	virtual void Help() = 0;
+};
+
+// The helper threads of the conversions. They are started on first use and never stopped,
+// so a text doesn't pay for starting threads. The conversions that run at the same time share
+// the helpers.
+class CTranscodeThreadPool
+{
+public:
+	static CTranscodeThreadPool& GetInstance();
+
+	// Starts helpers up to thread_count, returns the number of helpers that are running.
+	int StartThreads(int thread_count);
+	// The job is passed to helper_count helpers, each calls job->Help() once.
+	void AddJob(ITranscodeJob* job, int helper_count);
+
+private:
+	CTranscodeThreadPool() : m_ThreadCount(0) {}
+	static unsigned __stdcall HelperThreadProc(void* param);
+
+private:
+	CCriticalSection m_Lock;
+	int m_ThreadCount;
+	CJobQueue<ITranscodeJob*> m_Jobs;
+};
+
+// Created on first use and never deleted, the helpers wait in its queue until the process exits.
+static CTranscodeThreadPool* volatile g_TranscodeThreadPool;
+static CCriticalSection g_TranscodeThreadPoolLock;
+
+CTranscodeThreadPool& CTranscodeThreadPool::GetInstance()
+{
+	CTranscodeThreadPool* pool = g_TranscodeThreadPool;
+	if (pool)
+		return *pool;
+	SAutoLock lock(g_TranscodeThreadPoolLock);
+	pool = g_TranscodeThreadPool;
+	if (!pool)
+	{
+		pool = new CTranscodeThreadPool;
+		// the object has to be complete before the other threads can see it
+		MemoryBarrier();
+		g_TranscodeThreadPool = pool;
+	}
+	return *pool;
+}
+
+int CTranscodeThreadPool::StartThreads(int thread_count)
+{
+	SAutoLock lock(m_Lock);
+	while (m_ThreadCount < thread_count)
+	{
+		HANDLE thread = (HANDLE)_beginthreadex(NULL, 0, HelperThreadProc, this, 0, NULL);
+		if (!thread)
+			break;
+		CloseHandle(thread);
+		++m_ThreadCount;
+	}
+	return min(thread_count, m_ThreadCount);
+}
+
+void CTranscodeThreadPool::AddJob(ITranscodeJob* job, int helper_count)
+{
+	for (int i=0; i<helper_count; ++i)
+		m_Jobs.Push(job);
+}
+
+unsigned __stdcall CTranscodeThreadPool::HelperThreadProc(void* param)
+{
+	CTranscodeThreadPool* pool = (CTranscodeThreadPool*)param;
+	ITranscodeJob* job = NULL;
+	while (pool->m_Jobs.Pop(job))
+		job->Help();
+	return 0;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+
+
+template <typename SrcType, typename DstType>
+class CParallelTranscoder : private ITranscodeJob
+{
+public:
+	CParallelTranscoder(const IEncoding* encoding, const SrcType* src, size_t src_size);
+
+	// DstContainer is a wstring or a vector<char>.
+	template <typename DstContainer>
+	bool Convert(DstContainer& dst);
+
+private:
+	struct SChunk
+	{
+		size_t src_offset;
+		size_t src_size;
+		// the place of the worst case size of the result in the destination
+		size_t dst_offset;
+		size_t dst_capacity;
+		size_t dst_size;
+	};
+	bool Split(int thread_count);
+	// Converts the chunks on the calling thread and on at most thread_count-1 helpers.
+	void Run(int thread_count);
+	virtual void Help();
+	void ConvertChunks();
+	void ConvertChunk(SChunk& chunk);
+
+private:
+	const IEncoding* m_Encoding;
+	const SrcType* m_Src;
+	size_t m_SrcSize;
+	std::vector<SChunk> m_Chunks;
+	DstType* m_Dst;
+	volatile LONG m_NextChunk;
+	volatile bool m_Failed;
+	// the number of helpers that haven't finished, the last one releases m_HelpersDone
+	volatile LONG m_PendingHelpers;
+	SWinHandle m_HelpersDone;
+};
+
+template <typename SrcType, typename DstType>
+CParallelTranscoder<SrcType,DstType>::CParallelTranscoder(const IEncoding* encoding, const SrcType* src, size_t src_size)
+: m_Encoding(encoding)
+, m_Src(src)
+, m_SrcSize(src_size)
+, m_Dst(NULL)
+, m_NextChunk(0)
+, m_Failed(false)
+, m_PendingHelpers(0)
+{
+}
+
+template <typename SrcType, typename DstType>
+bool CParallelTranscoder<SrcType,DstType>::Split(int thread_count)
+{
+	size_t max_size = max(MIN_CHUNK_SIZE, m_SrcSize/(thread_count*CHUNKS_PER_THREAD));
+	for (size_t pos=0; pos<m_SrcSize; )
+	{
+		size_t size = GetChunkSize(m_Encoding, m_Src+pos, m_SrcSize-pos, max_size);
+		if (!size)
+			return false;
+		SChunk chunk = { pos, size, 0, 0, 0 };
+		m_Chunks.push_back(chunk);
+		pos += size;
+	}
+	return m_Chunks.size() > 1;
+}
+
+template <typename SrcType, typename DstType>
+template <typename DstContainer>
+bool CParallelTranscoder<SrcType,DstType>::Convert(DstContainer& dst)
+{
+	int thread_count = GetTranscodeThreadCount();
+	if (thread_count<2 || m_SrcSize<MIN_CHUNK_SIZE*2 || !Split(thread_count))
+		return false;
+	thread_count = (int)min((size_t)thread_count, m_Chunks.size());
+
+	// Every chunk is converted once to a place of its worst case size, then the results are
+	// moved together. The destination is about as big as the buffer of a single pass conversion.
+	size_t dst_capacity = 0;
+	for (size_t i=0,e=m_Chunks.size(); i<e; ++i)
+	{
+		SChunk& chunk = m_Chunks[i];
+		chunk.dst_offset = dst_capacity;
+		chunk.dst_capacity = GetMaxConvertedSize(m_Encoding, m_Src+chunk.src_offset, chunk.src_size);
+		dst_capacity += chunk.dst_capacity;
+	}
+	dst.resize(dst_capacity);
+	if (!dst_capacity)
+		return true;
+	m_Dst = &dst[0];
+	Run(thread_count);
+	if (m_Failed)
+		return false;
+
+	size_t dst_size = 0;
+	for (size_t i=0,e=m_Chunks.size(); i<e; ++i)
+	{
+		const SChunk& chunk = m_Chunks[i];
+		if (chunk.dst_offset != dst_size)
+			memmove(m_Dst+dst_size, m_Dst+chunk.dst_offset, chunk.dst_size*sizeof(DstType));
+		dst_size += chunk.dst_size;
+	}
+	dst.resize(dst_size);
+	return true;
+}
+
+template <typename SrcType, typename DstType>
+void CParallelTranscoder<SrcType,DstType>::Run(int thread_count)
+{
+	m_NextChunk = -1;
+	// the calling thread does the work alone if the helpers can't be started
+	CTranscodeThreadPool& pool = CTranscodeThreadPool::GetInstance();
+	int helper_count = pool.StartThreads(thread_count-1);
+	if (helper_count)
+		m_HelpersDone = CreateSemaphore(NULL, 0, 1, NULL);
+	if (!m_HelpersDone)
+		helper_count = 0;
+	m_PendingHelpers = helper_count;
+	pool.AddJob(this, helper_count);
+	ConvertChunks();
+	if (helper_count)
+		WaitForSingleObject(m_HelpersDone, INFINITE);
+}
+
+template <typename SrcType, typename DstType>
+void CParallelTranscoder<SrcType,DstType>::Help()
+{
+	ConvertChunks();
+	if (!InterlockedDecrement(&m_PendingHelpers))
+		ReleaseSemaphore(m_HelpersDone, 1, NULL);
+}
+
+template <typename SrcType, typename DstType>
+void CParallelTranscoder<SrcType,DstType>::ConvertChunks()
+{
+	LONG chunk_count = (LONG)m_Chunks.size();
+	for (LONG i=InterlockedIncrement(&m_NextChunk); i<chunk_count && !m_Failed; i=InterlockedIncrement(&m_NextChunk))
+		ConvertChunk(m_Chunks[i]);
+}
+
+template <typename SrcType, typename DstType>
+void CParallelTranscoder<SrcType,DstType>::ConvertChunk(SChunk& chunk)
+{
+	if (!chunk.dst_capacity)
+		return;
+	// the buffer has the worst case size so the chunk is converted in a single pass
+	LONGLONG res = ::Convert(m_Encoding, m_Src+chunk.src_offset, chunk.src_size, m_Dst+chunk.dst_offset, chunk.dst_capacity);
+	if (res < 0)
+		m_Failed = true;
+	else
+		chunk.dst_size = (size_t)res;
+}
+
+bool ParallelDecodeToUTF16(const IEncoding* encoding, const char* bytes, size_t byte_count, wstring& utf16_str)
+{
+	CParallelTranscoder<char,wchar_t> transcoder(encoding, bytes, byte_count);
+	return transcoder.Convert(utf16_str);
+}
+
+bool ParallelEncodeFromUTF16(const IEncoding* encoding, const wchar_t* utf16le_str, size_t utf16_chars, std::vector<char>& bytes)
+{
+	CParallelTranscoder<wchar_t,char> transcoder(encoding, utf16le_str, utf16_chars);
+	return transcoder.Convert(bytes);
+}
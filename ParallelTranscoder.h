@@ -0,0 +1,18 @@
+#pragma once
+
+#include "XmlEncoding.h"
+
+
+// Converts big texts on several threads. The text is split into chunks at the boundaries of
+// IEncoding::GetDecodeChunkSize() or GetEncodeChunkSize(). The calling thread and the helpers of
+// a shared thread pool convert each chunk once to a place of its worst case size, then the
+// results are moved together at the offsets given by the prefix sums of their lengths.
+// Returns false if the text is too small or can't be split, or if the conversion fails. The
+// caller converts the text on its own thread in these cases, which also reports the error.
+bool ParallelDecodeToUTF16(const IEncoding* encoding, const char* bytes, size_t byte_count, wstring& utf16_str);
+bool ParallelEncodeFromUTF16(const IEncoding* encoding, const wchar_t* utf16le_str, size_t utf16_chars, std::vector<char>& bytes);
+
+// The number of threads of the parallel conversion, 1 if the texts are never split. The default
+// is 1: the parallel conversion pays off only if the other processors are idle.
+int GetTranscodeThreadCount();
+void SetTranscodeThreadCount(int thread_count);
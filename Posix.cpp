@@ -0,0 +1,1477 @@
+#include "stdafx.h"
+
+#ifndef _WIN32
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <iconv.h>
+#include <locale.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/sysmacros.h>
+#endif
+
+// this file calls the C library functions
+#undef swprintf
+#undef vswprintf
+#undef wprintf
+#undef vwprintf
+#undef fwprintf
+#undef vfwprintf
+
+
+//-------------------------------------------------------------------------------------------------
+// UTF-8 <-> UTF-16
+//-------------------------------------------------------------------------------------------------
+
+
+static const wchar_t REPLACEMENT_CHAR = 0xFFFD;
+
+// Returns the number of UTF-16 units, or -1 on an invalid sequence if invalid_is_error is true.
+// The destination can be NULL to count the units.
+static LONGLONG DecodeUTF8(const unsigned char* s, size_t len, wchar_t* dst, bool invalid_is_error)
+{
+	size_t count = 0;
+	for (size_t i=0; i<len; )
+	{
+		unsigned c = s[i];
+		if (c < 0x80)
+		{
+			if (dst)
+				dst[count] = (wchar_t)c;
+			++count;
+			++i;
+			continue;
+		}
+
+		int trail;
+		unsigned min_code;
+		if (c>=0xC2 && c<0xE0)
+		{
+			trail = 1;
+			min_code = 0x80;
+			c &= 0x1F;
+		}
+		else if (c>=0xE0 && c<0xF0)
+		{
+			trail = 2;
+			min_code = 0x800;
+			c &= 0x0F;
+		}
+		else if (c>=0xF0 && c<0xF5)
+		{
+			trail = 3;
+			min_code = 0x10000;
+			c &= 0x07;
+		}
+		else
+		{
+			trail = -1;
+		}
+
+		bool valid = trail>0 && i+trail<len+1;
+		for (int k=1; valid && k<=trail; ++k)
+		{
+			if (i+k>=len || (s[i+k]&0xC0)!=0x80)
+				valid = false;
+			else
+				c = (c << 6) | (s[i+k] & 0x3F);
+		}
+		// overlong forms, encoded surrogates and codes above U+10FFFF
+		if (valid && (c<min_code || (c>=0xD800 && c<0xE000) || c>0x10FFFF))
+			valid = false;
+
+		if (!valid)
+		{
+			if (invalid_is_error)
+				return -1;
+			if (dst)
+				dst[count] = REPLACEMENT_CHAR;
+			++count;
+			++i;
+			continue;
+		}
+
+		if (c >= 0x10000)
+		{
+			if (dst)
+			{
+				dst[count] = (wchar_t)(0xD800 | ((c-0x10000) >> 10));
+				dst[count+1] = (wchar_t)(0xDC00 | (c & 0x3FF));
+			}
+			count += 2;
+		}
+		else
+		{
+			if (dst)
+				dst[count] = (wchar_t)c;
+			++count;
+		}
+		i += trail + 1;
+	}
+	return (LONGLONG)count;
+}
+
+// Returns the number of bytes. Unpaired surrogates are encoded as U+FFFD like on Windows.
+// The destination can be NULL to count the bytes.
+static size_t EncodeUTF8(const wchar_t* s, size_t len, unsigned char* dst)
+{
+	size_t count = 0;
+	for (size_t i=0; i<len; ++i)
+	{
+		unsigned c = (unsigned)s[i] & 0xFFFF;
+		if (c>=0xD800 && c<0xE000)
+		{
+			if (c<0xDC00 && i+1<len && ((unsigned)s[i+1]&0xFFFF)>=0xDC00 && ((unsigned)s[i+1]&0xFFFF)<0xE000)
+			{
+				c = 0x10000 + ((c & 0x3FF) << 10) + ((unsigned)s[i+1] & 0x3FF);
+				++i;
+			}
+			else
+			{
+				c = REPLACEMENT_CHAR;
+			}
+		}
+
+		if (c < 0x80)
+		{
+			if (dst)
+				dst[count] = (unsigned char)c;
+			count += 1;
+		}
+		else if (c < 0x800)
+		{
+			if (dst)
+			{
+				dst[count] = (unsigned char)(0xC0 | (c >> 6));
+				dst[count+1] = (unsigned char)(0x80 | (c & 0x3F));
+			}
+			count += 2;
+		}
+		else if (c < 0x10000)
+		{
+			if (dst)
+			{
+				dst[count] = (unsigned char)(0xE0 | (c >> 12));
+				dst[count+1] = (unsigned char)(0x80 | ((c >> 6) & 0x3F));
+				dst[count+2] = (unsigned char)(0x80 | (c & 0x3F));
+			}
+			count += 3;
+		}
+		else
+		{
+			if (dst)
+			{
+				dst[count] = (unsigned char)(0xF0 | (c >> 18));
+				dst[count+1] = (unsigned char)(0x80 | ((c >> 12) & 0x3F));
+				dst[count+2] = (unsigned char)(0x80 | ((c >> 6) & 0x3F));
+				dst[count+3] = (unsigned char)(0x80 | (c & 0x3F));
+			}
+			count += 4;
+		}
+	}
+	return count;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// paths
+//-------------------------------------------------------------------------------------------------
+
+
+// The bytes of a file name that aren't valid UTF-8 are passed through as U+DC80..U+DCFF,
+// so every file can be opened with the name returned by FindNextFile().
+std::string ToNativePath(const wchar_t* path)
+{
+	std::string s;
+	for (; *path; ++path)
+	{
+		unsigned c = (unsigned)*path & 0xFFFF;
+		if (c == L'\\')
+		{
+			s.push_back('/');
+		}
+		else if (c>=0xDC80 && c<0xDD00 && (path[1]==0 || ((unsigned)path[1]&0xFFFF)<0xDC00 || ((unsigned)path[1]&0xFFFF)>=0xE000))
+		{
+			// a lone low surrogate is an undecodable byte, a pair is encoded normally
+			s.push_back((char)(c & 0xFF));
+		}
+		else
+		{
+			size_t len = wcslen(path) > 1 && c>=0xD800 && c<0xDC00 ? 2 : 1;
+			unsigned char buf[4];
+			size_t n = EncodeUTF8(path, len, buf);
+			s.append((const char*)buf, n);
+			path += len - 1;
+		}
+	}
+	return s;
+}
+
+wstring FromNativePath(const char* path)
+{
+	wstring s;
+	const unsigned char* p = (const unsigned char*)path;
+	size_t len = strlen(path);
+	for (size_t i=0; i<len; )
+	{
+		// decoding one character at a time to find the invalid bytes
+		size_t n = 1;
+		if (p[i] >= 0xC0)
+		{
+			while (i+n<len && n<4 && (p[i+n]&0xC0)==0x80)
+				++n;
+		}
+		wchar_t w[2];
+		LONGLONG res = DecodeUTF8(p+i, n, w, true);
+		if (res > 0)
+		{
+			s.append(w, (size_t)res);
+			i += n;
+		}
+		else
+		{
+			s.push_back((wchar_t)(0xDC00 | p[i]));
+			++i;
+		}
+	}
+	return s;
+}
+
+static void SplitPattern(const wchar_t* path, wstring& dir, wstring& name)
+{
+	const wchar_t* slash = max(wcsrchr(path, L'/'), wcsrchr(path, L'\\'));
+	if (slash)
+	{
+		dir.assign(path, slash+1);
+		name = slash + 1;
+	}
+	else
+	{
+		dir.clear();
+		name = path;
+	}
+}
+
+static FILETIME ToFileTime(const struct timespec& t)
+{
+	// seconds between 1601-01-01 and 1970-01-01
+	ULONGLONG time = ((ULONGLONG)t.tv_sec + 11644473600ULL) * 10000000 + (ULONGLONG)t.tv_nsec / 100;
+	FILETIME ft;
+	ft.dwLowDateTime = (DWORD)time;
+	ft.dwHighDateTime = (DWORD)(time >> 32);
+	return ft;
+}
+
+static DWORD ToFileAttributes(mode_t mode)
+{
+	DWORD attributes = 0;
+	if (S_ISDIR(mode))
+		attributes |= FILE_ATTRIBUTE_DIRECTORY;
+	if (!(mode & S_IWUSR))
+		attributes |= FILE_ATTRIBUTE_READONLY;
+	return attributes ? attributes : FILE_ATTRIBUTE_NORMAL;
+}
+
+static DWORD ToFileAttributes(const struct stat& st)
+{
+	return ToFileAttributes(st.st_mode);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// handles
+//-------------------------------------------------------------------------------------------------
+
+
+struct SPosixHandle
+{
+	virtual ~SPosixHandle() {}
+	virtual bool Wait()					{ errno = EINVAL; return false; }
+	// Returns false if the handle isn't signaled or can't be polled.
+	virtual bool TryWait()				{ errno = EINVAL; return false; }
+};
+
+struct SPosixFile : public SPosixHandle
+{
+	int fd;
+	bool regular;
+	bool owned;
+
+	SPosixFile(int _fd, bool _owned) : fd(_fd), regular(false), owned(_owned)
+	{
+		struct stat st;
+		regular = fstat(fd, &st)==0 && S_ISREG(st.st_mode);
+	}
+	~SPosixFile()
+	{
+		if (owned)
+			close(fd);
+	}
+};
+
+struct SPosixThread : public SPosixHandle
+{
+	pthread_t thread;
+	bool joined;
+	unsigned (*start_address)(void*);
+	void* arglist;
+
+	SPosixThread() : joined(false) {}
+	~SPosixThread()
+	{
+		if (!joined)
+			pthread_detach(thread);
+	}
+	virtual bool Wait()
+	{
+		if (!joined)
+		{
+			pthread_join(thread, NULL);
+			joined = true;
+		}
+		return true;
+	}
+	static void* ThreadProc(void* param)
+	{
+		SPosixThread* t = (SPosixThread*)param;
+		t->start_address(t->arglist);
+		return NULL;
+	}
+};
+
+struct SPosixSemaphore : public SPosixHandle
+{
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	LONG count;
+	LONG maximum;
+
+	SPosixSemaphore(LONG initial_count, LONG maximum_count) : count(initial_count), maximum(maximum_count)
+	{
+		pthread_mutex_init(&mutex, NULL);
+		pthread_cond_init(&cond, NULL);
+	}
+	~SPosixSemaphore()
+	{
+		pthread_cond_destroy(&cond);
+		pthread_mutex_destroy(&mutex);
+	}
+	virtual bool Wait()
+	{
+		pthread_mutex_lock(&mutex);
+		while (!count)
+			pthread_cond_wait(&cond, &mutex);
+		--count;
+		pthread_mutex_unlock(&mutex);
+		return true;
+	}
+	virtual bool TryWait()
+	{
+		pthread_mutex_lock(&mutex);
+		bool signaled = count > 0;
+		if (signaled)
+			--count;
+		pthread_mutex_unlock(&mutex);
+		errno = 0;
+		return signaled;
+	}
+	bool Release(LONG release_count, LONG* previous_count)
+	{
+		pthread_mutex_lock(&mutex);
+		bool ok = release_count>0 && count<=maximum-release_count;
+		if (previous_count)
+			*previous_count = count;
+		if (ok)
+			count += release_count;
+		pthread_mutex_unlock(&mutex);
+		if (!ok)
+		{
+			errno = EINVAL;
+			return false;
+		}
+		for (LONG i=0; i<release_count; ++i)
+			pthread_cond_signal(&cond);
+		return true;
+	}
+};
+
+struct SPosixEvent : public SPosixHandle
+{
+	// The read end of the pipe is readable while the event is set, the bytes are never read.
+	int fds[2];
+
+	SPosixEvent()
+	{
+		fds[0] = fds[1] = -1;
+	}
+	~SPosixEvent()
+	{
+		for (int i=0; i<2; ++i)
+		{
+			if (fds[i] >= 0)
+				close(fds[i]);
+		}
+	}
+	virtual bool Wait()
+	{
+		struct pollfd pfd = { fds[0], POLLIN, 0 };
+		while (poll(&pfd, 1, -1) < 0)
+		{
+			if (errno != EINTR)
+				return false;
+		}
+		return true;
+	}
+};
+
+struct SPosixFind : public SPosixHandle
+{
+	DIR* dir;
+	wstring pattern;
+	// set if the pattern has no wildcards and the single entry has been returned
+	bool single;
+
+	SPosixFind() : dir(NULL), single(false) {}
+	~SPosixFind()
+	{
+		if (dir)
+			closedir(dir);
+	}
+};
+
+static SPosixHandle* ToPosixHandle(HANDLE handle)
+{
+	if (!handle || handle==INVALID_HANDLE_VALUE)
+		return NULL;
+	return (SPosixHandle*)handle;
+}
+
+static SPosixFile* ToPosixFile(HANDLE handle)
+{
+	SPosixFile* file = dynamic_cast<SPosixFile*>(ToPosixHandle(handle));
+	if (!file)
+		errno = EBADF;
+	return file;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// synchronization and threads
+//-------------------------------------------------------------------------------------------------
+
+
+void InitializeCriticalSection(CRITICAL_SECTION* cs)
+{
+	// the Windows critical sections are recursive
+	pthread_mutexattr_t attr;
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(cs, &attr);
+	pthread_mutexattr_destroy(&attr);
+}
+
+uintptr_t _beginthreadex(void* security, unsigned stack_size, unsigned (*start_address)(void*),
+						 void* arglist, unsigned initflag, unsigned* thrdaddr)
+{
+	SPosixThread* t = new SPosixThread;
+	t->start_address = start_address;
+	t->arglist = arglist;
+	int res = pthread_create(&t->thread, NULL, SPosixThread::ThreadProc, t);
+	if (res)
+	{
+		t->joined = true;
+		delete t;
+		errno = res;
+		return 0;
+	}
+	return (uintptr_t)(SPosixHandle*)t;
+}
+
+HANDLE CreateSemaphore(void* attributes, LONG initial_count, LONG maximum_count, const wchar_t* name)
+{
+	return (SPosixHandle*)new SPosixSemaphore(initial_count, maximum_count);
+}
+
+BOOL ReleaseSemaphore(HANDLE semaphore, LONG release_count, LONG* previous_count)
+{
+	SPosixSemaphore* s = dynamic_cast<SPosixSemaphore*>(ToPosixHandle(semaphore));
+	if (!s)
+	{
+		errno = EBADF;
+		return FALSE;
+	}
+	return s->Release(release_count, previous_count);
+}
+
+HANDLE CreateEvent(void* attributes, BOOL manual_reset, BOOL initial_state, const wchar_t* name)
+{
+	assert(manual_reset);
+	SPosixEvent* e = new SPosixEvent;
+	if (pipe(e->fds))
+	{
+		delete e;
+		return NULL;
+	}
+	for (int i=0; i<2; ++i)
+	{
+		fcntl(e->fds[i], F_SETFD, FD_CLOEXEC);
+		fcntl(e->fds[i], F_SETFL, O_NONBLOCK);
+	}
+	if (initial_state)
+		SetEvent((SPosixHandle*)e);
+	return (SPosixHandle*)e;
+}
+
+BOOL SetEvent(HANDLE event)
+{
+	SPosixEvent* e = dynamic_cast<SPosixEvent*>(ToPosixHandle(event));
+	if (!e)
+	{
+		errno = EBADF;
+		return FALSE;
+	}
+	// a full pipe means the event is already set
+	char c = 1;
+	return write(e->fds[1], &c, 1)==1 || errno==EAGAIN;
+}
+
+int GetEventDescriptor(HANDLE event)
+{
+	SPosixEvent* e = dynamic_cast<SPosixEvent*>(ToPosixHandle(event));
+	return e ? e->fds[0] : -1;
+}
+
+DWORD WaitForSingleObject(HANDLE handle, DWORD milliseconds)
+{
+	assert(milliseconds==INFINITE || milliseconds==0);
+	SPosixHandle* h = ToPosixHandle(handle);
+	if (!h)
+		return WAIT_FAILED;
+	if (!milliseconds)
+	{
+		if (h->TryWait())
+			return WAIT_OBJECT_0;
+		return errno ? WAIT_FAILED : WAIT_TIMEOUT;
+	}
+	return h->Wait() ? WAIT_OBJECT_0 : WAIT_FAILED;
+}
+
+BOOL CloseHandle(HANDLE handle)
+{
+	SPosixHandle* h = ToPosixHandle(handle);
+	if (!h)
+	{
+		errno = EBADF;
+		return FALSE;
+	}
+	delete h;
+	return TRUE;
+}
+
+void GetSystemInfo(SYSTEM_INFO* system_info)
+{
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	system_info->dwNumberOfProcessors = count>0 ? (DWORD)count : 1;
+}
+
+// The write end of the pipe of the event set by SIGINT and SIGTERM, -1 if there is none.
+// Only write() is async-signal-safe, so the handler doesn't look at the event itself.
+static volatile sig_atomic_t g_ConsoleCtrlDescriptor = -1;
+
+static void ConsoleSignalHandler(int signal)
+{
+	int saved_errno = errno;
+	int fd = g_ConsoleCtrlDescriptor;
+	if (fd >= 0)
+	{
+		// a full pipe means the event is already set
+		char c = 1;
+		ssize_t res = write(fd, &c, 1);
+		(void)res;
+	}
+	errno = saved_errno;
+}
+
+BOOL SetConsoleCtrlEvent(HANDLE event, BOOL add)
+{
+	struct sigaction action;
+	memset(&action, 0, sizeof(action));
+	sigemptyset(&action.sa_mask);
+	if (!add)
+	{
+		action.sa_handler = SIG_DFL;
+		BOOL res = !sigaction(SIGINT, &action, NULL) && !sigaction(SIGTERM, &action, NULL);
+		g_ConsoleCtrlDescriptor = -1;
+		return res;
+	}
+	SPosixEvent* e = dynamic_cast<SPosixEvent*>(ToPosixHandle(event));
+	if (!e)
+	{
+		errno = EBADF;
+		return FALSE;
+	}
+	g_ConsoleCtrlDescriptor = e->fds[1];
+	action.sa_handler = ConsoleSignalHandler;
+	return !sigaction(SIGINT, &action, NULL) && !sigaction(SIGTERM, &action, NULL);
+}
+
+DWORD GetTickCount()
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (DWORD)((ULONGLONG)t.tv_sec*1000 + t.tv_nsec/1000000);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// files
+//-------------------------------------------------------------------------------------------------
+
+
+HANDLE CreateFile(const wchar_t* filename, DWORD desired_access, DWORD share_mode, void* security_attributes,
+				  DWORD creation_disposition, DWORD flags_and_attributes, HANDLE template_file)
+{
+	std::string path = ToNativePath(filename);
+	int fd;
+	if (flags_and_attributes & FILE_FLAG_BACKUP_SEMANTICS)
+	{
+		// directories are opened only for flushing
+		fd = open(path.c_str(), O_RDONLY|O_CLOEXEC);
+	}
+	else if (desired_access==GENERIC_READ && creation_disposition==OPEN_EXISTING)
+	{
+		fd = open(path.c_str(), O_RDONLY|O_CLOEXEC);
+#ifdef POSIX_FADV_SEQUENTIAL
+		if (fd>=0 && (flags_and_attributes & FILE_FLAG_SEQUENTIAL_SCAN))
+			posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+	}
+	else if (desired_access==GENERIC_WRITE && creation_disposition==CREATE_ALWAYS)
+	{
+		mode_t mode = (flags_and_attributes & FILE_ATTRIBUTE_READONLY) ? 0444 : 0666;
+		fd = open(path.c_str(), O_WRONLY|O_CREAT|O_TRUNC|O_CLOEXEC, mode);
+	}
+	else
+	{
+		assert(0);
+		errno = EINVAL;
+		return INVALID_HANDLE_VALUE;
+	}
+	if (fd < 0)
+		return INVALID_HANDLE_VALUE;
+	return (SPosixHandle*)new SPosixFile(fd, true);
+}
+
+BOOL ReadFile(HANDLE file, void* buffer, DWORD bytes_to_read, DWORD* bytes_read, void* overlapped)
+{
+	assert(!overlapped);
+	*bytes_read = 0;
+	SPosixFile* f = ToPosixFile(file);
+	if (!f)
+		return FALSE;
+	char* p = (char*)buffer;
+	while (*bytes_read < bytes_to_read)
+	{
+		ssize_t res = read(f->fd, p + *bytes_read, bytes_to_read - *bytes_read);
+		if (res < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return FALSE;
+		}
+		*bytes_read += (DWORD)res;
+		// pipes return what is available, regular files are read until the end
+		if (!res || !f->regular)
+			break;
+	}
+	return TRUE;
+}
+
+BOOL WriteFile(HANDLE file, const void* buffer, DWORD bytes_to_write, DWORD* bytes_written, void* overlapped)
+{
+	assert(!overlapped);
+	*bytes_written = 0;
+	SPosixFile* f = ToPosixFile(file);
+	if (!f)
+		return FALSE;
+	const char* p = (const char*)buffer;
+	while (*bytes_written < bytes_to_write)
+	{
+		ssize_t res = write(f->fd, p + *bytes_written, bytes_to_write - *bytes_written);
+		if (res < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return FALSE;
+		}
+		*bytes_written += (DWORD)res;
+	}
+	return TRUE;
+}
+
+BOOL GetFileSizeEx(HANDLE file, LARGE_INTEGER* file_size)
+{
+	SPosixFile* f = ToPosixFile(file);
+	struct stat st;
+	if (!f || fstat(f->fd, &st))
+		return FALSE;
+	file_size->QuadPart = (LONGLONG)st.st_size;
+	return TRUE;
+}
+
+BOOL GetFileInformationByHandle(HANDLE file, BY_HANDLE_FILE_INFORMATION* file_information)
+{
+	SPosixFile* f = ToPosixFile(file);
+	struct stat st;
+	if (!f || fstat(f->fd, &st))
+		return FALSE;
+	file_information->dwFileAttributes = ToFileAttributes(st);
+	file_information->ftCreationTime = ToFileTime(st.st_ctim);
+	file_information->ftLastAccessTime = ToFileTime(st.st_atim);
+	file_information->ftLastWriteTime = ToFileTime(st.st_mtim);
+	file_information->dwVolumeSerialNumber = (DWORD)st.st_dev;
+	file_information->nFileSizeHigh = (DWORD)((ULONGLONG)st.st_size >> 32);
+	file_information->nFileSizeLow = (DWORD)st.st_size;
+	file_information->nNumberOfLinks = (DWORD)st.st_nlink;
+	file_information->nFileIndexHigh = (DWORD)((ULONGLONG)st.st_ino >> 32);
+	file_information->nFileIndexLow = (DWORD)st.st_ino;
+	return TRUE;
+}
+
+#ifdef __linux__
+void GetFileInformationFromStatx(const struct statx& stx, BY_HANDLE_FILE_INFORMATION* file_information)
+{
+	struct timespec t;
+	file_information->dwFileAttributes = ToFileAttributes((mode_t)stx.stx_mode);
+	t.tv_sec = stx.stx_ctime.tv_sec;
+	t.tv_nsec = stx.stx_ctime.tv_nsec;
+	file_information->ftCreationTime = ToFileTime(t);
+	t.tv_sec = stx.stx_atime.tv_sec;
+	t.tv_nsec = stx.stx_atime.tv_nsec;
+	file_information->ftLastAccessTime = ToFileTime(t);
+	t.tv_sec = stx.stx_mtime.tv_sec;
+	t.tv_nsec = stx.stx_mtime.tv_nsec;
+	file_information->ftLastWriteTime = ToFileTime(t);
+	file_information->dwVolumeSerialNumber = (DWORD)makedev(stx.stx_dev_major, stx.stx_dev_minor);
+	file_information->nFileSizeHigh = (DWORD)(stx.stx_size >> 32);
+	file_information->nFileSizeLow = (DWORD)stx.stx_size;
+	file_information->nNumberOfLinks = (DWORD)stx.stx_nlink;
+	file_information->nFileIndexHigh = (DWORD)(stx.stx_ino >> 32);
+	file_information->nFileIndexLow = (DWORD)stx.stx_ino;
+}
+#endif
+
+BOOL FlushFileBuffers(HANDLE file)
+{
+	SPosixFile* f = ToPosixFile(file);
+	return f && !fsync(f->fd);
+}
+
+HANDLE GetStdHandle(DWORD std_handle)
+{
+	static SPosixFile std_input(0, false);
+	static SPosixFile std_output(1, false);
+	static SPosixFile std_error(2, false);
+	switch (std_handle)
+	{
+	case STD_INPUT_HANDLE: return (SPosixHandle*)&std_input;
+	case STD_OUTPUT_HANDLE: return (SPosixHandle*)&std_output;
+	case STD_ERROR_HANDLE: return (SPosixHandle*)&std_error;
+	default: errno = EINVAL; return INVALID_HANDLE_VALUE;
+	}
+}
+
+int GetFileDescriptor(HANDLE file)
+{
+	SPosixFile* f = ToPosixFile(file);
+	return f ? f->fd : -1;
+}
+
+BOOL GetFileAttributesEx(const wchar_t* filename, GET_FILEEX_INFO_LEVELS info_level, void* file_information)
+{
+	assert(info_level == GetFileExInfoStandard);
+	struct stat st;
+	if (stat(ToNativePath(filename).c_str(), &st))
+		return FALSE;
+	WIN32_FILE_ATTRIBUTE_DATA* data = (WIN32_FILE_ATTRIBUTE_DATA*)file_information;
+	data->dwFileAttributes = ToFileAttributes(st);
+	data->ftCreationTime = ToFileTime(st.st_ctim);
+	data->ftLastAccessTime = ToFileTime(st.st_atim);
+	data->ftLastWriteTime = ToFileTime(st.st_mtim);
+	data->nFileSizeHigh = (DWORD)((ULONGLONG)st.st_size >> 32);
+	data->nFileSizeLow = (DWORD)st.st_size;
+	return TRUE;
+}
+
+BOOL MoveFileEx(const wchar_t* existing_filename, const wchar_t* new_filename, DWORD flags)
+{
+	assert(flags == MOVEFILE_REPLACE_EXISTING);
+	return !rename(ToNativePath(existing_filename).c_str(), ToNativePath(new_filename).c_str());
+}
+
+BOOL DeleteFile(const wchar_t* filename)
+{
+	return !unlink(ToNativePath(filename).c_str());
+}
+
+DWORD GetFullPathName(const wchar_t* filename, DWORD buffer_length, wchar_t* buffer, wchar_t** file_part)
+{
+	assert(!file_part);
+	wstring path;
+	if (filename[0]!=L'/' && filename[0]!=L'\\')
+	{
+		char cwd[4096];
+		if (!getcwd(cwd, sizeof(cwd)))
+			return 0;
+		path = FromNativePath(cwd);
+		path.push_back(L'/');
+	}
+	path.append(filename);
+
+	// removing the . and .. components like Windows does
+	std::vector<wstring> components;
+	wstring component;
+	for (size_t i=0,e=path.size(); i<=e; ++i)
+	{
+		if (i<e && path[i]!=L'/' && path[i]!=L'\\')
+		{
+			component.push_back(path[i]);
+			continue;
+		}
+		if (component == L"..")
+		{
+			if (!components.empty())
+				components.pop_back();
+		}
+		else if (!component.empty() && component!=L".")
+		{
+			components.push_back(component);
+		}
+		component.clear();
+	}
+	wstring full_path;
+	for (size_t i=0,e=components.size(); i<e; ++i)
+	{
+		full_path.push_back(L'/');
+		full_path.append(components[i]);
+	}
+	if (full_path.empty())
+		full_path = L"/";
+
+	if (full_path.size() >= buffer_length)
+		return (DWORD)full_path.size() + 1;
+	wcscpy(buffer, full_path.c_str());
+	return (DWORD)full_path.size();
+}
+
+static std::string g_ModuleFileName;
+
+DWORD GetModuleFileName(HANDLE module, wchar_t* filename, DWORD size)
+{
+	assert(!module);
+	wstring name = FromNativePath(g_ModuleFileName.c_str());
+	if (!size)
+		return 0;
+	DWORD len = (DWORD)min(name.size(), (size_t)size-1);
+	wmemcpy(filename, name.data(), len);
+	filename[len] = 0;
+	return len;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// directory listing
+//-------------------------------------------------------------------------------------------------
+
+
+static bool WildcardMatchNoCase(const wchar_t* pattern, const wchar_t* name)
+{
+	const wchar_t* star = NULL;
+	const wchar_t* star_name = NULL;
+	while (*name)
+	{
+		if (*pattern == L'*')
+		{
+			star = ++pattern;
+			star_name = name;
+		}
+		else if (*pattern==L'?' || (*pattern && towlower(*pattern)==towlower(*name)))
+		{
+			++pattern;
+			++name;
+		}
+		else if (star)
+		{
+			pattern = star;
+			name = ++star_name;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	while (*pattern == L'*')
+		++pattern;
+	return !*pattern;
+}
+
+static bool SetFindData(const wstring& name, DWORD attributes, WIN32_FIND_DATA* find_data)
+{
+	if (name.size() >= MAX_PATH)
+		return false;
+	wmemcpy(find_data->cFileName, name.c_str(), name.size()+1);
+	find_data->dwFileAttributes = attributes;
+	return true;
+}
+
+// The type in the directory entry saves a stat() call for most files.
+static DWORD GetEntryAttributes(DIR* dir, const struct dirent* entry)
+{
+	struct stat st;
+	switch (entry->d_type)
+	{
+	case DT_DIR:
+		return FILE_ATTRIBUTE_DIRECTORY;
+	case DT_REG:
+		return FILE_ATTRIBUTE_NORMAL;
+	case DT_LNK:
+		// symlinks to directories are reported as directory reparse points like junctions on Windows
+		if (!fstatat(dirfd(dir), entry->d_name, &st, 0) && S_ISDIR(st.st_mode))
+			return FILE_ATTRIBUTE_DIRECTORY | FILE_ATTRIBUTE_REPARSE_POINT;
+		return FILE_ATTRIBUTE_REPARSE_POINT;
+	default:
+		if (fstatat(dirfd(dir), entry->d_name, &st, AT_SYMLINK_NOFOLLOW))
+			return FILE_ATTRIBUTE_NORMAL;
+		if (S_ISLNK(st.st_mode))
+		{
+			struct stat target;
+			if (!fstatat(dirfd(dir), entry->d_name, &target, 0) && S_ISDIR(target.st_mode))
+				return FILE_ATTRIBUTE_DIRECTORY | FILE_ATTRIBUTE_REPARSE_POINT;
+			return FILE_ATTRIBUTE_REPARSE_POINT;
+		}
+		return ToFileAttributes(st);
+	}
+}
+
+HANDLE FindFirstFile(const wchar_t* filename, WIN32_FIND_DATA* find_data)
+{
+	wstring dir, name;
+	SplitPattern(filename, dir, name);
+	if (name.empty())
+	{
+		errno = ENOENT;
+		return INVALID_HANDLE_VALUE;
+	}
+
+	SPosixFind* find = new SPosixFind;
+	if (name.find_first_of(L"*?") == wstring::npos)
+	{
+		// a path without wildcards is looked up without listing the directory
+		struct stat st;
+		if (stat(ToNativePath(filename).c_str(), &st) || !SetFindData(name, ToFileAttributes(st), find_data))
+		{
+			delete find;
+			return INVALID_HANDLE_VALUE;
+		}
+		find->single = true;
+		return (SPosixHandle*)find;
+	}
+
+	// *.* matches the names without extension on Windows
+	find->pattern = name==L"*.*" ? wstring(L"*") : name;
+	find->dir = opendir(dir.empty() ? "." : ToNativePath(dir.c_str()).c_str());
+	if (!find->dir)
+	{
+		delete find;
+		return INVALID_HANDLE_VALUE;
+	}
+	if (!FindNextFile((SPosixHandle*)find, find_data))
+	{
+		if (errno == ERROR_NO_MORE_FILES)
+			errno = ERROR_FILE_NOT_FOUND;
+		delete find;
+		return INVALID_HANDLE_VALUE;
+	}
+	return (SPosixHandle*)find;
+}
+
+BOOL FindNextFile(HANDLE handle, WIN32_FIND_DATA* find_data)
+{
+	SPosixFind* find = dynamic_cast<SPosixFind*>(ToPosixHandle(handle));
+	if (!find)
+	{
+		errno = EBADF;
+		return FALSE;
+	}
+	if (find->single)
+	{
+		errno = ERROR_NO_MORE_FILES;
+		return FALSE;
+	}
+	while (1)
+	{
+		errno = 0;
+		struct dirent* entry = readdir(find->dir);
+		if (!entry)
+		{
+			if (!errno)
+				errno = ERROR_NO_MORE_FILES;
+			return FALSE;
+		}
+		wstring name = FromNativePath(entry->d_name);
+		if (!WildcardMatchNoCase(find->pattern.c_str(), name.c_str()))
+			continue;
+		if (SetFindData(name, GetEntryAttributes(find->dir, entry), find_data))
+			return TRUE;
+	}
+}
+
+BOOL FindClose(HANDLE find)
+{
+	return CloseHandle(find);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// codepages
+//-------------------------------------------------------------------------------------------------
+
+
+static const UINT CP_UTF8 = 65001;
+
+// Candidate iconv names of a Windows codepage, the first one that iconv knows is used.
+static void GetIconvNames(UINT codepage, std::vector<std::string>& names)
+{
+	static const struct { UINT codepage; const char* name; } NAMES[] =
+	{
+		{ 20127, "ASCII" },
+		{ 20866, "KOI8-R" },
+		{ 21866, "KOI8-U" },
+		{ 28591, "ISO-8859-1" },
+		{ 28592, "ISO-8859-2" },
+		{ 28593, "ISO-8859-3" },
+		{ 28594, "ISO-8859-4" },
+		{ 28595, "ISO-8859-5" },
+		{ 28596, "ISO-8859-6" },
+		{ 28597, "ISO-8859-7" },
+		{ 28598, "ISO-8859-8" },
+		{ 28599, "ISO-8859-9" },
+		{ 28603, "ISO-8859-13" },
+		{ 28605, "ISO-8859-15" },
+		{ 38598, "ISO-8859-8" },
+		{ 50220, "ISO-2022-JP" },
+		{ 50221, "ISO-2022-JP" },
+		{ 50225, "ISO-2022-KR" },
+		{ 51932, "EUC-JP" },
+		{ 51936, "EUC-CN" },
+		{ 51949, "EUC-KR" },
+		{ 52936, "HZ" },
+		{ 54936, "GB18030" },
+		{ 10000, "MACINTOSH" },
+		{ 10007, "MAC-CYRILLIC" },
+		{ 10017, "MAC-UK" },
+		{ 10029, "MAC-CENTRALEUROPE" },
+		{ 10079, "MAC-IS" },
+	};
+	for (size_t i=0; i<sizeof(NAMES)/sizeof(NAMES[0]); ++i)
+	{
+		if (NAMES[i].codepage == codepage)
+			names.push_back(NAMES[i].name);
+	}
+	char buf[0x20];
+	// the 20xxx codepages are IBM EBCDIC codepages
+	if (codepage>20000 && codepage<21000)
+	{
+		snprintf(buf, sizeof(buf), "IBM%03u", codepage-20000);
+		names.push_back(buf);
+	}
+	snprintf(buf, sizeof(buf), "CP%03u", codepage);
+	names.push_back(buf);
+	snprintf(buf, sizeof(buf), "IBM%03u", codepage);
+	names.push_back(buf);
+}
+
+// iconv descriptors are expensive to open, each thread keeps the last used pair.
+struct SIconvPair
+{
+	UINT codepage;
+	iconv_t decoder;
+	iconv_t encoder;
+
+	SIconvPair() : codepage(0), decoder((iconv_t)-1), encoder((iconv_t)-1) {}
+	~SIconvPair()
+	{
+		Close();
+	}
+	void Close()
+	{
+		if (decoder != (iconv_t)-1)
+			iconv_close(decoder);
+		if (encoder != (iconv_t)-1)
+			iconv_close(encoder);
+		decoder = encoder = (iconv_t)-1;
+		codepage = 0;
+	}
+	bool Open(UINT _codepage)
+	{
+		if (codepage == _codepage)
+			return true;
+		Close();
+		std::vector<std::string> names;
+		GetIconvNames(_codepage, names);
+		for (size_t i=0,e=names.size(); i<e; ++i)
+		{
+			decoder = iconv_open("UTF-16LE", names[i].c_str());
+			if (decoder == (iconv_t)-1)
+				continue;
+			encoder = iconv_open(names[i].c_str(), "UTF-16LE");
+			if (encoder == (iconv_t)-1)
+			{
+				iconv_close(decoder);
+				decoder = (iconv_t)-1;
+				continue;
+			}
+			codepage = _codepage;
+			return true;
+		}
+		errno = EINVAL;
+		return false;
+	}
+};
+
+static pthread_key_t g_IconvKey;
+static pthread_once_t g_IconvKeyOnce = PTHREAD_ONCE_INIT;
+
+static void DeleteIconvPair(void* p)
+{
+	delete (SIconvPair*)p;
+}
+
+static void CreateIconvKey()
+{
+	pthread_key_create(&g_IconvKey, DeleteIconvPair);
+}
+
+static SIconvPair* GetIconvPair(UINT codepage)
+{
+	pthread_once(&g_IconvKeyOnce, CreateIconvKey);
+	SIconvPair* pair = (SIconvPair*)pthread_getspecific(g_IconvKey);
+	if (!pair)
+	{
+		pair = new SIconvPair;
+		pthread_setspecific(g_IconvKey, pair);
+	}
+	return pair->Open(codepage) ? pair : NULL;
+}
+
+// Converts all the input, on an unconvertible character on_error is called with the remaining
+// input and it returns false to stop or advances the input to continue.
+template <typename TOnError>
+static bool IconvAll(iconv_t cd, const char* in, size_t in_size, std::vector<char>& out, TOnError on_error)
+{
+	out.resize(in_size*2 + 16);
+	size_t used = 0;
+	iconv(cd, NULL, NULL, NULL, NULL);
+	while (1)
+	{
+		char* src = (char*)in;
+		char* dst = &out[used];
+		size_t dst_left = out.size() - used;
+		// the last call flushes the shift state
+		size_t res = in ? iconv(cd, &src, &in_size, &dst, &dst_left) : iconv(cd, NULL, NULL, &dst, &dst_left);
+		used = dst - &out[0];
+		if (in)
+			in = src;
+		if (res != (size_t)-1)
+		{
+			if (!in)
+				break;
+			in = NULL;
+			continue;
+		}
+		if (errno == E2BIG)
+		{
+			out.resize(out.size()*2);
+			continue;
+		}
+		if (!in || !on_error(in, in_size, out, used))
+			return false;
+	}
+	out.resize(used);
+	return true;
+}
+
+struct SDecodeError
+{
+	bool invalid_is_error;
+	bool operator()(const char*& in, size_t& in_size, std::vector<char>& out, size_t& used) const
+	{
+		if (invalid_is_error)
+		{
+			errno = ERROR_NO_UNICODE_TRANSLATION;
+			return false;
+		}
+		if (out.size()-used < 2)
+			out.resize(out.size()*2);
+		out[used++] = (char)0xFD;
+		out[used++] = (char)0xFF;
+		++in;
+		--in_size;
+		return true;
+	}
+};
+
+struct SEncodeError
+{
+	bool operator()(const char*& in, size_t& in_size, std::vector<char>& out, size_t& used) const
+	{
+		if (out.size() == used)
+			out.resize(out.size()*2);
+		out[used++] = '?';
+		// a surrogate pair is a single character
+		size_t skip = 2;
+		if (in_size>=4 && (in[1]&0xFC)==0xD8 && (in[3]&0xFC)==0xDC)
+			skip = 4;
+		skip = min(skip, in_size);
+		in += skip;
+		in_size -= skip;
+		return true;
+	}
+};
+
+int MultiByteToWideChar(UINT codepage, DWORD flags, const char* multibyte_str, int multibyte_count,
+						wchar_t* widechar_str, int widechar_count)
+{
+	if (multibyte_count < 0)
+		multibyte_count = (int)strlen(multibyte_str) + 1;
+	bool invalid_is_error = (flags & MB_ERR_INVALID_CHARS) != 0;
+
+	LONGLONG count;
+	std::vector<char> utf16;
+	if (codepage == CP_UTF8)
+	{
+		count = DecodeUTF8((const unsigned char*)multibyte_str, (size_t)multibyte_count, NULL, invalid_is_error);
+		if (count < 0)
+		{
+			errno = ERROR_NO_UNICODE_TRANSLATION;
+			return 0;
+		}
+	}
+	else
+	{
+		SIconvPair* pair = GetIconvPair(codepage);
+		if (!pair)
+			return 0;
+		SDecodeError on_error = { invalid_is_error };
+		if (!IconvAll(pair->decoder, multibyte_str, (size_t)multibyte_count, utf16, on_error))
+			return 0;
+		count = (LONGLONG)(utf16.size() / 2);
+	}
+
+	if (!widechar_count)
+		return (int)count;
+	if (count > widechar_count)
+	{
+		errno = ERROR_INSUFFICIENT_BUFFER;
+		return 0;
+	}
+	if (codepage == CP_UTF8)
+	{
+		DecodeUTF8((const unsigned char*)multibyte_str, (size_t)multibyte_count, widechar_str, invalid_is_error);
+	}
+	else
+	{
+		const unsigned char* p = utf16.empty() ? NULL : (const unsigned char*)&utf16[0];
+		for (LONGLONG i=0; i<count; ++i)
+			widechar_str[i] = (wchar_t)(p[i*2] | (p[i*2+1] << 8));
+	}
+	return (int)count;
+}
+
+int WideCharToMultiByte(UINT codepage, DWORD flags, const wchar_t* widechar_str, int widechar_count,
+						char* multibyte_str, int multibyte_count, const char* default_char, BOOL* used_default_char)
+{
+	if (widechar_count < 0)
+		widechar_count = (int)wcslen(widechar_str) + 1;
+
+	size_t count;
+	std::vector<char> encoded;
+	if (codepage == CP_UTF8)
+	{
+		count = EncodeUTF8(widechar_str, (size_t)widechar_count, NULL);
+	}
+	else
+	{
+		SIconvPair* pair = GetIconvPair(codepage);
+		if (!pair)
+			return 0;
+		std::vector<char> utf16((size_t)widechar_count * 2);
+		for (int i=0; i<widechar_count; ++i)
+		{
+			utf16[i*2] = (char)(widechar_str[i] & 0xFF);
+			utf16[i*2+1] = (char)((widechar_str[i] >> 8) & 0xFF);
+		}
+		if (!IconvAll(pair->encoder, utf16.empty() ? "" : &utf16[0], utf16.size(), encoded, SEncodeError()))
+			return 0;
+		count = encoded.size();
+	}
+
+	if (!multibyte_count)
+		return (int)count;
+	if (count > (size_t)multibyte_count)
+	{
+		errno = ERROR_INSUFFICIENT_BUFFER;
+		return 0;
+	}
+	if (codepage == CP_UTF8)
+		EncodeUTF8(widechar_str, (size_t)widechar_count, (unsigned char*)multibyte_str);
+	else if (count)
+		memcpy(multibyte_str, &encoded[0], count);
+	return (int)count;
+}
+
+BOOL GetCPInfo(UINT codepage, CPINFO* cp_info)
+{
+	if (codepage == CP_UTF8)
+	{
+		cp_info->MaxCharSize = 4;
+		return TRUE;
+	}
+	SIconvPair* pair = GetIconvPair(codepage);
+	if (!pair)
+		return FALSE;
+	// a byte that is an incomplete character on its own is a lead byte
+	cp_info->MaxCharSize = 1;
+	for (int i=0; i<0x100; ++i)
+	{
+		char b = (char)i;
+		char* src = &b;
+		size_t src_left = 1;
+		char buf[8];
+		char* dst = buf;
+		size_t dst_left = sizeof(buf);
+		iconv(pair->decoder, NULL, NULL, NULL, NULL);
+		if (iconv(pair->decoder, &src, &src_left, &dst, &dst_left)==(size_t)-1 && errno==EINVAL)
+		{
+			cp_info->MaxCharSize = 4;
+			break;
+		}
+	}
+	return TRUE;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// console output
+//-------------------------------------------------------------------------------------------------
+
+
+// Adds the 'l' length modifier to the %s and %c conversions that don't have one.
+static void ConvertFormat(const wchar_t* fmtstr, std::vector<wchar_t>& converted)
+{
+	converted.clear();
+	for (const wchar_t* p=fmtstr; *p; )
+	{
+		converted.push_back(*p);
+		if (*p++ != L'%')
+			continue;
+		if (*p == L'%')
+		{
+			converted.push_back(*p++);
+			continue;
+		}
+		while (*p && wcschr(L"-+ #0123456789.*", *p))
+			converted.push_back(*p++);
+		bool has_length = false;
+		while (*p && wcschr(L"hlLqjzt", *p))
+		{
+			has_length = true;
+			converted.push_back(*p++);
+		}
+		if (!has_length && (*p==L's' || *p==L'c'))
+			converted.push_back(L'l');
+	}
+	converted.push_back(0);
+}
+
+int PosixVswprintf(wchar_t* buf, size_t count, const wchar_t* fmtstr, va_list args)
+{
+	std::vector<wchar_t> converted;
+	ConvertFormat(fmtstr, converted);
+	int res = vswprintf(buf, count, &converted[0], args);
+	// MSVC leaves the buffer terminated on truncation
+	if (res<0 && count)
+		buf[count-1] = 0;
+	return res;
+}
+
+int PosixSwprintf(wchar_t* buf, size_t count, const wchar_t* fmtstr, ...)
+{
+	va_list args;
+	va_start(args, fmtstr);
+	int res = PosixVswprintf(buf, count, fmtstr, args);
+	va_end(args);
+	return res;
+}
+
+int PosixVfwprintf(FILE* f, const wchar_t* fmtstr, va_list args)
+{
+	std::vector<wchar_t> converted;
+	ConvertFormat(fmtstr, converted);
+	return vfwprintf(f, &converted[0], args);
+}
+
+int PosixFwprintf(FILE* f, const wchar_t* fmtstr, ...)
+{
+	va_list args;
+	va_start(args, fmtstr);
+	int res = PosixVfwprintf(f, fmtstr, args);
+	va_end(args);
+	return res;
+}
+
+int PosixVwprintf(const wchar_t* fmtstr, va_list args)
+{
+	return PosixVfwprintf(stdout, fmtstr, args);
+}
+
+int PosixWprintf(const wchar_t* fmtstr, ...)
+{
+	va_list args;
+	va_start(args, fmtstr);
+	int res = PosixVfwprintf(stdout, fmtstr, args);
+	va_end(args);
+	return res;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// entry point
+//-------------------------------------------------------------------------------------------------
+
+
+int main(int argc, char* argv[])
+{
+	// the wide console output is converted to the multibyte encoding of the locale
+	const char* locale = setlocale(LC_CTYPE, "");
+	if (!locale || !strcmp(locale, "C") || !strcmp(locale, "POSIX"))
+		setlocale(LC_CTYPE, "C.UTF-8");
+
+	g_ModuleFileName = argv[0];
+	std::vector<wstring> args(argc);
+	std::vector<wchar_t*> wargv;
+	for (int i=0; i<argc; ++i)
+	{
+		args[i] = FromNativePath(argv[i]);
+		wargv.push_back(&args[i][0]);
+	}
+	wargv.push_back(NULL);
+	return wmain(argc, &wargv[0]);
+}
+
+#endif
@@ -0,0 +1,270 @@
+#pragma once
+
+// Native POSIX implementation of the small Win32 subset used by this program, so the Linux build
+// runs without wine. Included by stdafx.h after the standard headers.
+// The strings are UTF-16 like on Windows even where wchar_t is 4 bytes: the paths are converted
+// to UTF-8 for the system calls and backslashes are accepted as path separators.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <wchar.h>
+#include <wctype.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+
+typedef uint32_t DWORD;
+typedef int32_t LONG;
+typedef int BOOL;
+typedef unsigned int UINT;
+typedef uint64_t ULONGLONG;
+typedef int64_t LONGLONG;
+typedef uintptr_t ULONG_PTR;
+typedef void* HANDLE;
+
+#define TRUE 1
+#define FALSE 0
+#define MAX_PATH 260
+#define INFINITE 0xFFFFFFFF
+#define INVALID_HANDLE_VALUE ((HANDLE)(intptr_t)-1)
+
+#define WINAPI
+#define __stdcall
+#define __cdecl
+#define __forceinline inline __attribute__((always_inline))
+
+template <typename T> inline T min(T a, T b)	{ return b < a ? b : a; }
+template <typename T> inline T max(T a, T b)	{ return a < b ? b : a; }
+
+
+//-------------------------------------------------------------------------------------------------
+// errors
+//-------------------------------------------------------------------------------------------------
+
+
+// GetLastError() returns errno values, the Win32 error codes tested by the program are mapped
+// to the corresponding errno values or to private codes above the errno range.
+#define ERROR_FILE_NOT_FOUND			ENOENT
+#define ERROR_PATH_NOT_FOUND			ENOTDIR
+#define ERROR_BROKEN_PIPE				EPIPE
+#define ERROR_NO_UNICODE_TRANSLATION	EILSEQ
+#define ERROR_INVALID_PARAMETER			EINVAL
+#define ERROR_NO_MORE_FILES				0x10012
+#define ERROR_INSUFFICIENT_BUFFER		0x1007A
+
+inline DWORD GetLastError()					{ return (DWORD)errno; }
+inline void SetLastError(DWORD last_error)	{ errno = (int)last_error; }
+
+
+//-------------------------------------------------------------------------------------------------
+// strings and console output
+//-------------------------------------------------------------------------------------------------
+
+
+#define _wcsicmp wcscasecmp
+#define _wcsnicmp wcsncasecmp
+#define _lock_file flockfile
+#define _unlock_file funlockfile
+
+// The wide printf functions of MSVC take wide strings for %s and %c, the POSIX ones take narrow
+// strings. These convert the format string before calling the C library.
+int PosixSwprintf(wchar_t* buf, size_t count, const wchar_t* fmtstr, ...);
+int PosixVswprintf(wchar_t* buf, size_t count, const wchar_t* fmtstr, va_list args);
+int PosixWprintf(const wchar_t* fmtstr, ...);
+int PosixVwprintf(const wchar_t* fmtstr, va_list args);
+int PosixFwprintf(FILE* f, const wchar_t* fmtstr, ...);
+int PosixVfwprintf(FILE* f, const wchar_t* fmtstr, va_list args);
+#define swprintf PosixSwprintf
+#define vswprintf PosixVswprintf
+#define wprintf PosixWprintf
+#define vwprintf PosixVwprintf
+#define fwprintf PosixFwprintf
+#define vfwprintf PosixVfwprintf
+
+// Defined by the program, called by main() with the arguments converted to UTF-16.
+int wmain(int argc, wchar_t* argv[]);
+
+
+//-------------------------------------------------------------------------------------------------
+// synchronization and threads
+//-------------------------------------------------------------------------------------------------
+
+
+inline LONG InterlockedIncrement(volatile LONG* p)		{ return __sync_add_and_fetch(p, 1); }
+inline LONG InterlockedDecrement(volatile LONG* p)		{ return __sync_sub_and_fetch(p, 1); }
+inline void MemoryBarrier()								{ __sync_synchronize(); }
+
+typedef pthread_mutex_t CRITICAL_SECTION;
+void InitializeCriticalSection(CRITICAL_SECTION* cs);
+inline void DeleteCriticalSection(CRITICAL_SECTION* cs)	{ pthread_mutex_destroy(cs); }
+inline void EnterCriticalSection(CRITICAL_SECTION* cs)	{ pthread_mutex_lock(cs); }
+inline void LeaveCriticalSection(CRITICAL_SECTION* cs)	{ pthread_mutex_unlock(cs); }
+
+// Threads and semaphores are handles that can be waited for and closed.
+uintptr_t _beginthreadex(void* security, unsigned stack_size, unsigned (*start_address)(void*),
+						 void* arglist, unsigned initflag, unsigned* thrdaddr);
+HANDLE CreateSemaphore(void* attributes, LONG initial_count, LONG maximum_count, const wchar_t* name);
+BOOL ReleaseSemaphore(HANDLE semaphore, LONG release_count, LONG* previous_count);
+// Only manual reset events are supported.
+HANDLE CreateEvent(void* attributes, BOOL manual_reset, BOOL initial_state, const wchar_t* name);
+BOOL SetEvent(HANDLE event);
+// A descriptor that becomes readable when the event is set, -1 for other handles.
+int GetEventDescriptor(HANDLE event);
+#define WAIT_OBJECT_0					0
+#define WAIT_TIMEOUT					0x102
+#define WAIT_FAILED						0xFFFFFFFF
+// Only INFINITE timeout is supported, and zero timeout for semaphores.
+DWORD WaitForSingleObject(HANDLE handle, DWORD milliseconds);
+BOOL CloseHandle(HANDLE handle);
+
+struct SYSTEM_INFO
+{
+	DWORD dwNumberOfProcessors;
+};
+void GetSystemInfo(SYSTEM_INFO* system_info);
+
+// Replaces SetConsoleCtrlHandler(): SIGINT and SIGTERM set the event. A signal handler can't
+// call back into the program safely, so only one event can be set this way.
+BOOL SetConsoleCtrlEvent(HANDLE event, BOOL add);
+// Milliseconds of a monotonic clock.
+DWORD GetTickCount();
+
+
+//-------------------------------------------------------------------------------------------------
+// files
+//-------------------------------------------------------------------------------------------------
+
+
+#define GENERIC_READ					0x80000000
+#define GENERIC_WRITE					0x40000000
+#define FILE_SHARE_READ					0x00000001
+#define FILE_SHARE_WRITE				0x00000002
+#define FILE_SHARE_DELETE				0x00000004
+#define CREATE_ALWAYS					2
+#define OPEN_EXISTING					3
+#define FILE_ATTRIBUTE_READONLY			0x00000001
+#define FILE_ATTRIBUTE_DIRECTORY		0x00000010
+#define FILE_ATTRIBUTE_NORMAL			0x00000080
+#define FILE_ATTRIBUTE_REPARSE_POINT	0x00000400
+#define FILE_FLAG_BACKUP_SEMANTICS		0x02000000
+#define FILE_FLAG_SEQUENTIAL_SCAN		0x08000000
+#define MOVEFILE_REPLACE_EXISTING		0x00000001
+#define STD_INPUT_HANDLE				((DWORD)-10)
+#define STD_OUTPUT_HANDLE				((DWORD)-11)
+#define STD_ERROR_HANDLE				((DWORD)-12)
+
+union LARGE_INTEGER
+{
+	struct
+	{
+		DWORD LowPart;
+		LONG HighPart;
+	};
+	LONGLONG QuadPart;
+};
+
+// 100 nanosecond intervals since 1601-01-01
+struct FILETIME
+{
+	DWORD dwLowDateTime;
+	DWORD dwHighDateTime;
+};
+
+struct WIN32_FILE_ATTRIBUTE_DATA
+{
+	DWORD dwFileAttributes;
+	FILETIME ftCreationTime;
+	FILETIME ftLastAccessTime;
+	FILETIME ftLastWriteTime;
+	DWORD nFileSizeHigh;
+	DWORD nFileSizeLow;
+};
+
+struct BY_HANDLE_FILE_INFORMATION
+{
+	DWORD dwFileAttributes;
+	FILETIME ftCreationTime;
+	FILETIME ftLastAccessTime;
+	FILETIME ftLastWriteTime;
+	DWORD dwVolumeSerialNumber;
+	DWORD nFileSizeHigh;
+	DWORD nFileSizeLow;
+	DWORD nNumberOfLinks;
+	DWORD nFileIndexHigh;
+	DWORD nFileIndexLow;
+};
+
+// Only the attributes and the name are filled in.
+struct WIN32_FIND_DATA
+{
+	DWORD dwFileAttributes;
+	wchar_t cFileName[MAX_PATH];
+};
+
+enum GET_FILEEX_INFO_LEVELS
+{
+	GetFileExInfoStandard,
+};
+
+// Only the flags used by this program are supported: GENERIC_READ with OPEN_EXISTING, GENERIC_WRITE
+// with CREATE_ALWAYS and GENERIC_WRITE|FILE_FLAG_BACKUP_SEMANTICS to open a directory for flushing.
+HANDLE CreateFile(const wchar_t* filename, DWORD desired_access, DWORD share_mode, void* security_attributes,
+				  DWORD creation_disposition, DWORD flags_and_attributes, HANDLE template_file);
+// The overlapped parameters must be NULL. Regular files are read until the buffer is full
+// or the end of the file is reached, pipes return the available data.
+BOOL ReadFile(HANDLE file, void* buffer, DWORD bytes_to_read, DWORD* bytes_read, void* overlapped);
+BOOL WriteFile(HANDLE file, const void* buffer, DWORD bytes_to_write, DWORD* bytes_written, void* overlapped);
+BOOL GetFileSizeEx(HANDLE file, LARGE_INTEGER* file_size);
+// The volume serial number and the file index are the device and the inode numbers.
+BOOL GetFileInformationByHandle(HANDLE file, BY_HANDLE_FILE_INFORMATION* file_information);
+BOOL FlushFileBuffers(HANDLE file);
+HANDLE GetStdHandle(DWORD std_handle);
+// The descriptor of a handle returned by CreateFile() or GetStdHandle(), -1 for other handles.
+int GetFileDescriptor(HANDLE file);
+#ifdef __linux__
+// Converts the result of a statx() issued by the caller like GetFileInformationByHandle().
+struct statx;
+void GetFileInformationFromStatx(const struct statx& stx, BY_HANDLE_FILE_INFORMATION* file_information);
+#endif
+// The paths of the system calls are UTF-8. The bytes that aren't valid UTF-8 are kept as lone
+// low surrogates in the UTF-16 paths so they can be converted back.
+std::string ToNativePath(const wchar_t* path);
+wstring FromNativePath(const char* path);
+
+BOOL GetFileAttributesEx(const wchar_t* filename, GET_FILEEX_INFO_LEVELS info_level, void* file_information);
+BOOL MoveFileEx(const wchar_t* existing_filename, const wchar_t* new_filename, DWORD flags);
+BOOL DeleteFile(const wchar_t* filename);
+DWORD GetFullPathName(const wchar_t* filename, DWORD buffer_length, wchar_t* buffer, wchar_t** file_part);
+DWORD GetModuleFileName(HANDLE module, wchar_t* filename, DWORD size);
+
+// The wildcards can be used only in the last path component like on Windows. The matching
+// is case insensitive and symlinks are reported as reparse points.
+HANDLE FindFirstFile(const wchar_t* filename, WIN32_FIND_DATA* find_data);
+BOOL FindNextFile(HANDLE find, WIN32_FIND_DATA* find_data);
+BOOL FindClose(HANDLE find);
+
+
+//-------------------------------------------------------------------------------------------------
+// codepages
+//-------------------------------------------------------------------------------------------------
+
+
+#define MB_ERR_INVALID_CHARS	0x00000008
+
+struct CPINFO
+{
+	UINT MaxCharSize;
+};
+
+// UTF-8 (65001) is converted internally, the other codepages are converted with iconv.
+// Like on Windows the characters that can't be encoded are replaced with '?' and the
+// invalid byte sequences are errors only with MB_ERR_INVALID_CHARS.
+int MultiByteToWideChar(UINT codepage, DWORD flags, const char* multibyte_str, int multibyte_count,
+						wchar_t* widechar_str, int widechar_count);
+int WideCharToMultiByte(UINT codepage, DWORD flags, const wchar_t* widechar_str, int widechar_count,
+						char* multibyte_str, int multibyte_count, const char* default_char, BOOL* used_default_char);
+BOOL GetCPInfo(UINT codepage, CPINFO* cp_info);
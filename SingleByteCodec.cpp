@@ -0,0 +1,231 @@
+#include "stdafx.h"
+#include "SingleByteCodec.h"
+#include "UTF8.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define USE_SSSE3
+#include <tmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+
+static const unsigned short UNDEFINED_BYTE = 0xFFFF;
+
+#ifdef USE_SSSE3
+
+#ifdef _MSC_VER
+#define SSSE3_FUNCTION
+static bool DetectSSSE3()
+{
+	int info[4];
+	__cpuid(info, 1);
+	return (info[2] & (1 << 9)) != 0;
+}
+#else
+// gcc and clang compile the intrinsics only in functions that are marked for SSSE3.
+#define SSSE3_FUNCTION __attribute__((target("ssse3")))
+static bool DetectSSSE3()
+{
+	unsigned eax, ebx, ecx, edx;
+	return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSSE3)!=0;
+}
+#endif
+static const bool g_HasSSSE3 = DetectSSSE3();
+
+#endif // USE_SSSE3
+
+CSingleByteCodec::CSingleByteCodec(const SSingleByteTable& table)
+: m_ASCIIBased(table.ascii_based)
+{
+	if (table.ascii_based)
+	{
+		for (int i=0; i<0x80; ++i)
+			m_DecodeTable[i] = (unsigned short)i;
+		memcpy(&m_DecodeTable[0x80], table.table, 0x80*sizeof(m_DecodeTable[0]));
+	}
+	else
+	{
+		memcpy(m_DecodeTable, table.table, sizeof(m_DecodeTable));
+	}
+	for (int i=0; i<0x100; ++i)
+	{
+		m_DecodeLowBytes[i] = (unsigned char)m_DecodeTable[i];
+		m_DecodeHighBytes[i] = (unsigned char)(m_DecodeTable[i] >> 8);
+	}
+
+	memset(m_PageIndex, 0, sizeof(m_PageIndex));
+	m_Pages.resize(0x100);
+	for (int i=0; i<0x100; ++i)
+	{
+		unsigned c = m_DecodeTable[i];
+		if (c == UNDEFINED_BYTE)
+			continue;
+		unsigned high = c >> 8;
+		if (!m_PageIndex[high])
+		{
+			assert(m_Pages.size() < 0x100*0x100);
+			m_PageIndex[high] = (unsigned char)(m_Pages.size() / 0x100);
+			m_Pages.resize(m_Pages.size() + 0x100);
+		}
+		unsigned short& entry = m_Pages[m_PageIndex[high]*0x100 + (c & 0xFF)];
+		// the first byte wins if more bytes are decoded to the same character
+		if (!entry)
+			entry = (unsigned short)(i + 1);
+	}
+}
+
+ILINE int CSingleByteCodec::EncodeChar(unsigned c) const
+{
+	return (int)m_Pages[m_PageIndex[(c >> 8) & 0xFF]*0x100 + (c & 0xFF)] - 1;
+}
+
+const char* CSingleByteCodec::Validate(const char* s_begin, const char* s_end, size_t& utf16_length) const
+{
+	for (const unsigned char* s=(const unsigned char*)s_begin; s<(const unsigned char*)s_end; ++s)
+	{
+		if (m_DecodeTable[*s] == UNDEFINED_BYTE)
+		{
+			utf16_length = (const char*)s - s_begin;
+			return (const char*)s;
+		}
+	}
+	utf16_length = s_end - s_begin;
+	return s_end;
+}
+
+#ifdef USE_SSSE3
+
+// The ASCII based codepages decode the blocks that have fewer non-ASCII bytes without SSSE3.
+static const int MIN_NON_ASCII_BYTES = 4;
+
+// pshufb looks up 16 bytes in a 16 byte table, so the low and the high bytes of the decode
+// table are split into 16 byte slices by the high nibble of the byte. The index of a byte in
+// slice h is byte-16*h, adding 0x70 with saturation sets the top bit of the index unless it is
+// in the slice, and pshufb returns zero for those. The bytes below 0x80 of the ASCII based
+// codepages are decoded to themselves without a lookup.
+SSSE3_FUNCTION const unsigned char* CSingleByteCodec::DecodeBlocks(const unsigned char* s, const unsigned char* s_end, wchar_t*& dst) const
+{
+	const int first_slice = m_ASCIIBased ? 8 : 0;
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i slice_step = _mm_set1_epi8(0x10);
+	const __m128i index_bias = _mm_set1_epi8(0x70);
+	for (; s_end-s>=16; s+=16, dst+=16)
+	{
+		__m128i bytes = _mm_loadu_si128((const __m128i*)s);
+		__m128i low, high;
+		if (m_ASCIIBased)
+		{
+			// The ASCII blocks are left to WidenASCII() and the few non-ASCII bytes of the
+			// mostly ASCII blocks are cheaper to look up one by one.
+			unsigned mask = (unsigned)_mm_movemask_epi8(bytes);
+			int non_ascii = 0;
+			for (; mask && non_ascii<MIN_NON_ASCII_BYTES; mask&=mask-1)
+				++non_ascii;
+			if (non_ascii < MIN_NON_ASCII_BYTES)
+				break;
+			low = _mm_andnot_si128(_mm_cmplt_epi8(bytes, zero), bytes);
+			high = zero;
+		}
+		else
+		{
+			low = high = zero;
+		}
+		__m128i index = _mm_sub_epi8(bytes, _mm_set1_epi8((char)(first_slice*0x10)));
+		for (int slice=first_slice; slice<0x10; ++slice)
+		{
+			__m128i slice_index = _mm_adds_epu8(index, index_bias);
+			low = _mm_or_si128(low, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&m_DecodeLowBytes[slice*0x10]), slice_index));
+			high = _mm_or_si128(high, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&m_DecodeHighBytes[slice*0x10]), slice_index));
+			index = _mm_sub_epi8(index, slice_step);
+		}
+		// an undefined byte is left to the caller that reports its position
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(low, high), _mm_set1_epi8((char)0xFF))))
+			break;
+		__m128i lo = _mm_unpacklo_epi8(low, high);
+		__m128i hi = _mm_unpackhi_epi8(low, high);
+#if WCHAR_MAX > 0xFFFF
+		_mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi16(lo, zero));
+		_mm_storeu_si128((__m128i*)(dst+4), _mm_unpackhi_epi16(lo, zero));
+		_mm_storeu_si128((__m128i*)(dst+8), _mm_unpacklo_epi16(hi, zero));
+		_mm_storeu_si128((__m128i*)(dst+12), _mm_unpackhi_epi16(hi, zero));
+#else
+		_mm_storeu_si128((__m128i*)dst, lo);
+		_mm_storeu_si128((__m128i*)(dst+8), hi);
+#endif
+	}
+	return s;
+}
+
+#endif // USE_SSSE3
+
+const char* CSingleByteCodec::Decode(const char* s_begin, const char* s_end, wchar_t*& dst) const
+{
+	const unsigned char* s = (const unsigned char*)s_begin;
+	const unsigned char* e = (const unsigned char*)s_end;
+	while (s < e)
+	{
+		if (m_ASCIIBased)
+		{
+			size_t ascii = WidenASCII((const char*)s, s_end, dst);
+			s += ascii;
+			dst += ascii;
+			if (s >= e)
+				break;
+		}
+#ifdef USE_SSSE3
+		if (g_HasSSSE3)
+			s = DecodeBlocks(s, e, dst);
+#endif
+		// the non-ASCII characters usually come in runs, the rest of the blocks and the
+		// undefined bytes are handled here
+		for (; s<e && (*s>=0x80 || !m_ASCIIBased); ++s)
+		{
+			unsigned short c = m_DecodeTable[*s];
+			if (c == UNDEFINED_BYTE)
+				return (const char*)s;
+			*dst++ = (wchar_t)c;
+		}
+	}
+	return s_end;
+}
+
+// Returns the number of code units of the character at s.
+ILINE static size_t CharLength(const wchar_t* s, const wchar_t* s_end)
+{
+	unsigned c = (unsigned)s[0];
+	if (c>=0xD800 && c<0xDC00 && s+1<s_end && ((unsigned)s[1]&~0x3FFu)==0xDC00)
+		return 2;
+	return 1;
+}
+
+size_t CSingleByteCodec::GetEncodedSize(const wchar_t* s_begin, const wchar_t* s_end) const
+{
+	size_t size = 0;
+	for (const wchar_t* s=s_begin; s<s_end; s+=CharLength(s, s_end))
+		++size;
+	return size;
+}
+
+char* CSingleByteCodec::Encode(const wchar_t* s_begin, const wchar_t* s_end, char* dst) const
+{
+	const wchar_t* s = s_begin;
+	while (s < s_end)
+	{
+		if (m_ASCIIBased)
+		{
+			size_t ascii = NarrowASCII(s, s_end, dst);
+			s += ascii;
+			dst += ascii;
+			if (s >= s_end)
+				break;
+		}
+		int b = EncodeChar((unsigned)*s);
+		*dst++ = b<0 ? '?' : (char)b;
+		s += CharLength(s, s_end);
+	}
+	return dst;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CodepageCodec.h"
+
+
+struct SSingleByteTable
+{
+	UINT codepage;
+	// bytes 0x00-0x7F are ASCII, the table starts at byte 0x80
+	bool ascii_based;
+	const unsigned short* table;
+};
+
+// Returns NULL if the codepage doesn't have a built-in table.
+const SSingleByteTable* FindSingleByteTable(UINT codepage);
+
+
+// Table driven conversion of a single byte codepage. The decode table maps every byte to
+// a UTF-16 unit (0xFFFF if the byte is undefined) and the reverse table is a two level table
+// indexed by the high and the low byte of the UTF-16 unit. Only the pages that contain
+// characters of the codepage are allocated. Runs of ASCII are converted with the SSE2
+// helpers of UTF8.h in the ASCII based codepages, the other bytes are decoded 16 at a time
+// with pshufb lookups if the processor has SSSE3.
+class CSingleByteCodec : public ICodepageCodec
+{
+public:
+	CSingleByteCodec(const SSingleByteTable& table);
+
+	virtual const char* Validate(const char* s_begin, const char* s_end, size_t& utf16_length) const;
+	virtual const char* Decode(const char* s_begin, const char* s_end, wchar_t*& dst) const;
+	virtual size_t GetEncodedSize(const wchar_t* s_begin, const wchar_t* s_end) const;
+	virtual char* Encode(const wchar_t* s_begin, const wchar_t* s_end, char* dst) const;
+	virtual size_t GetMaxByteCount(size_t utf16_chars) const		{ return utf16_chars; }
+	virtual const unsigned short* GetSingleByteTable() const	{ return m_DecodeTable; }
+
+private:
+	// Returns -1 if the codepage doesn't have the character.
+	int EncodeChar(unsigned c) const;
+	// Decodes 16 byte blocks with SSSE3 until an ASCII block, an undefined byte or the last
+	// 15 bytes. Returns the end of the decoded blocks.
+	const unsigned char* DecodeBlocks(const unsigned char* s, const unsigned char* s_end, wchar_t*& dst) const;
+
+private:
+	unsigned short m_DecodeTable[0x100];
+	// the low and the high bytes of m_DecodeTable for the pshufb lookups
+	unsigned char m_DecodeLowBytes[0x100];
+	unsigned char m_DecodeHighBytes[0x100];
+	bool m_ASCIIBased;
+	// page index of each high byte, page 0 is empty
+	unsigned char m_PageIndex[0x100];
+	// byte+1 of each character, 0 if the codepage doesn't have the character
+	std::vector<unsigned short> m_Pages;
+};
@@ -0,0 +1,121 @@
+# Generates EncodingNameHash.h and EncodingNameHash.cpp from the names of ../EncodingList.h.
+#
+# The names are hashed into buckets with HashEncodingName(0, name) and each bucket gets the
+# smallest seed that puts all of its names into free slots with HashEncodingName(seed, name),
+# the buckets with the most names first. The names are compared case insensitively in ASCII.
+# Run it from any directory after editing EncodingList.h: python3 GenEncodingNameHash.py
+# The debug build of the program checks the generated tables at startup.
+
+import os
+import re
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+
+# the encodings that XmlEncoding.cpp registers before the EncodingList.h ones
+BUILTIN_ENCODINGS = [['UTF-16', 'UTF16'], ['UTF-8', 'UTF8', 'Windows-65001']]
+
+
+def read_encodings():
+	encodings = list(BUILTIN_ENCODINGS)
+	src = open(os.path.join(ROOT, 'EncodingList.h'), encoding='utf-8').read()
+	for line in src.splitlines():
+		line = line.strip()
+		if not line or line.startswith('//'):
+			continue
+		m = re.match(r'REGISTER_CODEPAGE\((\d+),(.*)\)$', line)
+		assert m, line
+		encodings.append(re.findall(r'L"([^"]*)"', m.group(2)))
+	return encodings
+
+
+def lower(name):
+	return ''.join(chr(ord(c)+32) if 'A' <= c <= 'Z' else c for c in name)
+
+
+# FNV-1a like HashEncodingName() of EncodingNameHash.h
+def hash_name(seed, name):
+	h = (2166136261 ^ seed) & 0xFFFFFFFF
+	for c in lower(name):
+		h = ((h ^ ord(c)) * 16777619) & 0xFFFFFFFF
+	return h
+
+
+def main():
+	encodings = read_encodings()
+	names = [(e, i, name) for e, encoding_names in enumerate(encodings) for i, name in enumerate(encoding_names)]
+	assert len(set(lower(name) for _, _, name in names)) == len(names), 'duplicate name'
+	n = len(names)
+	bucket_count = (n+3) // 4
+	buckets = [[] for _ in range(bucket_count)]
+	for t in names:
+		buckets[hash_name(0, t[2]) % bucket_count].append(t)
+	slots = [None]*n
+	seeds = [0]*bucket_count
+	for b in sorted(range(bucket_count), key=lambda b: -len(buckets[b])):
+		if not buckets[b]:
+			continue
+		for seed in range(1, 65536):
+			pos = [hash_name(seed, t[2]) % n for t in buckets[b]]
+			if len(set(pos)) == len(pos) and all(slots[p] is None for p in pos):
+				for p, t in zip(pos, buckets[b]):
+					slots[p] = t
+				seeds[b] = seed
+				break
+		else:
+			raise SystemExit('No seed found for bucket %d.' % b)
+
+	out = ['#include "stdafx.h"', '#include "EncodingNameHash.h"', '', '',
+		'// Generated from the names of the UTF-16, UTF-8 and the EncodingList.h encodings, it has to be',
+		'// regenerated with Tools/GenEncodingNameHash.py after editing EncodingList.h.', '',
+		'const unsigned short ENCODING_NAME_SEEDS[ENCODING_NAME_BUCKETS] =', '{']
+	for i in range(0, bucket_count, 16):
+		out.append('\t' + ','.join('%d' % x for x in seeds[i:i+16]) + ',')
+	out += ['};', '', 'const SEncodingNameSlot ENCODING_NAME_SLOTS[ENCODING_NAME_COUNT] =', '{']
+	for i in range(0, n, 8):
+		out.append('\t' + ' '.join('{ %d, %d },' % (t[0], t[1]) for t in slots[i:i+8]))
+	out += ['};', '']
+	open(os.path.join(ROOT, 'EncodingNameHash.cpp'), 'w', newline='').write('\r\n'.join(out))
+
+	header = HEADER.replace('@ENCODING_COUNT', str(len(encodings)))
+	header = header.replace('@ENCODING_NAME_COUNT', str(n)).replace('@ENCODING_NAME_BUCKETS', str(bucket_count))
+	open(os.path.join(ROOT, 'EncodingNameHash.h'), 'w', newline='').write(header.replace('\n', '\r\n'))
+
+
+HEADER = '''#pragma once
+
+
+// The minimal perfect hash of the encoding names, generated from the names of the UTF-16, UTF-8
+// and the EncodingList.h encodings with Tools/GenEncodingNameHash.py. The name is in slot
+// HashEncodingName(ENCODING_NAME_SEEDS[HashEncodingName(0, name) % ENCODING_NAME_BUCKETS], name)
+// % ENCODING_NAME_COUNT if it is a known name.
+
+static const int ENCODING_COUNT = @ENCODING_COUNT;
+static const int ENCODING_NAME_COUNT = @ENCODING_NAME_COUNT;
+static const int ENCODING_NAME_BUCKETS = @ENCODING_NAME_BUCKETS;
+
+struct SEncodingNameSlot
+{
+	unsigned short encoding;
+	unsigned short name;
+};
+
+extern const unsigned short ENCODING_NAME_SEEDS[ENCODING_NAME_BUCKETS];
+extern const SEncodingNameSlot ENCODING_NAME_SLOTS[ENCODING_NAME_COUNT];
+
+// FNV-1a hash of the name with its ASCII letters lowercased.
+inline unsigned HashEncodingName(unsigned seed, const wchar_t* name)
+{
+	unsigned h = 2166136261u ^ seed;
+	for (; *name; ++name)
+	{
+		unsigned c = (unsigned)*name;
+		if (c>='A' && c<='Z')
+			c += 'a' - 'A';
+		h = (h ^ c) * 16777619u;
+	}
+	return h;
+}
+'''
+
+
+main()
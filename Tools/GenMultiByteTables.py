@@ -0,0 +1,218 @@
+# Generates MultiByteTables.cpp from the CJK codecs of Python.
+#
+# The CJK codecs of Python (Modules/cjkcodecs) are generated from these mapping files:
+#   EUC-JP: JIS0208.TXT and JIS0212.TXT of unicode.org MAPPINGS/OBSOLETE/EASTASIA/JIS
+#   EUC-KR: KSC5601.TXT of unicode.org MAPPINGS/OBSOLETE/EASTASIA/KSC
+#   GB18030, GB2312: GB2312.TXT of unicode.org MAPPINGS/OBSOLETE/EASTASIA/GB, CP936.TXT of
+#     MAPPINGS/VENDORS/MICSFT/WINDOWS and the four byte ranges of the GB18030-2000 standard
+#   Windows 932, 936, 949 and 950: CP932.TXT, CP936.TXT, CP949.TXT and CP950.TXT of unicode.org
+#     MAPPINGS/VENDORS/MICSFT/WINDOWS
+# Codepage 936 is completed like Windows does: 0x80 is the euro sign of CP936.TXT that the gbk
+# codec lacks, and the codes that GBK leaves to the users or reserves are decoded to the private
+# use characters U+E000-U+E864 like in GB18030-2000. The user defined codes of 932 are in the
+# codec, the ones of 949 and 950 are left undefined.
+# JIS X 0212 0x2237 is decoded to U+FF5E like Windows (codepage 20932) does instead of the
+# U+007E of JIS0212.TXT that would collide with ASCII.
+# The output was generated with Python 3.11, run it from any directory:
+# python3 GenMultiByteTables.py
+# It prints the GB18030_RANGE_COUNT of MultiByteCodec.h.
+
+import os
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+
+
+def table94(encoding, prefix=b''):
+	table = []
+	for b1 in range(0xA1, 0xFF):
+		for b2 in range(0xA1, 0xFF):
+			try:
+				table.append(ord((prefix + bytes([b1, b2])).decode(encoding)))
+			except UnicodeDecodeError:
+				table.append(0xFFFF)
+	return table
+
+
+def gbk_table():
+	table = []
+	for b1 in range(0x81, 0xFF):
+		for b2 in list(range(0x40, 0x7F)) + list(range(0x80, 0xFF)):
+			try:
+				table.append(ord(bytes([b1, b2]).decode('gb18030')))
+			except UnicodeDecodeError:
+				table.append(0xFFFF)
+	return table
+
+
+def gb18030_ranges():
+	def linear(b):
+		return (((b[0]-0x81)*10 + b[1]-0x30)*126 + b[2]-0x81)*10 + b[3]-0x30
+	ranges = []
+	prev = None
+	for c in range(0x80, 0x10000):
+		if 0xD800 <= c < 0xE000:
+			continue
+		b = chr(c).encode('gb18030')
+		if len(b) == 4:
+			index = linear(b)
+			if not (prev and index == prev[0]+1 and c == prev[1]+1):
+				ranges.append((index, c))
+			prev = (index, c)
+	assert prev == (39419, 0xFFFF)
+	return ranges
+
+
+GBK_TRAIL_BYTES = list(range(0x40, 0x7F)) + list(range(0x80, 0xFF))
+
+
+def decode_char(encoding, b):
+	try:
+		s = bytes(b).decode(encoding)
+	except UnicodeDecodeError:
+		return None
+	return ord(s) if len(s) == 1 else None
+
+
+# Returns the decoded bytes 0x80-0xFF, the two byte codes indexed like GBK_TABLE and the
+# (character, code) pairs where the encoder doesn't use the first code that is decoded to the
+# character in the order of CMultiByteCodec::AddReverse(): the preferred ones of the characters
+# that more codes are decoded to and the best fit codes of characters that aren't decoded.
+def double_byte_tables(codepage, encoding):
+	single_bytes = [0xFFFF]*128
+	for b in range(0x80, 0x100):
+		c = decode_char(encoding, [b])
+		if c is not None:
+			single_bytes[b-0x80] = c
+	table = [0xFFFF]*(126*190)
+	for b1 in range(0x81, 0xFF):
+		for i, b2 in enumerate(GBK_TRAIL_BYTES):
+			c = decode_char(encoding, [b1, b2])
+			if c is not None:
+				table[(b1-0x81)*190 + i] = c
+	if codepage == 936:
+		single_bytes[0] = 0x20AC
+		private_use = 0xE766
+		for b1 in range(0x81, 0xFF):
+			for i, b2 in enumerate(GBK_TRAIL_BYTES):
+				if table[(b1-0x81)*190 + i] != 0xFFFF:
+					continue
+				c = decode_char('gb18030', [b1, b2])
+				if c < 0xE000 or c > 0xE765:
+					# the reserved codes, GB18030-2005 assigned standard characters to a few of them
+					assert c == private_use or c < 0xE000 or c > 0xF8FF
+					c = private_use
+					private_use += 1
+				table[(b1-0x81)*190 + i] = c
+		assert private_use == 0xE865
+
+	first_codes = {}
+	for b in range(0x80, 0x100):
+		first_codes.setdefault(single_bytes[b-0x80], b)
+	for i, c in enumerate(table):
+		first_codes.setdefault(c, ((0x81 + i//190) << 8) | GBK_TRAIL_BYTES[i%190])
+	extra_encodings = []
+	for c in range(0x80, 0x10000):
+		if 0xD800 <= c < 0xE000:
+			continue
+		try:
+			b = chr(c).encode(encoding)
+		except UnicodeEncodeError:
+			continue
+		assert len(b) <= 2
+		code = int(b.hex(), 16)
+		if code != first_codes.get(c):
+			extra_encodings.append((c, code))
+	return single_bytes, table, extra_encodings
+
+
+def gb2312_codes():
+	rows = []
+	for b1 in range(0xA1, 0xF8):
+		bits = [0]*12
+		for b2 in range(0xA1, 0xFF):
+			try:
+				bytes([b1, b2]).decode('gb2312')
+				i = b2 - 0xA1
+				bits[i//8] |= 1 << (i&7)
+			except UnicodeDecodeError:
+				pass
+		rows.append(bits)
+	return rows
+
+
+def main():
+	jis0208 = table94('euc_jp')
+	jis0212 = table94('euc_jp', b'\x8f')
+	i = (0xA2-0xA1)*94 + 0xB7-0xA1
+	assert jis0212[i] == 0x7E
+	jis0212[i] = 0xFF5E
+	ksc5601 = table94('euc_kr')
+	ranges = gb18030_ranges()
+
+	out = ['#include "stdafx.h"', '#include "MultiByteCodec.h"', '', '',
+		'// Generated from the unicode.org and vendor mapping files of the codepages. 0xFFFF marks the',
+		'// undefined codes. See Tools/GenMultiByteTables.py.',
+		'']
+
+	def emit(name, size, data, comment, storage=''):
+		out.append('// ' + comment)
+		out.append('%sconst unsigned short %s[%s] =' % (storage, name, size))
+		out.append('{')
+		for i in range(0, len(data), 16):
+			out.append('\t' + ','.join('0x%04X' % x for x in data[i:i+16]) + ',')
+		out.append('};')
+		out.append('')
+
+	emit('JIS0208_TABLE', '94*94', jis0208, 'JIS X 0208, indexed by (byte1-0xA1)*94 + byte2-0xA1 of the EUC form.')
+	emit('JIS0212_TABLE', '94*94', jis0212, 'JIS X 0212, the EUC-JP form is 0x8F byte1 byte2.')
+	emit('KSC5601_TABLE', '94*94', ksc5601, 'KS X 1001, indexed like JIS0208_TABLE.')
+	emit('GBK_TABLE', '126*190', gbk_table(), 'The two byte codes of GB18030, indexed by (byte1-0x81)*190 + byte2-0x40 (-0x41 above 0x7F).')
+	out.append('// The four byte codes of GB18030 below U+10000 as (linear index, first character) pairs.')
+	out.append('// The linear index of the four bytes b1 b2 b3 b4 is (((b1-0x81)*10 + b2-0x30)*126 + b3-0x81)*10 + b4-0x30')
+	out.append('// and each range lasts until the next one.')
+	out.append('const unsigned short GB18030_RANGES[GB18030_RANGE_COUNT][2] =')
+	out.append('{')
+	for i in range(0, len(ranges), 8):
+		out.append('\t' + ', '.join('{ %d, 0x%04X }' % r for r in ranges[i:i+8]) + ',')
+	out.append('};')
+	out.append('')
+	out.append('// The codes of GB2312 (the GBK codes that HZ can use), bit (byte2-0xA1)&7 of byte (byte2-0xA1)/8')
+	out.append('// of row byte1-0xA1.')
+	out.append('const unsigned char GB2312_CODES[87][12] =')
+	out.append('{')
+	for bits in gb2312_codes():
+		out.append('\t{ ' + ','.join('0x%02X' % b for b in bits) + ' },')
+	out.append('};')
+
+	for codepage in (932, 936, 949, 950):
+		single_bytes, table, extra_encodings = double_byte_tables(codepage, 'cp%d' % codepage)
+		out.append('')
+		name = 'CP%d' % codepage
+		emit(name + '_SINGLE_BYTES', '128', single_bytes, 'Codepage %d, the single bytes 0x80-0xFF. The lead bytes are undefined.' % codepage, 'static ')
+		emit(name + '_TABLE', '126*190', table, 'The two byte codes of codepage %d, indexed like GBK_TABLE.' % codepage, 'static ')
+		out.pop()
+		if extra_encodings:
+			out.append('')
+			out.append('// The characters that are not encoded to the first code that is decoded to them.')
+			out.append('static const unsigned short %s_EXTRA_ENCODINGS[][2] =' % name)
+			out.append('{')
+			for i in range(0, len(extra_encodings), 8):
+				out.append('\t' + ', '.join('{ 0x%04X, 0x%04X }' % e for e in extra_encodings[i:i+8]) + ',')
+			out.append('};')
+		out.append('')
+		out.append('const SDoubleByteTable %s_TABLES =' % name)
+		out.append('{')
+		out.append('\t%s_SINGLE_BYTES,' % name)
+		out.append('\t%s_TABLE,' % name)
+		if extra_encodings:
+			out.append('\t%s_EXTRA_ENCODINGS,' % name)
+			out.append('\tsizeof(%s_EXTRA_ENCODINGS)/sizeof(%s_EXTRA_ENCODINGS[0]),' % (name, name))
+		else:
+			out.append('\tNULL,')
+			out.append('\t0,')
+		out.append('};')
+	open(os.path.join(ROOT, 'MultiByteTables.cpp'), 'w', newline='').write('\r\n'.join(out) + '\r\n')
+	print('GB18030_RANGE_COUNT = %d' % len(ranges))
+
+
+main()
@@ -0,0 +1,134 @@
+# Generates SingleByteTables.cpp from the single byte codecs of Python.
+#
+# The charmap codecs of Python (Lib/encodings/cp*.py, iso8859_*.py, mac_*.py, koi8_*.py) are
+# generated by gencodec.py from the unicode.org mapping files:
+#   MAPPINGS/ISO8859/8859-*.TXT, MAPPINGS/VENDORS/MICSFT/WINDOWS/CP*.TXT,
+#   MAPPINGS/VENDORS/MICSFT/PC/CP*.TXT, MAPPINGS/VENDORS/MICSFT/EBCDIC/CP*.TXT,
+#   MAPPINGS/VENDORS/APPLE/*.TXT and the KOI8-R/KOI8-U tables.
+# The Windows codepages are patched to the best fit tables of Windows
+# (https://www.unicode.org/Public/MAPPINGS/VENDORS/MICSFT/WindowsBestFit/bestfit874.txt and
+# bestfit1250.txt-bestfit1258.txt) because MultiByteToWideChar() decodes the bytes that are
+# unassigned in CP*.TXT too.
+# Only the codepages listed by ../EncodingList.h are generated. The output was generated with
+# Python 3.11, run it from any directory: python3 GenSingleByteTables.py
+
+import codecs
+import importlib
+import os
+import re
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+
+# the codepages that don't have a cpNNN codec
+CODEC_NAMES = {
+	20127: 'ascii', 20866: 'koi8_r', 21866: 'koi8_u', 10000: 'mac_roman', 10006: 'mac_greek',
+	10007: 'mac_cyrillic', 10029: 'mac_latin2', 10079: 'mac_iceland', 10081: 'mac_turkish',
+	28591: 'latin_1', 28592: 'iso8859_2', 28593: 'iso8859_3', 28594: 'iso8859_4',
+	28595: 'iso8859_5', 28596: 'iso8859_6', 28597: 'iso8859_7', 28598: 'iso8859_8',
+	28599: 'iso8859_9', 28603: 'iso8859_13', 28605: 'iso8859_15', 38598: 'iso8859_8',
+	20273: 'cp273', 20424: 'cp424',
+}
+
+# bestfit*.txt: the bytes that are unassigned in CP*.TXT and decoded to private use characters
+# or to other characters. The unassigned 0x80-0x9F bytes decode to U+0080-U+009F.
+BEST_FIT_CODEPAGES = [874] + list(range(1250, 1259))
+BEST_FIT_EXTRA = {
+	874: { 0xDB:0xF8C1, 0xDC:0xF8C2, 0xDD:0xF8C3, 0xDE:0xF8C4, 0xFC:0xF8C5, 0xFD:0xF8C6, 0xFE:0xF8C7, 0xFF:0xF8C8 },
+	1253: { 0xAA:0xF8F9, 0xD2:0xF8FA, 0xFF:0xF8FB },
+	1255: { 0xCA:0x05BA, 0xD9:0xF88D, 0xDA:0xF88E, 0xDB:0xF88F, 0xDC:0xF890, 0xDD:0xF891, 0xDE:0xF892,
+			0xDF:0xF893, 0xFB:0xF894, 0xFC:0xF895, 0xFF:0xF896 },
+	1257: { 0xA1:0xF8FC, 0xA5:0xF8FD },
+}
+
+
+def listed_codepages():
+	src = open(os.path.join(ROOT, 'EncodingList.h'), encoding='utf-8').read()
+	return [int(m) for m in re.findall(r'^\s*REGISTER_CODEPAGE\((\d+)', src, re.M)]
+
+
+def codec_name(cp):
+	if cp in CODEC_NAMES:
+		return CODEC_NAMES[cp]
+	for name in ('cp%d' % cp, 'cp%03d' % cp):
+		try:
+			codecs.lookup(name)
+			return name
+		except LookupError:
+			pass
+	return None
+
+
+def is_charmap_codec(name):
+	# skips the multi byte codecs and the ones implemented in C
+	info = codecs.lookup(name)
+	if info.name in ('latin-1', 'iso8859-1', 'ascii'):
+		return True
+	module = importlib.import_module('encodings.' + info.name.replace('-', '_'))
+	return hasattr(module, 'decoding_table')
+
+
+def decode_table(cp, name):
+	table = []
+	for b in range(256):
+		try:
+			s = bytes([b]).decode(name)
+		except UnicodeDecodeError:
+			table.append(0xFFFF)
+			continue
+		if len(s) != 1:
+			return None
+		table.append(ord(s))
+	if cp in BEST_FIT_CODEPAGES:
+		extra = BEST_FIT_EXTRA.get(cp, {})
+		for b in range(0x80, 0x100):
+			if table[b] == 0xFFFF:
+				table[b] = b if b < 0xA0 else extra[b]
+	return table
+
+
+def main():
+	tables = []
+	for cp in sorted(set(listed_codepages())):
+		name = codec_name(cp)
+		if not name or not is_charmap_codec(name):
+			continue
+		table = decode_table(cp, name)
+		if table:
+			tables.append((cp, table))
+
+	out = ['#include "stdafx.h"', '#include "SingleByteCodec.h"', '', '',
+		'// Generated from the unicode.org and vendor mapping files of the codepages. 0xFFFF marks the',
+		'// undefined bytes. The tables of the ASCII based codepages start at byte 0x80. The Windows',
+		'// codepages (874 and 1250-1258) use the best fit tables of Windows instead: MultiByteToWideChar()',
+		'// decodes the unassigned 0x80-0x9F bytes to U+0080-U+009F and a few others to private use chars.',
+		'// See Tools/GenSingleByteTables.py.',
+		'']
+	entries = []
+	for cp, table in tables:
+		ascii_based = table[:128] == list(range(128))
+		data = table[128:] if ascii_based else table
+		out.append('static const unsigned short CP%d_TABLE[%d] =' % (cp, len(data)))
+		out.append('{')
+		for i in range(0, len(data), 16):
+			out.append('\t' + ','.join('0x%04X' % x for x in data[i:i+16]) + ',')
+		out.append('};')
+		out.append('')
+		entries.append((cp, ascii_based))
+	out.append('static const SSingleByteTable SINGLE_BYTE_TABLES[] =')
+	out.append('{')
+	for cp, ascii_based in entries:
+		out.append('\t{ %d, %s, CP%d_TABLE },' % (cp, 'true' if ascii_based else 'false', cp))
+	out += ['};', '',
+		'const SSingleByteTable* FindSingleByteTable(UINT codepage)',
+		'{',
+		'\tfor (size_t i=0; i<sizeof(SINGLE_BYTE_TABLES)/sizeof(SINGLE_BYTE_TABLES[0]); ++i)',
+		'\t{',
+		'\t\tif (SINGLE_BYTE_TABLES[i].codepage == codepage)',
+		'\t\t\treturn &SINGLE_BYTE_TABLES[i];',
+		'\t}',
+		'\treturn NULL;',
+		'}']
+	open(os.path.join(ROOT, 'SingleByteTables.cpp'), 'w', newline='').write('\r\n'.join(out) + '\r\n')
+
+
+main()
@@ -0,0 +1,371 @@
+#include "stdafx.h"
+#include "UTF8.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define USE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+#ifdef USE_SSE2
+
+#ifdef _M_IX86
+// SSE2 is optional on 32 bit x86.
+static bool DetectSSE2()
+{
+	int info[4];
+	__cpuid(info, 1);
+	return (info[3] & (1 << 26)) != 0;
+}
+static const bool g_HasSSE2 = DetectSSE2();
+#else
+static const bool g_HasSSE2 = true;
+#endif
+
+// mask must not be zero
+ILINE static unsigned CountTrailingZeros(unsigned mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return index;
+#else
+	return (unsigned)__builtin_ctz(mask);
+#endif
+}
+
+// Stores 16 ASCII bytes as 16 code units.
+ILINE static void StoreWidened(wchar_t* dst, __m128i bytes)
+{
+	__m128i zero = _mm_setzero_si128();
+	__m128i lo = _mm_unpacklo_epi8(bytes, zero);
+	__m128i hi = _mm_unpackhi_epi8(bytes, zero);
+#if WCHAR_MAX > 0xFFFF
+	_mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi16(lo, zero));
+	_mm_storeu_si128((__m128i*)(dst+4), _mm_unpackhi_epi16(lo, zero));
+	_mm_storeu_si128((__m128i*)(dst+8), _mm_unpacklo_epi16(hi, zero));
+	_mm_storeu_si128((__m128i*)(dst+12), _mm_unpackhi_epi16(hi, zero));
+#else
+	_mm_storeu_si128((__m128i*)dst, lo);
+	_mm_storeu_si128((__m128i*)(dst+8), hi);
+#endif
+}
+
+// Packs 16 code units to bytes if all of them are ASCII, returns false otherwise.
+ILINE static bool LoadNarrowed(const wchar_t* s, __m128i& bytes)
+{
+	__m128i zero = _mm_setzero_si128();
+#if WCHAR_MAX > 0xFFFF
+	__m128i a = _mm_loadu_si128((const __m128i*)s);
+	__m128i b = _mm_loadu_si128((const __m128i*)(s+4));
+	__m128i c = _mm_loadu_si128((const __m128i*)(s+8));
+	__m128i d = _mm_loadu_si128((const __m128i*)(s+12));
+	__m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+	if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(any, _mm_set1_epi32(~0x7F)), zero)) != 0xFFFF)
+		return false;
+	bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+#else
+	__m128i a = _mm_loadu_si128((const __m128i*)s);
+	__m128i b = _mm_loadu_si128((const __m128i*)(s+8));
+	__m128i any = _mm_or_si128(a, b);
+	if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(any, _mm_set1_epi16((short)0xFF80)), zero)) != 0xFFFF)
+		return false;
+	bytes = _mm_packus_epi16(a, b);
+#endif
+	return true;
+}
+
+#endif // USE_SSE2
+
+// Returns the number of ASCII bytes at the beginning of the text.
+ILINE static size_t CountASCII(const unsigned char* s, const unsigned char* s_end)
+{
+	const unsigned char* p = s;
+#ifdef USE_SSE2
+	if (g_HasSSE2)
+	{
+		for (; s_end-p>=16; p+=16)
+		{
+			int mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)p));
+			if (mask)
+				return (p - s) + CountTrailingZeros((unsigned)mask);
+		}
+	}
+#endif
+	while (p<s_end && *p<0x80)
+		++p;
+	return p - s;
+}
+
+// Decodes the sequence of a non-ASCII lead byte. Returns its length, zero if it is invalid.
+ILINE static size_t DecodeSequence(const unsigned char* s, const unsigned char* s_end, unsigned& code)
+{
+	unsigned c = s[0];
+	size_t len;
+	unsigned min_code;
+	if (c>=0xC2 && c<0xE0)
+	{
+		len = 2;
+		min_code = 0x80;
+		c &= 0x1F;
+	}
+	else if (c>=0xE0 && c<0xF0)
+	{
+		len = 3;
+		min_code = 0x800;
+		c &= 0x0F;
+	}
+	else if (c>=0xF0 && c<0xF5)
+	{
+		len = 4;
+		min_code = 0x10000;
+		c &= 0x07;
+	}
+	else
+	{
+		return 0;
+	}
+	if ((size_t)(s_end-s) < len)
+		return 0;
+	for (size_t i=1; i<len; ++i)
+	{
+		if ((s[i] & 0xC0) != 0x80)
+			return 0;
+		c = (c << 6) | (s[i] & 0x3F);
+	}
+	if (c<min_code || (c>=0xD800 && c<0xE000) || c>0x10FFFF)
+		return 0;
+	code = c;
+	return len;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// UTF-8 to UTF-16
+//-------------------------------------------------------------------------------------------------
+
+
+const char* ValidateUTF8(const char* s_begin, const char* s_end, size_t* utf16_length)
+{
+	const unsigned char* s = (const unsigned char*)s_begin;
+	const unsigned char* e = (const unsigned char*)s_end;
+	size_t length = 0;
+	const char* invalid = s_end;
+	while (s < e)
+	{
+		size_t ascii = CountASCII(s, e);
+		s += ascii;
+		length += ascii;
+		if (s >= e)
+			break;
+		unsigned code;
+		size_t len = DecodeSequence(s, e, code);
+		if (!len)
+		{
+			invalid = (const char*)s;
+			break;
+		}
+		s += len;
+		length += code>=0x10000 ? 2 : 1;
+	}
+	if (utf16_length)
+		*utf16_length = length;
+	return invalid;
+}
+
+const char* UTF8ToUTF16(const char* s_begin, const char* s_end, wchar_t*& dst)
+{
+	const unsigned char* s = (const unsigned char*)s_begin;
+	const unsigned char* e = (const unsigned char*)s_end;
+	while (s < e)
+	{
+		size_t ascii = WidenASCII((const char*)s, s_end, dst);
+		s += ascii;
+		dst += ascii;
+		if (s >= e)
+			break;
+
+		unsigned code;
+		size_t len = DecodeSequence(s, e, code);
+		if (!len)
+			return (const char*)s;
+		s += len;
+		if (code >= 0x10000)
+		{
+			code -= 0x10000;
+			dst[0] = (wchar_t)(0xD800 | (code >> 10));
+			dst[1] = (wchar_t)(0xDC00 | (code & 0x3FF));
+			dst += 2;
+		}
+		else
+		{
+			*dst++ = (wchar_t)code;
+		}
+	}
+	return s_end;
+}
+
+void AppendUTF8ToUTF16(wstring& str, const char* s_begin, const char* s_end)
+{
+	size_t length;
+	ValidateUTF8(s_begin, s_end, &length);
+	if (!length)
+		return;
+	size_t size = str.size();
+	str.resize(size + length);
+	wchar_t* dst = &str[size];
+	UTF8ToUTF16(s_begin, s_end, dst);
+}
+
+wstring InvalidUTF8Message(ULONGLONG byte_offset)
+{
+	wchar_t buf[0x100];
+	swprintf(buf, sizeof(buf)/sizeof(buf[0]), L"Error decoding to UTF-16 with the specified encoding! Invalid UTF-8 sequence at byte offset %llu.", byte_offset);
+	return buf;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// UTF-16 to UTF-8
+//-------------------------------------------------------------------------------------------------
+
+
+// Returns the code point at s and sets len to the number of code units it takes.
+ILINE static unsigned ReadCodePoint(const wchar_t* s, const wchar_t* s_end, size_t& len)
+{
+	unsigned c = (unsigned)s[0];
+	len = 1;
+	if (c>=0xD800 && c<0xE000)
+	{
+		if (c<0xDC00 && s+1<s_end && ((unsigned)s[1]&~0x3FFu)==0xDC00)
+		{
+			len = 2;
+			return 0x10000 + ((c & 0x3FF) << 10) + ((unsigned)s[1] & 0x3FF);
+		}
+		return 0xFFFD;
+	}
+	return c;
+}
+
+size_t GetUTF8Length(const wchar_t* s_begin, const wchar_t* s_end)
+{
+	const wchar_t* s = s_begin;
+	size_t length = 0;
+	while (s < s_end)
+	{
+#ifdef USE_SSE2
+		if (g_HasSSE2)
+		{
+			__m128i bytes;
+			for (; s_end-s>=16 && LoadNarrowed(s, bytes); s+=16)
+				length += 16;
+			if (s >= s_end)
+				break;
+		}
+#endif
+		size_t len;
+		unsigned c = ReadCodePoint(s, s_end, len);
+		s += len;
+		length += c<0x80 ? 1 : (c<0x800 ? 2 : (c<0x10000 ? 3 : 4));
+	}
+	return length;
+}
+
+char* UTF16ToUTF8(const wchar_t* s_begin, const wchar_t* s_end, char* dst)
+{
+	const wchar_t* s = s_begin;
+	unsigned char* d = (unsigned char*)dst;
+	while (s < s_end)
+	{
+		size_t ascii = NarrowASCII(s, s_end, (char*)d);
+		s += ascii;
+		d += ascii;
+		if (s >= s_end)
+			break;
+		size_t len;
+		unsigned c = ReadCodePoint(s, s_end, len);
+		s += len;
+		if (c < 0x80)
+		{
+			*d++ = (unsigned char)c;
+		}
+		else if (c < 0x800)
+		{
+			d[0] = (unsigned char)(0xC0 | (c >> 6));
+			d[1] = (unsigned char)(0x80 | (c & 0x3F));
+			d += 2;
+		}
+		else if (c < 0x10000)
+		{
+			d[0] = (unsigned char)(0xE0 | (c >> 12));
+			d[1] = (unsigned char)(0x80 | ((c >> 6) & 0x3F));
+			d[2] = (unsigned char)(0x80 | (c & 0x3F));
+			d += 3;
+		}
+		else
+		{
+			d[0] = (unsigned char)(0xF0 | (c >> 18));
+			d[1] = (unsigned char)(0x80 | ((c >> 12) & 0x3F));
+			d[2] = (unsigned char)(0x80 | ((c >> 6) & 0x3F));
+			d[3] = (unsigned char)(0x80 | (c & 0x3F));
+			d += 4;
+		}
+	}
+	return (char*)d;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// ASCII runs
+//-------------------------------------------------------------------------------------------------
+
+
+size_t WidenASCII(const char* s_begin, const char* s_end, wchar_t* dst)
+{
+	const unsigned char* s = (const unsigned char*)s_begin;
+	const unsigned char* e = (const unsigned char*)s_end;
+	size_t ascii = 0;
+#ifdef USE_SSE2
+	if (g_HasSSE2)
+	{
+		for (; e-s>=16; s+=16,dst+=16)
+		{
+			__m128i bytes = _mm_loadu_si128((const __m128i*)s);
+			int mask = _mm_movemask_epi8(bytes);
+			if (mask)
+			{
+				ascii = CountTrailingZeros((unsigned)mask);
+				break;
+			}
+			StoreWidened(dst, bytes);
+		}
+	}
+#endif
+	if (!ascii)
+	{
+		while (s+ascii<e && s[ascii]<0x80)
+			++ascii;
+	}
+	for (size_t i=0; i<ascii; ++i)
+		dst[i] = (wchar_t)s[i];
+	return (const char*)s - s_begin + ascii;
+}
+
+size_t NarrowASCII(const wchar_t* s_begin, const wchar_t* s_end, char* dst)
+{
+	const wchar_t* s = s_begin;
+#ifdef USE_SSE2
+	if (g_HasSSE2)
+	{
+		__m128i bytes;
+		for (; s_end-s>=16 && LoadNarrowed(s, bytes); s+=16,dst+=16)
+			_mm_storeu_si128((__m128i*)dst, bytes);
+	}
+#endif
+	for (; s<s_end && (unsigned)*s<0x80; ++s,++dst)
+		*dst = (char)*s;
+	return s - s_begin;
+}
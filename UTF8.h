@@ -0,0 +1,31 @@
+#pragma once
+
+
+// Validating UTF-8 <-> UTF-16 conversion of the UTF-8 encoding. The same sequences are invalid
+// as for MultiByteToWideChar() with MB_ERR_INVALID_CHARS: overlong forms, encoded surrogates,
+// codes above U+10FFFF and truncated sequences. The runs of ASCII characters are converted
+// 16 at a time with SSE2 where it is available, the other characters one by one.
+
+// Returns the first byte of the first invalid sequence, s_end if the whole text is valid.
+// utf16_length receives the number of UTF-16 units of the valid part if it isn't NULL.
+const char* ValidateUTF8(const char* s_begin, const char* s_end, size_t* utf16_length=NULL);
+// Converts the text up to the first invalid sequence and returns that sequence, s_end if the
+// whole text is valid. dst must have room for the units counted by ValidateUTF8() or for one
+// unit per byte, it is moved past the written units.
+const char* UTF8ToUTF16(const char* s_begin, const char* s_end, wchar_t*& dst);
+// Appends the UTF-16 form of valid UTF-8 text to str.
+void AppendUTF8ToUTF16(wstring& str, const char* s_begin, const char* s_end);
+// The decoding error message of an invalid sequence at the specified offset.
+wstring InvalidUTF8Message(ULONGLONG byte_offset);
+
+// Returns the number of bytes of the UTF-8 form of the UTF-16 text.
+size_t GetUTF8Length(const wchar_t* s_begin, const wchar_t* s_end);
+// Converts the UTF-16 text, dst must have room for GetUTF8Length() bytes. The unpaired
+// surrogates are written as U+FFFD like WideCharToMultiByte() does. Returns the end of the
+// written bytes.
+char* UTF16ToUTF8(const wchar_t* s_begin, const wchar_t* s_end, char* dst);
+
+// Convert the run of ASCII characters at the beginning of the text and return its length.
+// Also used by the other ASCII based codecs.
+size_t WidenASCII(const char* s_begin, const char* s_end, wchar_t* dst);
+size_t NarrowASCII(const wchar_t* s_begin, const wchar_t* s_end, char* dst);
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "Vcproj.h"
 #include "VcprojParser.h"
+#include "VcprojChecker.h"
 
 
 //-------------------------------------------------------------------------------------------------
@@ -16,72 +17,45 @@
 class CXsdChoiceStrictOrdering
 {
 public:
-	static const CXsdChoiceStrictOrdering& GetInstance() { return g_Instance; }
 	// Returns false if the elements are not present in the same <xs:choice/> block in the xsd,
 	// fills in the e1_less_e2 parameter with the result of e1<e2 otherwise.
-	bool AreElementsRelated(const wchar_t* e1, const wchar_t* e2, bool& e1_less_e2) const;
-
-private:
-	void AddXsdChoiceGroup(const wchar_t* group[], int group_size);
-	CXsdChoiceStrictOrdering();
-
-private:
-	typedef std::map<wstring, bool> TLessE2Map;
-	typedef std::map<wstring, TLessE2Map> TE1LessE2Map;
-	TE1LessE2Map m_E1LessE2;
-	static const CXsdChoiceStrictOrdering g_Instance;
+	static bool AreElementsRelated(const wchar_t* e1, const wchar_t* e2, bool& e1_less_e2);
 };
-const CXsdChoiceStrictOrdering CXsdChoiceStrictOrdering::g_Instance;
 
-bool CXsdChoiceStrictOrdering::AreElementsRelated(const wchar_t* e1, const wchar_t* e2, bool& e1_less_e2) const
+// Each line defines a list of element names that are grouped together in an <xs:choice/> definitoin.
+// The table is small enough to be searched linearly, it needs no initialization.
+static const wchar_t* const XSD_CHOICE_DEFINITIONS[] =
 {
-	TE1LessE2Map::const_iterator it = m_E1LessE2.find(e1);
-	if (it == m_E1LessE2.end())
-		return false;
-	TLessE2Map::const_iterator it2 = it->second.find(e2);
-	if (it2 == it->second.end())
-		return false;
-	e1_less_e2 = it2->second;
-	return true;
-}
+	L"AssemblyReference", L"ActiveXReference", L"ProjectReference", NULL,
+	L"DefaultToolFile", L"ToolFile", NULL,
+	L"File", L"FileConfiguration", NULL,
+	L"Filter", L"File", NULL,
+	NULL,
+};
 
-void CXsdChoiceStrictOrdering::AddXsdChoiceGroup(const wchar_t* group[], int group_size)
+bool CXsdChoiceStrictOrdering::AreElementsRelated(const wchar_t* e1, const wchar_t* e2, bool& e1_less_e2)
 {
-	for (int i=0; i<group_size; ++i)
+	const wchar_t* const* group_begin = XSD_CHOICE_DEFINITIONS;
+	while (group_begin[0])
 	{
-		const wchar_t* e1 = group[i];
-		TLessE2Map& other_elements = m_E1LessE2[e1];
-		for (int j=0; j<group_size; ++j)
+		int e1_index = -1;
+		int e2_index = -1;
+		const wchar_t* const* group_end = group_begin;
+		for (; group_end[0]; ++group_end)
 		{
-			if (i == j)
-				continue;
-			const wchar_t* e2 = group[j];
-			other_elements[e2] = i < j;
+			if (0 == wcscmp(group_end[0], e1))
+				e1_index = (int)(group_end - group_begin);
+			else if (0 == wcscmp(group_end[0], e2))
+				e2_index = (int)(group_end - group_begin);
+		}
+		if (e1_index>=0 && e2_index>=0)
+		{
+			e1_less_e2 = e1_index < e2_index;
+			return true;
 		}
-	}
-}
-
-CXsdChoiceStrictOrdering::CXsdChoiceStrictOrdering()
-{
-	// Each line defines a list of element names that are grouped together in an <xs:choice/> definitoin.
-	static const wchar_t* XSD_CHOICE_DEFINITIONS[] =
-	{
-		L"AssemblyReference", L"ActiveXReference", L"ProjectReference", NULL,
-		L"DefaultToolFile", L"ToolFile", NULL,
-		L"File", L"FileConfiguration", NULL,
-		L"Filter", L"File", NULL,
-		NULL,
-	};
-
-	const wchar_t** group_begin = XSD_CHOICE_DEFINITIONS;
-	while (group_begin[0])
-	{
-		const wchar_t** group_end = group_begin + 1;
-		while (group_end[0])
-			++group_end;
-		AddXsdChoiceGroup(group_begin, (int)(group_end-group_begin));
 		group_begin = group_end + 1;
 	}
+	return false;
 }
 
 
@@ -90,7 +64,9 @@ CXsdChoiceStrictOrdering::CXsdChoiceStrictOrdering()
 //-------------------------------------------------------------------------------------------------
 
 
-static void StringToXmlValue(wstring& t, const wchar_t* s_begin, const wchar_t* s_end, const CXmlCharacterReferenceMap& crm)
+// TOutput is a wstring or a CXmlTextWriter.
+template <typename TOutput>
+static void AppendXmlValue(TOutput& t, const wchar_t* s_begin, const wchar_t* s_end, const CXmlCharacterReferenceMap& crm)
 {
 	for (const wchar_t* s=s_begin; s<s_end; ++s)
 	{
@@ -168,23 +144,41 @@ static void StringToXmlValue(wstring& t, const wchar_t* s_begin, const wchar_t*
 	}
 }
 
-void SXmlAttrib::ToString(wstring& s, const CXmlCharacterReferenceMap& crm) const
+void StringToXmlValue(wstring& t, const wchar_t* s_begin, const wchar_t* s_end, const CXmlCharacterReferenceMap& crm)
+{
+	AppendXmlValue(t, s_begin, s_end, crm);
+}
+
+void StringToXmlValue(CXmlTextWriter& t, const wchar_t* s_begin, const wchar_t* s_end, const CXmlCharacterReferenceMap& crm)
+{
+	AppendXmlValue(t, s_begin, s_end, crm);
+}
+
+void SXmlAttrib::Write(CXmlTextWriter& s, const CXmlCharacterReferenceMap& crm) const
 {
 	s.append(name);
 	s.append(L"=\"");
-	StringToXmlValue(s, value.data(), value.data()+value.size(), crm);
+	if (verbatim_map == &crm)
+		s.append(value);
+	else
+		StringToXmlValue(s, value.data(), value.data()+value.size(), crm);
 	s.push_back('"');
 }
 
-int SXmlAttrib::Compare(const SXmlAttrib& other) const
+int CompareXmlAttribs(const wstring& name1, const wstring& value1, const wstring& name2, const wstring& value2)
 {
-	if (name == other.name)
-		return value.compare(other.value);
-	if (name == L"Name")
+	if (name1 == name2)
+		return value1.compare(value2);
+	if (name1 == L"Name")
 		return -1;
-	if (other.name == L"Name")
+	if (name2 == L"Name")
 		return 1;
-	return name.compare(other.name);
+	return name1.compare(name2);
+}
+
+int SXmlAttrib::Compare(const SXmlAttrib& other) const
+{
+	return CompareXmlAttribs(name, value, other.name, other.value);
 }
 
 struct SXmlAttribPtr_less
@@ -201,7 +195,7 @@ struct SXmlAttribPtr_less
 //-------------------------------------------------------------------------------------------------
 
 
-void SXmlElement::ToString(wstring& s, const CXmlCharacterReferenceMap& crm, const wchar_t* newline, int indent) const
+void SXmlElement::Write(CXmlTextWriter& s, const CXmlCharacterReferenceMap& crm, const wchar_t* newline, int indent) const
 {
 	wstring indent_str(indent, L'\t');
 	s.append(indent_str);
@@ -213,7 +207,7 @@ void SXmlElement::ToString(wstring& s, const CXmlCharacterReferenceMap& crm, con
 		if (attributes.size() == 1)
 		{
 			s.push_back(L' ');
-			attributes[0]->ToString(s, crm);
+			attributes[0]->Write(s, crm);
 		}
 		else
 		{
@@ -222,7 +216,7 @@ void SXmlElement::ToString(wstring& s, const CXmlCharacterReferenceMap& crm, con
 			s.append(indent_str2);
 			for (TXmlAttribPtrVec::const_iterator it=attributes.begin(),eit=attributes.end(); it!=eit; ++it)
 			{
-				(*it)->ToString(s, crm);
+				(*it)->Write(s, crm);
 				s.append(newline);
 				s.append(indent_str2);
 			}
@@ -239,7 +233,7 @@ void SXmlElement::ToString(wstring& s, const CXmlCharacterReferenceMap& crm, con
 		s.append(L">");
 		s.append(newline);
 		for (TXmlElementPtrVec::const_iterator it=children.begin(),eit=children.end(); it!=eit; ++it)
-			(*it)->ToString(s, crm, newline, indent+1);
+			(*it)->Write(s, crm, newline, indent+1);
 		s.append(indent_str);
 		s.append(L"</");
 		s.append(name);
@@ -248,17 +242,36 @@ void SXmlElement::ToString(wstring& s, const CXmlCharacterReferenceMap& crm, con
 	}
 }
 
-int SXmlElement::Compare(const SXmlElement& other) const
+bool AreSiblingsSortedTogether(const wstring& e1, const wstring& e2)
+{
+	// We allow sorting consequent elements with the same name, this handles the <xs:sequence/> nodes of the vcproj xsd.
+	if (e1 == e2)
+		return true;
+	// We allow sorting of consequent elements with different names only if their names are declared with <xs:choice/> in the vcproj xsd.
+	bool tmp;
+	return CXsdChoiceStrictOrdering::AreElementsRelated(e1.c_str(), e2.c_str(), tmp);
+}
+
+static size_t AttribCount(const SXmlElement& e)							{ return e.attributes.size(); }
+static const wstring& AttribName(const SXmlElement& e, size_t i)		{ return e.attributes[i]->name; }
+static const wstring& AttribValue(const SXmlElement& e, size_t i)		{ return e.attributes[i]->value; }
+static size_t AttribCount(const SXmlElementKey& e)						{ return e.attrib_names.size(); }
+static const wstring& AttribName(const SXmlElementKey& e, size_t i)		{ return e.attrib_names[i]; }
+static const wstring& AttribValue(const SXmlElementKey& e, size_t i)	{ return e.attrib_values[i]; }
+
+// Works with both SXmlElement and SXmlElementKey.
+template <typename TElement>
+static int CompareXmlElements(const TElement& e1, const TElement& e2)
 {
-	int cmp_name = name.compare(other.name);
+	int cmp_name = e1.name.compare(e2.name);
 	if (cmp_name == 0)
 	{
-		size_t size_1 = attributes.size();
-		size_t size_2 = other.attributes.size();
+		size_t size_1 = AttribCount(e1);
+		size_t size_2 = AttribCount(e2);
 		size_t attrib_count = min(size_1, size_2);
 		for (size_t i=0; i<attrib_count; ++i)
 		{
-			if (int res = attributes[i]->Compare(*other.attributes[i]))
+			if (int res = CompareXmlAttribs(AttribName(e1, i), AttribValue(e1, i), AttribName(e2, i), AttribValue(e2, i)))
 				return res;
 		}
 		if (size_1 < size_2)
@@ -270,7 +283,7 @@ int SXmlElement::Compare(const SXmlElement& other) const
 	else
 	{
 		bool cmp_xsd_choice_members;
-		bool exchangeable = CXsdChoiceStrictOrdering::GetInstance().AreElementsRelated(name.c_str(), other.name.c_str(), cmp_xsd_choice_members);
+		bool exchangeable = CXsdChoiceStrictOrdering::AreElementsRelated(e1.name.c_str(), e2.name.c_str(), cmp_xsd_choice_members);
 		if (exchangeable)
 			return cmp_xsd_choice_members ? -1 : 1;
 		assert(0);
@@ -278,6 +291,16 @@ int SXmlElement::Compare(const SXmlElement& other) const
 	}
 }
 
+int SXmlElement::Compare(const SXmlElement& other) const
+{
+	return CompareXmlElements(*this, other);
+}
+
+int SXmlElementKey::Compare(const SXmlElementKey& other) const
+{
+	return CompareXmlElements(*this, other);
+}
+
 struct SXmlElementPtr_less
 {
 	bool operator()(const TXmlElementPtr& e1, const TXmlElementPtr& e2) const
@@ -298,17 +321,7 @@ void SXmlElement::SortChildElements()
 	{
 		bool do_sort = last == count;
 		if (!do_sort)
-		{
-			// We allow sorting consequent elements with the same name, this handles the <xs:sequence/> nodes of the vcproj xsd.
-			if (children[first]->name != children[last]->name)
-			{
-				// We allow sorting of consequent elements with different names only if their names are declared with <xs:choice/> in the vcproj xsd.
-				const wchar_t* e1 = children[first]->name.c_str();
-				const wchar_t* e2 = children[last]->name.c_str();
-				bool tmp;
-				do_sort = !CXsdChoiceStrictOrdering::GetInstance().AreElementsRelated(e1, e2, tmp);
-			}
-		}
+			do_sort = !AreSiblingsSortedTogether(children[first]->name, children[last]->name);
 
 		if (do_sort)
 		{
@@ -333,53 +346,172 @@ void SXmlElement::SortSubTree()
 //-------------------------------------------------------------------------------------------------
 
 
+// Smaller files are read because mapping them costs more than copying their data.
+static const size_t MIN_MAPPED_FILE_SIZE = 0x10000;
+// WriteFile() works with DWORD sizes so big files are written in chunks.
+static const size_t MAX_WRITE_CHUNK_SIZE = 0x40000000;
+
+
 CVcprojFile::CVcprojFile()
 : m_NewLineMode(eNLM_Last)
 , m_Encoding(NULL)
+, m_LoadedBegin(NULL)
+, m_LoadedSize(0)
+, m_EncodedDataUnchanged(false)
+, m_DataHash(0)
 {
 }
 
-bool CVcprojFile::LoadVcprojFile(const wchar_t* filepath, ENewLineMode newline_mode)
+bool CVcprojFile::OpenFileData(const wchar_t* filepath)
 {
-	m_ErrorMessage.clear();
-
-	SWinHandle handle = CreateFile(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
+	ReleaseLoadedData();
+	SWinHandle handle = CreateFile(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
 	if (handle == INVALID_HANDLE_VALUE)
 		return WinError(L"Error opening file!");
 	LARGE_INTEGER file_size;
 	if (!GetFileSizeEx(handle, &file_size))
 		return WinError(L"Error retrieving file size!");
-	if (file_size.HighPart || file_size.LowPart>=0x80000000)
-		return Error(L"File is too big!");
+	if ((ULONGLONG)file_size.QuadPart > (size_t)-1)
+		return Error(L"File is too big for the address space!");
+	if (!file_size.QuadPart)
+		return true;
 
-	std::vector<char> buf;
-	buf.resize(file_size.LowPart);
+	// the files that don't fit in a single ReadFile() call are always mapped
+	if ((ULONGLONG)file_size.QuadPart >= MIN_MAPPED_FILE_SIZE)
+	{
+		if (!m_LoadedView.Map(handle, (size_t)file_size.QuadPart))
+			return WinError(L"Error mapping file!");
+		m_LoadedBegin = m_LoadedView.data;
+		m_LoadedSize = m_LoadedView.size;
+		return true;
+	}
 
+	std::vector<char>& buf = m_LoadedData;
+	buf.resize(file_size.LowPart);
 	DWORD read;
 	if (!ReadFile(handle, &buf[0], file_size.LowPart, &read, NULL) || read!=file_size.LowPart)
 		return WinError(L"Error reading file!");
-	handle.Close();
+	m_LoadedBegin = &buf[0];
+	m_LoadedSize = buf.size();
+	return true;
+}
 
-	CXmlTextCodec decoder;
-	if (!decoder.DecodeXmlFileData(&buf[0], (int)file_size.LowPart))
-		return Error(decoder.GetErrorMessage().c_str());
+void CVcprojFile::ReleaseLoadedData()
+{
+	m_LoadedView.Close();
+	std::vector<char>().swap(m_LoadedData);
+	m_LoadedBegin = NULL;
+	m_LoadedSize = 0;
+}
 
-	CVcprojParser parser;
-	const wstring& xml_body = decoder.GetXmlBody();
-	m_Root = parser.Parse(xml_body.data(), xml_body.data()+xml_body.size());
-	if (!m_Root)
+bool CVcprojFile::LoadVcprojFile(const wchar_t* filepath, ENewLineMode newline_mode)
+{
+	m_ErrorMessage.clear();
+	if (!OpenFileData(filepath))
+		return false;
+	return LoadVcprojBytes(newline_mode);
+}
+
+bool CVcprojFile::LoadVcprojData(std::vector<char>& data, ENewLineMode newline_mode)
+{
+	m_ErrorMessage.clear();
+	ReleaseLoadedData();
+	m_LoadedData.swap(data);
+	if (!m_LoadedData.empty())
 	{
-		wstring error_message;
-		SXmlFileCursor file_pos;
-		parser.GetError(error_message, file_pos);
-		return Error(L"[line=%d, column=%d] %s", file_pos.line+1, file_pos.column+1, error_message.c_str());
+		m_LoadedBegin = &m_LoadedData[0];
+		m_LoadedSize = m_LoadedData.size();
 	}
+	return LoadVcprojBytes(newline_mode);
+}
+
+bool CVcprojFile::LoadVcprojBytes(ENewLineMode newline_mode)
+{
+	if (!m_LoadedSize)
+		return Error(L"The file is empty!");
+	m_DataHash = HashBytes(m_LoadedBegin, m_LoadedSize);
+
+	// UTF-8 bodies are parsed directly from the loaded bytes, the codepage bodies are parsed
+	// while they are decoded so only a chunk of the decoded text is in memory at once
+	CXmlTextCodec decoder;
+	if (!decoder.DecodeXmlFileData(m_LoadedBegin, m_LoadedSize, true, true))
+		return Error(L"%s", decoder.GetErrorMessage().c_str());
+	// the values that need no escaping in the map of the file are written without escaping
+	// if the file is saved with the same map
+	const CXmlCharacterReferenceMap& crm = CXmlCharacterReferenceMap::Get(decoder.GetEncoding());
+	bool parsed;
+	if (decoder.GetUTF8BodyBegin())
+	{
+		parsed = ParseXmlBody(decoder.GetUTF8BodyBegin(), decoder.GetUTF8BodyEnd(), newline_mode, crm);
+	}
+	else if (decoder.GetEncodedBodyBegin())
+	{
+		CXmlBodyDecoder body_decoder(decoder.GetEncoding(), decoder.GetEncodedBodyBegin(), decoder.GetEncodedBodyEnd(), decoder.GetEncodedBodyBegin()-m_LoadedBegin);
+		parsed = ParseXmlBody(body_decoder, newline_mode, crm);
+	}
+	else
+		parsed = ParseXmlBody(decoder.GetXmlBodyBegin(), decoder.GetXmlBodyEnd(), newline_mode, crm);
+	if (!parsed)
+		return false;
 
 	m_XmlDeclarationAttribs.swap(decoder.GetXmlDeclarationAttributes());
+	m_Encoding = decoder.GetEncoding();
+
+	if (m_Root->name != L"VisualStudioProject")
+		return Error(L"The root element is not \"VisualStudioProject\"!");
+	return true;
+}
+
+template <typename CharType>
+bool CVcprojFile::ParseXmlBody(const CharType* xml_body, const CharType* xml_body_end, ENewLineMode newline_mode, const CXmlCharacterReferenceMap& crm)
+{
+	// the tree owns its strings so the body isn't needed after parsing
+	CVcprojParser<CharType> parser;
+	parser.SetVerbatimMap(&crm);
+	m_Root = parser.Parse(xml_body, xml_body_end);
+	// Parse() passes the reference of its own smart pointer to the caller. Without releasing it
+	// every loaded tree would leak, which matters in the long running -WATCH mode.
+	if (m_Root)
+		m_Root->Release();
+	if (!m_Root)
+		return ParseError(parser);
+	SetLoadedNewLineMode(newline_mode, DetectNewLineMode(xml_body, xml_body_end));
+	return true;
+}
+
+bool CVcprojFile::ParseXmlBody(CXmlBodyDecoder& body_decoder, ENewLineMode newline_mode, const CXmlCharacterReferenceMap& crm)
+{
+	CVcprojParser<wchar_t> parser;
+	parser.SetVerbatimMap(&crm);
+	TXmlElementPtr root = parser.Parse(body_decoder);
+	if (root)
+		root->Release();
+	// An invalid byte sequence is reported even if it comes after a syntax error, like when
+	// the whole body is decoded before parsing.
+	if (!body_decoder.Finish())
+		return Error(L"%s", body_decoder.GetErrorMessage().c_str());
+	m_Root = root;
+	if (!m_Root)
+		return ParseError(parser);
+	SetLoadedNewLineMode(newline_mode, body_decoder.GetNewLineMode());
+	return true;
+}
+
+template <typename CharType>
+bool CVcprojFile::ParseError(const CVcprojParser<CharType>& parser)
+{
+	wstring error_message;
+	SXmlFileCursor file_pos;
+	parser.GetError(error_message, file_pos);
+	return Error(L"[line=%d, column=%d] %s", file_pos.line+1, file_pos.column+1, error_message.c_str());
+}
+
+void CVcprojFile::SetLoadedNewLineMode(ENewLineMode newline_mode, ENewLineMode detected_newline_mode)
+{
 	assert(newline_mode != eNLM_Last);
 	if (newline_mode==eNLM_Auto || newline_mode==eNLM_Last)
 	{
-		m_NewLineMode = DetectNewLineMode(xml_body.data(), xml_body.data()+xml_body.size());
+		m_NewLineMode = detected_newline_mode;
 		if (m_NewLineMode==eNLM_Auto || m_NewLineMode==eNLM_Last)
 			m_NewLineMode = eNLM_CRLF;
 	}
@@ -387,18 +519,12 @@ bool CVcprojFile::LoadVcprojFile(const wchar_t* filepath, ENewLineMode newline_m
 	{
 		m_NewLineMode = newline_mode;
 	}
-	m_Encoding = decoder.GetEncoding();
-
-	if (m_Root->name != L"VisualStudioProject")
-		return Error(L"The root element is not \"VisualStudioProject\"!");
-	return true;
 }
 
-bool CVcprojFile::SaveVcprojFile(const wchar_t* filepath, DWORD file_attributes, bool safe_encoding)
+bool CVcprojFile::WriteVcproj(IXmlByteSink& sink, bool safe_encoding)
 {
 	assert(m_NewLineMode!=eNLM_Auto && m_NewLineMode!=eNLM_Last);
 	assert(m_Encoding);
-	m_ErrorMessage.clear();
 	if (!m_Root)
 		return Error(L"No vcproj data to save!");
 	if (m_NewLineMode==eNLM_Auto || m_NewLineMode==eNLM_Last)
@@ -406,24 +532,215 @@ bool CVcprojFile::SaveVcprojFile(const wchar_t* filepath, DWORD file_attributes,
 	if (!m_Encoding)
 		return Error(L"Can't save vcproj without an encoding!");
 
-	CXmlCharacterReferenceMap crm;
-	crm.SetEncoding(m_Encoding, safe_encoding);
+	const CXmlCharacterReferenceMap& crm = CXmlCharacterReferenceMap::Get(m_Encoding, safe_encoding);
+
+	CXmlTextWriter writer(m_Encoding, &sink);
+	writer.WriteXmlDeclaration(m_XmlDeclarationAttribs, m_NewLineMode);
+	m_Root->Write(writer, crm, ToString(m_NewLineMode));
+	if (!writer.Finish())
+		return Error(L"%s", writer.GetErrorMessage().c_str());
+	return true;
+}
+
+// Collects the encoded document in memory.
+class CVcprojMemorySink : public IXmlByteSink
+{
+public:
+	CVcprojMemorySink(std::vector<char>& data) : m_Data(data) {}
+	virtual bool WriteBytes(const char* data, size_t size, wstring& error_message)
+	{
+		m_Data.insert(m_Data.end(), data, data+size);
+		return true;
+	}
+
+private:
+	std::vector<char>& m_Data;
+};
+
+bool CVcprojFile::EncodeVcprojData(bool safe_encoding, std::vector<char>& data)
+{
+	m_ErrorMessage.clear();
+	m_EncodedDataUnchanged = false;
+	data.clear();
+	CVcprojMemorySink sink(data);
+	bool res = WriteVcproj(sink, safe_encoding);
+	if (res)
+	{
+		m_EncodedDataUnchanged = data.size()==m_LoadedSize && (data.empty() || !memcmp(&data[0], m_LoadedBegin, data.size()));
+		m_DataHash = HashBytes(data.empty() ? NULL : &data[0], data.size());
+	}
+	ReleaseLoadedData();
+	return res;
+}
+
+// Compares the encoded bytes with the loaded data and hashes them. The file is created at the
+// first difference and the identical prefix is copied from the loaded data, so nothing is
+// written if formatting doesn't change the file.
+class CVcprojFileSink : public IXmlByteSink
+{
+public:
+	CVcprojFileSink(const char* loaded, size_t loaded_size, const wchar_t* filepath, DWORD file_attributes)
+		: m_Loaded(loaded), m_LoadedSize(loaded_size), m_FilePath(filepath), m_FileAttributes(file_attributes)
+		, m_Size(0), m_Hash(HashBytes(NULL, 0)), m_Created(false)
+	{}
+
+	virtual bool WriteBytes(const char* data, size_t size, wstring& error_message)
+	{
+		m_Hash = HashBytes(data, size, m_Hash);
+		if (!m_Created && size<=m_LoadedSize-m_Size && 0==memcmp(data, m_Loaded+m_Size, size))
+		{
+			m_Size += size;
+			return true;
+		}
+		if (!m_Created && !Create(error_message))
+			return false;
+		m_Size += size;
+		return Write(data, size, error_message);
+	}
+
+	// Creates the file if the encoded data is a truncated form of the loaded data.
+	bool Finish(wstring& error_message)
+	{
+		if (!m_Created && m_Size!=m_LoadedSize && !Create(error_message))
+			return false;
+		// the data must be on the disk before the file is renamed over the original
+		if (m_Created && !FlushFileBuffers(m_File))
+			return WinError(L"Error flushing file!", error_message);
+		return true;
+	}
+
+	bool IsCreated() const								{ return m_Created; }
+	ULONGLONG GetHash() const							{ return m_Hash; }
 
-	wstring xml_body;
-	m_Root->ToString(xml_body, crm, ToString(m_NewLineMode));
+private:
+	bool Create(wstring& error_message)
+	{
+		m_File = CreateFile(m_FilePath, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, m_FileAttributes, NULL);
+		if (m_File == INVALID_HANDLE_VALUE)
+			return WinError(L"Error opening file for writing!", error_message);
+		m_Created = true;
+		return Write(m_Loaded, m_Size, error_message);
+	}
+
+	bool Write(const char* data, size_t size, wstring& error_message)
+	{
+		while (size)
+		{
+			DWORD chunk_size = (DWORD)min(size, MAX_WRITE_CHUNK_SIZE);
+			DWORD written;
+			if (!WriteFile(m_File, data, chunk_size, &written, NULL) || written!=chunk_size)
+				return WinError(L"Error writing file!", error_message);
+			data += written;
+			size -= written;
+		}
+		return true;
+	}
 
-	std::vector<char> data;
-	if (!CXmlTextCodec::EncodeXmlFileData(m_XmlDeclarationAttribs, xml_body, m_Encoding, m_NewLineMode, data, &m_ErrorMessage))
+	static bool WinError(const wchar_t* message, wstring& error_message)
+	{
+		DWORD last_error = GetLastError();
+		wchar_t buf[0x400];
+		swprintf(buf, sizeof(buf)/sizeof(buf[0]), L"%s [LastError: %d] %s", message, last_error, LastErrorToString(last_error).c_str());
+		error_message = buf;
 		return false;
+	}
 
-	SWinHandle handle = CreateFile(filepath, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, file_attributes, NULL);
-	if (handle == INVALID_HANDLE_VALUE)
-		return WinError(L"Error opening file for writing!");
+private:
+	const char* m_Loaded;
+	size_t m_LoadedSize;
+	const wchar_t* m_FilePath;
+	DWORD m_FileAttributes;
+	SWinHandle m_File;
+	// number of bytes encoded so far
+	size_t m_Size;
+	ULONGLONG m_Hash;
+	bool m_Created;
+};
+
+bool CVcprojFile::SaveVcprojFile(const wchar_t* filepath, DWORD file_attributes, bool safe_encoding)
+{
+	m_ErrorMessage.clear();
+	m_EncodedDataUnchanged = false;
+	CVcprojFileSink sink(m_LoadedBegin, m_LoadedSize, filepath, file_attributes);
+	bool res = WriteVcproj(sink, safe_encoding);
+	if (res && !sink.Finish(m_ErrorMessage))
+		res = false;
+	ReleaseLoadedData();
+	if (!res)
+		return false;
+	m_EncodedDataUnchanged = !sink.IsCreated();
+	m_DataHash = sink.GetHash();
+	return true;
+}
 
-	DWORD written;
-	if (!WriteFile(handle, &data[0], (DWORD)data.size(), &written, NULL) || written!=(DWORD)data.size())
-		return Error(L"Error writing file!");
+bool CVcprojFile::CheckVcprojFile(const wchar_t* filepath, ENewLineMode newline_mode, IEncoding* encoding, bool safe_encoding, wchar_t decimal_point)
+{
+	m_ErrorMessage.clear();
+	if (!OpenFileData(filepath))
+		return false;
+	bool res = CheckVcprojBytes(m_LoadedBegin, m_LoadedSize, newline_mode, encoding, safe_encoding, decimal_point);
+	ReleaseLoadedData();
+	return res;
+}
 
+bool CVcprojFile::CheckVcprojData(const std::vector<char>& buf, ENewLineMode newline_mode, IEncoding* encoding, bool safe_encoding, wchar_t decimal_point)
+{
+	m_ErrorMessage.clear();
+	return CheckVcprojBytes(buf.empty() ? NULL : &buf[0], buf.size(), newline_mode, encoding, safe_encoding, decimal_point);
+}
+
+bool CVcprojFile::CheckVcprojBytes(const char* data, size_t size, ENewLineMode newline_mode, IEncoding* encoding, bool safe_encoding, wchar_t decimal_point)
+{
+	if (!size)
+		return Error(L"The file is empty!");
+	m_DataHash = HashBytes(data, size);
+
+	CXmlTextCodec decoder;
+	if (!decoder.DecodeXmlFileData(data, size, true))
+		return Error(L"%s", decoder.GetErrorMessage().c_str());
+	m_Encoding = decoder.GetEncoding();
+	if (encoding && encoding!=m_Encoding)
+		return Error(L"[line=1, column=1] The encoding is %s instead of %s!", m_Encoding->GetName(0), encoding->GetName(0));
+
+	// the BOM and the xml declaration as written by CXmlTextWriter::WriteXmlDeclaration()
+	SXmlDeclarationAttribs attribs = decoder.GetXmlDeclarationAttributes();
+	attribs.SetAttrib(L"encoding", m_Encoding->GetName(0));
+	wstring xml_declaration = attribs.GetAsXmlDeclaration();
+	size_t bom_size = (size_t)m_Encoding->GetBOMSizeBytes();
+	std::vector<char> prefix;
+	if (!EncodeFromUTF16(m_Encoding, xml_declaration.data(), xml_declaration.size(), prefix, &m_ErrorMessage))
+		return false;
+	if (bom_size)
+		prefix.insert(prefix.begin(), m_Encoding->GetBOM(), m_Encoding->GetBOM()+bom_size);
+	if (size<prefix.size() || memcmp(data, &prefix[0], prefix.size()))
+		return Error(L"[line=1, column=1] The BOM or the xml declaration isn't in canonical form: %s", xml_declaration.c_str());
+
+	if (decoder.GetUTF8BodyBegin())
+		return CheckXmlBody(decoder.GetUTF8BodyBegin(), decoder.GetUTF8BodyEnd(), newline_mode, safe_encoding, decimal_point);
+	return CheckXmlBody(decoder.GetXmlBodyBegin(), decoder.GetXmlBodyEnd(), newline_mode, safe_encoding, decimal_point);
+}
+
+template <typename CharType>
+bool CVcprojFile::CheckXmlBody(const CharType* xml_body, const CharType* xml_body_end, ENewLineMode newline_mode, bool safe_encoding, wchar_t decimal_point)
+{
+	assert(newline_mode != eNLM_Last);
+	if (newline_mode==eNLM_Auto || newline_mode==eNLM_Last)
+	{
+		newline_mode = DetectNewLineMode(xml_body, xml_body_end);
+		if (newline_mode==eNLM_Auto || newline_mode==eNLM_Last)
+			newline_mode = eNLM_CRLF;
+	}
+	m_NewLineMode = newline_mode;
+
+	const CXmlCharacterReferenceMap& crm = CXmlCharacterReferenceMap::Get(m_Encoding, safe_encoding);
+	CVcprojChecker<CharType> checker(crm, newline_mode, decimal_point);
+	if (!checker.Check(xml_body, xml_body_end))
+	{
+		wstring error_message;
+		SXmlFileCursor file_pos;
+		checker.GetError(error_message, file_pos);
+		return Error(L"[line=%d, column=%d] %s", file_pos.line+1, file_pos.column+1, error_message.c_str());
+	}
 	return true;
 }
 
@@ -456,6 +773,7 @@ void CVcprojFile::SetDecimalPoint(wchar_t decimal_point)
 				if (attr.value[i]==',' || attr.value[i]=='.')
 					attr.value[i] = decimal_point;
 			}
+			attr.verbatim_map = NULL;
 			break;
 		}
 	}
@@ -465,7 +783,7 @@ bool CVcprojFile::Error(const wchar_t* fmtstr, ...)
 {
 	if (!m_ErrorMessage.empty())
 		return false;
-	wchar_t buf[0x100];
+	wchar_t buf[0x400];
 	va_list args;
 	va_start(args, fmtstr);
 	vswprintf(buf, sizeof(buf)/sizeof(buf[0]), fmtstr, args);
@@ -479,7 +797,7 @@ bool CVcprojFile::WinError(const wchar_t* fmtstr, ...)
 	if (!m_ErrorMessage.empty())
 		return false;
 	DWORD last_error = GetLastError();
-	wchar_t buf[0x100];
+	wchar_t buf[0x400];
 	va_list args;
 	va_start(args, fmtstr);
 	vswprintf(buf, sizeof(buf)/sizeof(buf[0]), fmtstr, args);
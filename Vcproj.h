@@ -18,11 +18,25 @@ struct SXmlNode : public refcounted
 	SXmlFileCursor file_pos;
 };
 
+// The ordering rules of the canonical form. They are used by the sorting and by the -CHECK verifier.
+int CompareXmlAttribs(const wstring& name1, const wstring& value1, const wstring& name2, const wstring& value2);
+// True if SXmlElement::SortChildElements() sorts the neighboring siblings e1 and e2 together.
+bool AreSiblingsSortedTogether(const wstring& e1, const wstring& e2);
+// Appends the escaped form of the string to t as it is written to the value of an attribute.
+void StringToXmlValue(wstring& t, const wchar_t* s_begin, const wchar_t* s_end, const CXmlCharacterReferenceMap& crm);
+void StringToXmlValue(CXmlTextWriter& t, const wchar_t* s_begin, const wchar_t* s_end, const CXmlCharacterReferenceMap& crm);
+
 struct SXmlAttrib : public SXmlNode
 {
 	wstring value;
+	// Set by the parser if the value is the text of the file without references and it
+	// contains only characters that this map writes as they are. Write() copies the value
+	// without escaping if it gets this map.
+	const CXmlCharacterReferenceMap* verbatim_map;
+
+	SXmlAttrib() : verbatim_map(NULL) {}
 
-	void ToString(wstring& s, const CXmlCharacterReferenceMap& crm) const;
+	void Write(CXmlTextWriter& s, const CXmlCharacterReferenceMap& crm) const;
 	int Compare(const SXmlAttrib& other) const;
 };
 typedef smartptr<SXmlAttrib> TXmlAttribPtr;
@@ -37,26 +51,59 @@ struct SXmlElement : public SXmlNode
 	TXmlAttribPtrVec attributes;
 	TXmlElementPtrVec children;
 
-	void ToString(wstring& s, const CXmlCharacterReferenceMap& crm, const wchar_t* newline=L"\r\n", int indent=0) const;
+	void Write(CXmlTextWriter& s, const CXmlCharacterReferenceMap& crm, const wchar_t* newline=L"\r\n", int indent=0) const;
 	int Compare(const SXmlElement& other) const;
 	void SortAttributes();
 	void SortChildElements();
 	void SortSubTree();
 };
 
+// The name and the attributes of an element without its children. The -CHECK verifier
+// uses this to compare siblings without building the tree.
+struct SXmlElementKey
+{
+	wstring name;
+	std::vector<wstring> attrib_names;
+	std::vector<wstring> attrib_values;
+
+	int Compare(const SXmlElementKey& other) const;
+};
+
 
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 
 
+template <typename CharType> class CVcprojParser;
+
 class CVcprojFile
 {
 public:
 	CVcprojFile();
 
+	// Big files are mapped into memory and decoded directly from the mapping.
 	bool LoadVcprojFile(const wchar_t* filepath, ENewLineMode newline_mode=eNLM_Auto);
+	// Loads the file data from memory, data is swapped into this object.
+	bool LoadVcprojData(std::vector<char>& data, ENewLineMode newline_mode=eNLM_Auto);
+	// Encodes the tree to the file through a bounded buffer. The encoded bytes are compared with
+	// the loaded data and the file is created only at the first difference, IsEncodedDataUnchanged()
+	// tells whether it has been created. Releases the loaded data so the mapping of the original
+	// file doesn't prevent replacing it.
 	bool SaveVcprojFile(const wchar_t* filepath, DWORD file_attributes, bool safe_encoding);
+	// True if SaveVcprojFile() or EncodeVcprojData() found the encoded data byte by byte the same
+	// as the loaded file.
+	bool IsEncodedDataUnchanged() const					{ return m_EncodedDataUnchanged; }
+	// Encodes the tree to memory for the modes that don't write files and for the files that are
+	// written by the commit queue. Releases the loaded data like SaveVcprojFile().
+	bool EncodeVcprojData(bool safe_encoding, std::vector<char>& data);
+	// Checks without building the tree whether formatting would change the file. encoding is NULL
+	// and decimal_point is zero if they are kept. Returns false with the first violation in the
+	// error message if the file isn't in canonical form.
+	bool CheckVcprojFile(const wchar_t* filepath, ENewLineMode newline_mode, IEncoding* encoding, bool safe_encoding, wchar_t decimal_point);
+	bool CheckVcprojData(const std::vector<char>& data, ENewLineMode newline_mode, IEncoding* encoding, bool safe_encoding, wchar_t decimal_point);
 	const wstring& GetErrorMessage() const				{ return m_ErrorMessage; }
+	// Hash of the file data that was loaded, encoded or saved last.
+	ULONGLONG GetDataHash() const						{ return m_DataHash; }
 
 	ENewLineMode GetNewLineMode() const					{ return m_NewLineMode; }
 	void SetNewLineMode(ENewLineMode);
@@ -67,6 +114,23 @@ public:
 	void SetDecimalPoint(wchar_t decimal_point);
 
 private:
+	// Maps the file or reads it to m_LoadedData if it is small, sets m_LoadedBegin and m_LoadedSize.
+	bool OpenFileData(const wchar_t* filepath);
+	void ReleaseLoadedData();
+	bool LoadVcprojBytes(ENewLineMode newline_mode);
+	// CharType is wchar_t for a decoded body and char for a UTF-8 body.
+	template <typename CharType>
+	bool ParseXmlBody(const CharType* xml_body, const CharType* xml_body_end, ENewLineMode newline_mode, const CXmlCharacterReferenceMap& crm);
+	// Parses a codepage body while it is decoded in chunks.
+	bool ParseXmlBody(CXmlBodyDecoder& body_decoder, ENewLineMode newline_mode, const CXmlCharacterReferenceMap& crm);
+	template <typename CharType>
+	bool ParseError(const CVcprojParser<CharType>& parser);
+	// detected_newline_mode is used if newline_mode is eNLM_Auto
+	void SetLoadedNewLineMode(ENewLineMode newline_mode, ENewLineMode detected_newline_mode);
+	bool CheckVcprojBytes(const char* data, size_t size, ENewLineMode newline_mode, IEncoding* encoding, bool safe_encoding, wchar_t decimal_point);
+	template <typename CharType>
+	bool CheckXmlBody(const CharType* xml_body, const CharType* xml_body_end, ENewLineMode newline_mode, bool safe_encoding, wchar_t decimal_point);
+	bool WriteVcproj(IXmlByteSink& sink, bool safe_encoding);
 	bool Error(const wchar_t* fmtstr, ...);
 	bool WinError(const wchar_t* fmtstr, ...);
 
@@ -77,4 +141,11 @@ private:
 	ENewLineMode m_NewLineMode;
 	IEncoding* m_Encoding;
 	TXmlElementPtr m_Root;
+	// the loaded bytes are either in m_LoadedData or in m_LoadedView
+	std::vector<char> m_LoadedData;
+	SMappedFileView m_LoadedView;
+	const char* m_LoadedBegin;
+	size_t m_LoadedSize;
+	bool m_EncodedDataUnchanged;
+	ULONGLONG m_DataHash;
 };
@@ -0,0 +1,285 @@
+#include "stdafx.h"
+#include "VcprojChecker.h"
+#include "UTF8.h"
+
+
+static const size_t MAX_SNIPPET_CHARS = 24;
+
+// Appends the beginning of the text to s with visible newlines and tabs for the error messages.
+static void AppendSnippet(wstring& s, const wchar_t* text, const wchar_t* text_end)
+{
+	if ((size_t)(text_end-text) > MAX_SNIPPET_CHARS)
+		text_end = text + MAX_SNIPPET_CHARS;
+	for (; text<text_end; ++text)
+	{
+		switch (*text)
+		{
+		case L'\r':	s.append(L"\\r"); break;
+		case L'\n':	s.append(L"\\n"); break;
+		case L'\t':	s.append(L"\\t"); break;
+		default:	s.push_back(*text); break;
+		}
+	}
+}
+
+static void AppendSnippet(wstring& s, const char* text, const char* text_end)
+{
+	// decoding only the characters that are shown
+	const char* p = text;
+	for (size_t i=0; i<MAX_SNIPPET_CHARS && p<text_end; ++i)
+	{
+		for (++p; p<text_end && ((unsigned char)*p & 0xC0)==0x80; ++p)
+			;
+	}
+	wstring snippet;
+	AppendUTF8ToUTF16(snippet, text, p);
+	AppendSnippet(s, snippet.data(), snippet.data()+snippet.size());
+}
+
+// Compares the character at text with the beginning of expected. Returns the end of the
+// character and advances expected if they match, returns NULL otherwise.
+static const wchar_t* MatchChar(const wchar_t* text, const wchar_t* text_end, const wchar_t*& expected, const wchar_t* expected_end, wstring& tmp)
+{
+	if (*text != *expected)
+		return NULL;
+	++expected;
+	return text + 1;
+}
+
+static const char* MatchChar(const char* text, const char* text_end, const wchar_t*& expected, const wchar_t* expected_end, wstring& tmp)
+{
+	unsigned char c = (unsigned char)*text;
+	if (c < 0x80)
+	{
+		if ((wchar_t)c != *expected)
+			return NULL;
+		++expected;
+		return text + 1;
+	}
+	// the body has been validated so the length follows from the lead byte
+	size_t len = c<0xE0 ? 2 : (c<0xF0 ? 3 : 4);
+	tmp.clear();
+	AppendUTF8ToUTF16(tmp, text, text+len);
+	if ((size_t)(expected_end-expected)<tmp.size() || tmp.compare(0, tmp.size(), expected, tmp.size()))
+		return NULL;
+	expected += tmp.size();
+	return text + len;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+
+template <typename CharType>
+CVcprojChecker<CharType>::CVcprojChecker(const CXmlCharacterReferenceMap& crm, ENewLineMode newline_mode, wchar_t decimal_point)
+: m_Crm(crm)
+, m_NewLine(ToString(newline_mode))
+, m_DecimalPoint(decimal_point)
+, m_Begin(NULL)
+, m_Pos(NULL)
+, m_Depth(0)
+, m_ErrorPos(NULL)
+{
+	assert(newline_mode!=eNLM_Auto && newline_mode!=eNLM_Last);
+}
+
+template <typename CharType>
+bool CVcprojChecker<CharType>::Check(const CharType* xml_body, const CharType* xml_body_end)
+{
+	m_Begin = xml_body;
+	m_Pos = xml_body;
+	m_Depth = 0;
+	m_Levels.resize(1);
+	m_Levels[0].has_prev = false;
+	m_Error.clear();
+	m_ErrorPos = NULL;
+
+	// the newline after the xml declaration
+	m_Expected = m_NewLine;
+	if (!m_Parser.ParseStream(xml_body, xml_body_end, *this))
+		return false;
+
+	// only the newline after the closing tag of the root can follow
+	m_Expected = m_NewLine;
+	if (!CheckText(xml_body_end))
+		return false;
+	return true;
+}
+
+template <typename CharType>
+void CVcprojChecker<CharType>::GetError(wstring& error_message, SXmlFileCursor& file_pos) const
+{
+	if (m_ErrorPos)
+	{
+		error_message = m_Error;
+		CVcprojParser<CharType>::GetFilePos(m_Begin, m_ErrorPos, file_pos);
+	}
+	else
+	{
+		m_Parser.GetError(error_message, file_pos);
+	}
+}
+
+template <typename CharType>
+bool CVcprojChecker<CharType>::StartTag(const SXmlElementKey& element, bool empty_element, const CharType* tag_begin, const CharType* tag_end)
+{
+	// the newline and indentation before the tag
+	AppendIndent(m_Depth);
+	if (!CheckText(tag_begin))
+		return false;
+	if (!CheckOrder(element, tag_begin))
+		return false;
+
+	m_Expected.push_back(L'<');
+	m_Expected.append(element.name);
+	size_t attrib_count = element.attrib_names.size();
+	if (attrib_count == 1)
+	{
+		m_Expected.push_back(L' ');
+		m_Expected.append(element.attrib_names[0]);
+		m_Expected.append(L"=\"");
+		StringToXmlValue(m_Expected, element.attrib_values[0].data(), element.attrib_values[0].data()+element.attrib_values[0].size(), m_Crm);
+		m_Expected.push_back(L'"');
+	}
+	else if (attrib_count > 1)
+	{
+		m_Expected.append(m_NewLine);
+		AppendIndent(m_Depth+1);
+		for (size_t i=0; i<attrib_count; ++i)
+		{
+			m_Expected.append(element.attrib_names[i]);
+			m_Expected.append(L"=\"");
+			StringToXmlValue(m_Expected, element.attrib_values[i].data(), element.attrib_values[i].data()+element.attrib_values[i].size(), m_Crm);
+			m_Expected.push_back(L'"');
+			m_Expected.append(m_NewLine);
+			AppendIndent(m_Depth+1);
+		}
+	}
+	m_Expected.append(empty_element ? L"/>" : L">");
+	if (!CheckText(tag_end))
+		return false;
+
+	m_Expected = m_NewLine;
+	if (!empty_element)
+	{
+		++m_Depth;
+		if ((int)m_Levels.size() <= m_Depth)
+			m_Levels.resize(m_Depth+1);
+		m_Levels[m_Depth].has_prev = false;
+	}
+	return true;
+}
+
+template <typename CharType>
+bool CVcprojChecker<CharType>::EndTag(const wstring& name, const CharType* tag_begin, const CharType* tag_end)
+{
+	assert(m_Depth > 0);
+	if (!m_Levels[m_Depth].has_prev)
+		return Violation(tag_begin, L"<%s> has no child elements, it should be closed with \"/>\"!", name.c_str());
+	--m_Depth;
+
+	AppendIndent(m_Depth);
+	m_Expected.append(L"</");
+	m_Expected.append(name);
+	m_Expected.push_back(L'>');
+	if (!CheckText(tag_end))
+		return false;
+
+	m_Expected = m_NewLine;
+	return true;
+}
+
+template <typename CharType>
+bool CVcprojChecker<CharType>::CheckOrder(const SXmlElementKey& element, const CharType* tag_begin)
+{
+	if (m_Depth == 0)
+	{
+		if (element.name != L"VisualStudioProject")
+			return Violation(tag_begin, L"The root element is not \"VisualStudioProject\"!");
+		if (m_DecimalPoint)
+		{
+			for (size_t i=0,e=element.attrib_names.size(); i<e; ++i)
+			{
+				if (element.attrib_names[i] != L"Version")
+					continue;
+				const wstring& version = element.attrib_values[i];
+				if (version.find(m_DecimalPoint==L'.' ? L',' : L'.') != wstring::npos)
+					return Violation(tag_begin, L"The decimal point of the version number isn't '%c'!", m_DecimalPoint);
+				break;
+			}
+		}
+	}
+
+	for (size_t i=1,e=element.attrib_names.size(); i<e; ++i)
+	{
+		if (CompareXmlAttribs(element.attrib_names[i], element.attrib_values[i], element.attrib_names[i-1], element.attrib_values[i-1]) < 0)
+		{
+			return Violation(tag_begin, L"Attribute \"%s\" of <%s> should precede attribute \"%s\"!",
+				element.attrib_names[i].c_str(), element.name.c_str(), element.attrib_names[i-1].c_str());
+		}
+	}
+
+	// the same runs of siblings as the ones sorted by SXmlElement::SortChildElements()
+	SLevel& level = m_Levels[m_Depth];
+	if (!level.has_prev || !AreSiblingsSortedTogether(level.run_first, element.name))
+	{
+		level.run_first = element.name;
+	}
+	else if (element.Compare(level.prev) < 0)
+	{
+		return Violation(tag_begin, L"<%s> should precede its previous sibling <%s>!",
+			element.name.c_str(), level.prev.name.c_str());
+	}
+	level.prev = element;
+	level.has_prev = true;
+	return true;
+}
+
+template <typename CharType>
+void CVcprojChecker<CharType>::AppendIndent(int depth)
+{
+	m_Expected.append(depth, L'\t');
+}
+
+template <typename CharType>
+bool CVcprojChecker<CharType>::CheckText(const CharType* text_end)
+{
+	const wchar_t* expected = m_Expected.data();
+	const wchar_t* expected_end = expected + m_Expected.size();
+	const CharType* p = m_Pos;
+	while (p<text_end && expected<expected_end)
+	{
+		const CharType* next = MatchChar(p, text_end, expected, expected_end, m_Char);
+		if (!next)
+			break;
+		p = next;
+	}
+	if (p<text_end || expected<expected_end)
+	{
+		wstring found, canonical;
+		AppendSnippet(found, p, text_end);
+		AppendSnippet(canonical, expected, expected_end);
+		return Violation(p, L"Found \"%s\" instead of \"%s\"!", found.c_str(), canonical.c_str());
+	}
+	m_Pos = text_end;
+	m_Expected.clear();
+	return true;
+}
+
+template <typename CharType>
+bool CVcprojChecker<CharType>::Violation(const CharType* pos, const wchar_t* fmtstr, ...)
+{
+	wchar_t buf[0x100];
+	va_list args;
+	va_start(args, fmtstr);
+	vswprintf(buf, sizeof(buf)/sizeof(buf[0]), fmtstr, args);
+	va_end(args);
+	m_Error = buf;
+	m_ErrorPos = pos;
+	return false;
+}
+
+// the checkers of the utf16 and the UTF-8 bodies
+template class CVcprojChecker<wchar_t>;
+template class CVcprojChecker<char>;
@@ -0,0 +1,60 @@
+#pragma once
+
+
+#include "VcprojParser.h"
+
+
+// Verifies in a single pass over the tags that formatting wouldn't change the xml body: the
+// attributes and the sibling elements are sorted and the text is exactly what
+// SXmlElement::Write() writes. No tree is built, the check stops at the first violation.
+// CharType is the code unit type of the body like for CVcprojParser.
+template <typename CharType>
+class CVcprojChecker : public IXmlTagHandler<CharType>
+{
+public:
+	// decimal_point is zero if the decimal point of the version number is kept.
+	CVcprojChecker(const CXmlCharacterReferenceMap& crm, ENewLineMode newline_mode, wchar_t decimal_point);
+
+	// xml_body is the decoded text after the xml declaration.
+	// Returns false if the body can't be parsed or it isn't in canonical form.
+	bool Check(const CharType* xml_body, const CharType* xml_body_end);
+	// Call this if Check() returns false.
+	void GetError(wstring& error_message, SXmlFileCursor& file_pos) const;
+
+	virtual bool StartTag(const SXmlElementKey& element, bool empty_element, const CharType* tag_begin, const CharType* tag_end);
+	virtual bool EndTag(const wstring& name, const CharType* tag_begin, const CharType* tag_end);
+
+private:
+	// The siblings that are checked at a depth of the tree.
+	struct SLevel
+	{
+		// the first element of the current run of siblings that are sorted together
+		wstring run_first;
+		SXmlElementKey prev;
+		bool has_prev;
+	};
+
+	bool CheckOrder(const SXmlElementKey& element, const CharType* tag_begin);
+	void AppendIndent(int depth);
+	// Compares the text between the end of the already checked text and text_end with m_Expected.
+	bool CheckText(const CharType* text_end);
+	bool Violation(const CharType* pos, const wchar_t* fmtstr, ...);
+
+private:
+	const CXmlCharacterReferenceMap& m_Crm;
+	const wchar_t* m_NewLine;
+	wchar_t m_DecimalPoint;
+
+	CVcprojParser<CharType> m_Parser;
+	const CharType* m_Begin;
+	// the text before this position has been checked
+	const CharType* m_Pos;
+	wstring m_Expected;
+	// the utf16 form of a UTF-8 character compared by CheckText()
+	wstring m_Char;
+	std::vector<SLevel> m_Levels;
+	int m_Depth;
+
+	wstring m_Error;
+	const CharType* m_ErrorPos;
+};
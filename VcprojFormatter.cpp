@@ -1,76 +1,442 @@
 #include "stdafx.h"
 #include "XmlEncoding.h"
 #include "Vcproj.h"
+#include "JobQueue.h"
+#include "DirectoryWalker.h"
+#include "Manifest.h"
+#include "FileCommit.h"
+#include "DirectoryWatcher.h"
+#include "GitFilter.h"
+#include "FileList.h"
+#include "FileReader.h"
+#include "ParallelTranscoder.h"
 
 
-bool g_SafeEncoding = false;
-wchar_t g_DecimalPoint = 0;
-ENewLineMode g_NewLineMode = eNLM_Auto;
-// NULL means AUTO encoding
-IEncoding* g_XmlEncoding = NULL;
+// The options are set by wmain() before starting the worker threads and they are
+// read only while the files are being processed.
+struct SFormatOptions
+{
+	bool safe_encoding;
+	wchar_t decimal_point;
+	ENewLineMode newline_mode;
+	// NULL means AUTO encoding
+	IEncoding* xml_encoding;
+	// number of worker threads
+	int jobs;
+	// NULL if there is no -MANIFEST option
+	CFormatManifest* manifest;
+	// -CHECK: the files are only verified, nothing is written
+	bool check;
+	// replaces the original files with the formatted temp files
+	CFileCommitQueue* commit_queue;
+	// -IO:BATCHED: the files are opened and read by the reader threads before the workers get them
+	bool batched_io;
+	// NULL if the files are read by the workers
+	CBatchedFileReader* reader;
+
+	SFormatOptions()
+		: safe_encoding(false)
+		, decimal_point(0)
+		, newline_mode(eNLM_Auto)
+		, xml_encoding(NULL)
+		, jobs(0)
+		, manifest(NULL)
+		, check(false)
+		, commit_queue(NULL)
+		, batched_io(false)
+		, reader(NULL)
+	{}
+
+	// Describes the options that affect the canonical form of the files.
+	wstring GetSignature() const
+	{
+		wchar_t buf[0x100];
+		swprintf(buf, sizeof(buf)/sizeof(buf[0]), L"DECIMAL_POINT:%s NEWLINE:%s ENCODING:%s%s",
+			decimal_point==L'.' ? L"." : (decimal_point==L',' ? L"," : L"AUTO"),
+			GetName(newline_mode), xml_encoding ? xml_encoding->GetName(0) : L"AUTO",
+			safe_encoding ? L" SAFE_ENCODING" : L"");
+		return buf;
+	}
+};
 
 
-bool ProcessError(const wchar_t* fmtstr, ...)
+// Logs the result of processing a file in a single line because
+// the worker threads are processing other files at the same time.
+static bool FileError(const wchar_t* action, const wchar_t* filepath, const wchar_t* fmtstr, va_list args)
+{
+	wchar_t buf[0x400];
+	vswprintf(buf, sizeof(buf)/sizeof(buf[0]), fmtstr, args);
+	Log(L"%s %s... %s", action, filepath, buf);
+	return false;
+}
+
+bool ProcessError(const wchar_t* filepath, const wchar_t* fmtstr, ...)
 {
 	va_list args;
 	va_start(args, fmtstr);
-	Log(fmtstr, args);
+	FileError(L"Formatting", filepath, fmtstr, args);
 	va_end(args);
 	return false;
 }
 
+bool CheckError(const wchar_t* filepath, const wchar_t* fmtstr, ...)
+{
+	va_list args;
+	va_start(args, fmtstr);
+	FileError(L"Checking", filepath, fmtstr, args);
+	va_end(args);
+	return false;
+}
+
+// Returns false if the file isn't in canonical form. Never writes the file or the manifest.
+// preloaded is NULL if the file hasn't been opened by the batched reader.
+bool CheckFile(const wchar_t* filepath, const SFormatOptions& options, const SPreloadedFile* preloaded)
+{
+	SFileStat file_stat;
+	if (preloaded)
+	{
+		file_stat = preloaded->stat;
+	}
+	else
+	{
+		WIN32_FILE_ATTRIBUTE_DATA file_data;
+		if (!GetFileAttributesEx(filepath, GetFileExInfoStandard, &file_data))
+			return CheckError(filepath, L"%s", LastErrorToString(GetLastError()).c_str());
+		file_stat = SFileStat(file_data);
+	}
+
+	if (options.manifest && options.manifest->IsUpToDate(filepath, file_stat))
+	{
+		Log(L"Checking %s... OK (unchanged since the last run)", filepath);
+		return true;
+	}
+
+	CVcprojFile vcproj_file;
+	bool ok = preloaded && preloaded->loaded ?
+		vcproj_file.CheckVcprojData(preloaded->data, options.newline_mode, options.xml_encoding, options.safe_encoding, options.decimal_point) :
+		vcproj_file.CheckVcprojFile(filepath, options.newline_mode, options.xml_encoding, options.safe_encoding, options.decimal_point);
+	if (!ok)
+		return CheckError(filepath, L"%s", vcproj_file.GetErrorMessage().c_str());
+
+	Log(L"Checking %s... OK", filepath);
+	return true;
+}
+
 
 static const wchar_t VCPROJ_EXT[] = L".vcproj";
 
-// Returns false on error.
-bool ProcessFile(const wchar_t* filepath)
+static bool HasVcprojExtension(const wchar_t* filepath)
 {
 	int ext_len = wcslen(VCPROJ_EXT);
 	int len = wcslen(filepath);
-	if (len<=ext_len || _wcsicmp(filepath+(len-ext_len), VCPROJ_EXT))
-		return ProcessError(L"%s: skipping, because the file extension is not \"%s\"!", filepath, VCPROJ_EXT);
+	return len>ext_len && !_wcsicmp(filepath+(len-ext_len), VCPROJ_EXT);
+}
 
-	LogNoNewline(L"Formatting %s... ", filepath);
+// Returns false on error.
+bool ProcessFile(const wchar_t* filepath, const SFormatOptions& options)
+{
+	// taken before the extension check so the results of the skipped files don't pile up
+	SPreloadedFile preloaded;
+	bool is_preloaded = options.reader && options.reader->TakeFile(filepath, preloaded);
+
+	if (!HasVcprojExtension(filepath))
+	{
+		Log(L"%s: skipping, because the file extension is not \"%s\"!", filepath, VCPROJ_EXT);
+		return false;
+	}
+
+	if (options.check)
+		return CheckFile(filepath, options, is_preloaded ? &preloaded : NULL);
+
+	DWORD file_attrib;
+	SFileStat file_stat;
+	if (is_preloaded)
+	{
+		file_attrib = preloaded.file_attributes;
+		file_stat = preloaded.stat;
+	}
+	else
+	{
+		WIN32_FILE_ATTRIBUTE_DATA file_data;
+		if (!GetFileAttributesEx(filepath, GetFileExInfoStandard, &file_data))
+			return ProcessError(filepath, L"%s", LastErrorToString(GetLastError()).c_str());
+		file_attrib = file_data.dwFileAttributes;
+		file_stat = SFileStat(file_data);
+	}
 
 	// skipping readonly files
-	DWORD file_attrib = GetFileAttributes(filepath);
-	if (file_attrib == INVALID_FILE_ATTRIBUTES)
-		return ProcessError(L"%s", LastErrorToString(GetLastError()).c_str());
 	if (file_attrib & FILE_ATTRIBUTE_READONLY)
-		return ProcessError(L"Skipping readonly file!");
+		return ProcessError(filepath, L"Skipping readonly file!");
+
+	if (options.manifest && options.manifest->IsUpToDate(filepath, file_stat))
+	{
+		Log(L"Formatting %s... OK (unchanged since the last run)", filepath);
+		return true;
+	}
 
 	CVcprojFile vcproj_file;
-	if (!vcproj_file.LoadVcprojFile(filepath, g_NewLineMode))
-		return ProcessError(L"Error loading file! %s", vcproj_file.GetErrorMessage().c_str());
+	bool loaded = is_preloaded && preloaded.loaded ?
+		vcproj_file.LoadVcprojData(preloaded.data, options.newline_mode) :
+		vcproj_file.LoadVcprojFile(filepath, options.newline_mode);
+	if (!loaded)
+		return ProcessError(filepath, L"Error loading file! %s", vcproj_file.GetErrorMessage().c_str());
+
+	// The file has been touched but it still contains the data we saved last time.
+	if (options.manifest && options.manifest->IsCanonicalData(filepath, file_stat.size, vcproj_file.GetDataHash()))
+	{
+		options.manifest->SetEntry(filepath, file_stat, vcproj_file.GetDataHash());
+		Log(L"Formatting %s... OK (already formatted)", filepath);
+		return true;
+	}
 
 	vcproj_file.GetRoot()->SortSubTree();
-	if (g_DecimalPoint)
-		vcproj_file.SetDecimalPoint(g_DecimalPoint);
+	if (options.decimal_point)
+		vcproj_file.SetDecimalPoint(options.decimal_point);
 
-	vcproj_file.SetNewLineMode(g_NewLineMode);
-	vcproj_file.SetEncoding(g_XmlEncoding);
+	vcproj_file.SetNewLineMode(options.newline_mode);
+	vcproj_file.SetEncoding(options.xml_encoding);
 
+	// The temp file is created only if the encoded data differs from the loaded data. Its name is
+	// unique per job because the rename is deferred to the commit queue.
+	static volatile LONG s_TempFileCounter = 0;
+	wchar_t temp_suffix[32];
+	swprintf(temp_suffix, sizeof(temp_suffix)/sizeof(temp_suffix[0]), L"_$temp%d$", (int)InterlockedIncrement(&s_TempFileCounter));
 	wstring temp_path = filepath;
-	temp_path += L"_$temp$";
-	if (!vcproj_file.SaveVcprojFile(temp_path.c_str(), file_attrib, g_SafeEncoding))
-		return ProcessError(L"Error saving temp file: %s %s", temp_path.c_str(), vcproj_file.GetErrorMessage().c_str());
-
-	if (!DeleteFile(filepath))
+	temp_path += temp_suffix;
+	// The preloaded files are encoded to memory if the commit queue writes the temp files in batches.
+	std::vector<char> encoded_data;
+	bool batched_write = is_preloaded && preloaded.loaded && options.commit_queue->HasBatchedWrites();
+	if (batched_write)
+	{
+		if (!vcproj_file.EncodeVcprojData(options.safe_encoding, encoded_data))
+			return ProcessError(filepath, L"Error encoding file! %s", vcproj_file.GetErrorMessage().c_str());
+	}
+	else if (!vcproj_file.SaveVcprojFile(temp_path.c_str(), file_attrib, options.safe_encoding))
 	{
 		DeleteFile(temp_path.c_str());
-		return ProcessError(L"Error deleting file! %s", LastErrorToString(GetLastError()).c_str());
+		return ProcessError(filepath, L"Error saving temp file: %s %s", temp_path.c_str(), vcproj_file.GetErrorMessage().c_str());
+	}
+
+	// Not touching the file keeps its modification time so the IDE and the builds don't see a change.
+	if (vcproj_file.IsEncodedDataUnchanged())
+	{
+		if (options.manifest)
+			options.manifest->SetEntry(filepath, file_stat, vcproj_file.GetDataHash());
+		Log(L"Formatting %s... OK (unchanged)", filepath);
+		return true;
+	}
+
+	// the commit queue logs the result after replacing the file
+	if (batched_write)
+		options.commit_queue->AddFileData(filepath, temp_path, encoded_data, vcproj_file.GetDataHash());
+	else
+		options.commit_queue->AddFile(filepath, temp_path, vcproj_file.GetDataHash());
+	return true;
+}
+
+// Reads the whole stdin, it can be a pipe or a redirected file.
+static bool ReadStdin(std::vector<char>& data)
+{
+	const DWORD CHUNK_SIZE = 0x10000;
+	HANDLE handle = GetStdHandle(STD_INPUT_HANDLE);
+	if (handle==NULL || handle==INVALID_HANDLE_VALUE)
+		return false;
+	while (1)
+	{
+		size_t size = data.size();
+		data.resize(size + CHUNK_SIZE);
+		DWORD read;
+		if (!ReadFile(handle, &data[size], CHUNK_SIZE, &read, NULL))
+		{
+			data.resize(size);
+			// the writer closed the pipe
+			return GetLastError() == ERROR_BROKEN_PIPE;
+		}
+		data.resize(size + read);
+		if (!read)
+			return true;
+	}
+}
+
+// Writes the data to stdout in big blocks bypassing the buffering of the C runtime.
+static bool WriteStdout(const std::vector<char>& data)
+{
+	const size_t BLOCK_SIZE = 0x10000;
+	HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
+	if (handle==NULL || handle==INVALID_HANDLE_VALUE)
+		return false;
+	for (size_t pos=0,size=data.size(); pos<size; )
+	{
+		DWORD block_size = (DWORD)min(size-pos, BLOCK_SIZE);
+		DWORD written;
+		if (!WriteFile(handle, &data[pos], block_size, &written, NULL) || !written)
+			return false;
+		pos += written;
+	}
+	return true;
+}
+
+// Formats the vcproj data in memory without temp files, data is replaced by the formatted data.
+// Used by -STDIN and -GIT_FILTER. Returns false with an error message on error.
+static bool FormatVcprojData(std::vector<char>& data, const SFormatOptions& options, wstring& error_message)
+{
+	CVcprojFile vcproj_file;
+	if (!vcproj_file.LoadVcprojData(data, options.newline_mode))
+	{
+		error_message = L"Error loading data! " + vcproj_file.GetErrorMessage();
+		return false;
+	}
+	vcproj_file.GetRoot()->SortSubTree();
+	if (options.decimal_point)
+		vcproj_file.SetDecimalPoint(options.decimal_point);
+	vcproj_file.SetNewLineMode(options.newline_mode);
+	vcproj_file.SetEncoding(options.xml_encoding);
+	if (!vcproj_file.EncodeVcprojData(options.safe_encoding, data))
+	{
+		error_message = L"Error encoding data! " + vcproj_file.GetErrorMessage();
+		return false;
+	}
+	return true;
+}
+
+// -STDIN: formats the vcproj data read from stdin and writes the result to stdout without using
+// temp files or worker threads. The messages go to stderr. Returns false on error.
+bool ProcessStdin(const SFormatOptions& options)
+{
+	std::vector<char> data;
+	if (!ReadStdin(data))
+	{
+		WinError(L"Error reading stdin!");
+		return false;
 	}
 
-	if (!MoveFile(temp_path.c_str(), filepath))
-		return ProcessError(L"Error moving \"%s\" to \"%s\"! %s", temp_path.c_str(), filepath, LastErrorToString(GetLastError()).c_str());
+	if (options.check)
+	{
+		CVcprojFile vcproj_file;
+		if (!vcproj_file.CheckVcprojData(data, options.newline_mode, options.xml_encoding, options.safe_encoding, options.decimal_point))
+		{
+			Error(L"Checking <stdin>... %s", vcproj_file.GetErrorMessage().c_str());
+			return false;
+		}
+		return true;
+	}
 
-	Log(L"OK");
+	wstring error_message;
+	if (!FormatVcprojData(data, options, error_message))
+	{
+		Error(L"Formatting <stdin>... %s", error_message.c_str());
+		return false;
+	}
+
+	if (!WriteStdout(data))
+	{
+		WinError(L"Error writing stdout!");
+		return false;
+	}
 	return true;
 }
 
-// Returns the number of errors.
-int ProcessFilePattern(const wchar_t* pattern)
+// -GIT_FILTER: both clean and smudge format the blob, so the index and the working tree get the
+// canonical form even if the repository contains blobs that were committed without the filter.
+class CGitFormatterFilter : public IGitBlobFilter
 {
+public:
+	CGitFormatterFilter(const SFormatOptions& options) : m_Options(options) {}
+	virtual bool Clean(const wchar_t* pathname, std::vector<char>& data, wstring& error_message)
+	{
+		return FormatVcprojData(data, m_Options, error_message);
+	}
+	virtual bool Smudge(const wchar_t* pathname, std::vector<char>& data, wstring& error_message)
+	{
+		return FormatVcprojData(data, m_Options, error_message);
+	}
+
+private:
+	const SFormatOptions& m_Options;
+};
+
+// Serves the blobs of a git command. stdout belongs to the protocol, the messages go to stderr.
+// Returns false on error.
+bool ProcessGitFilter(const SFormatOptions& options)
+{
+	CGitFormatterFilter filter(options);
+	CGitFilterProcess process(&filter);
+	if (!process.Run())
+	{
+		Error(L"%s", process.GetErrorMessage().c_str());
+		return false;
+	}
+	return true;
+}
+
+static const int MAX_JOBS = 256;
+
+class CFormatterJobProcessor : public IFileJobProcessor
+{
+public:
+	CFormatterJobProcessor(const SFormatOptions& options) : m_Options(options) {}
+	virtual bool ProcessFile(const wchar_t* filepath)	{ return ::ProcessFile(filepath, m_Options); }
+
+private:
+	const SFormatOptions& m_Options;
+};
+
+// The batched reader doesn't read the files that ProcessFile() would skip without loading them.
+class CFormatterPreloadFilter : public IPreloadFilter
+{
+public:
+	CFormatterPreloadFilter(const SFormatOptions& options) : m_Options(options) {}
+	virtual bool NeedsData(const wchar_t* filepath, DWORD file_attributes, const SFileStat& stat)
+	{
+		if (!HasVcprojExtension(filepath))
+			return false;
+		if (!m_Options.check && (file_attributes & FILE_ATTRIBUTE_READONLY))
+			return false;
+		return !m_Options.manifest || !m_Options.manifest->IsUpToDate(filepath, stat);
+	}
+
+private:
+	const SFormatOptions& m_Options;
+};
+
+// Passes each file to the next sink only once, no matter how many patterns, lists and directory
+// walks name it. Two jobs of the same file would race for its temp file and its rename.
+class CUniqueFileJobSink : public IFileJobSink
+{
+public:
+	CUniqueFileJobSink(IFileJobSink* sink) : m_Sink(sink) {}
+	virtual void AddJob(const wstring& filepath)
+	{
+		wstring key = CFormatManifest::GetKey(filepath.c_str());
+		{
+			SAutoLock lock(m_Lock);
+			if (!m_Files.insert(key).second)
+				return;
+		}
+		m_Sink->AddJob(filepath);
+	}
+
+private:
+	IFileJobSink* m_Sink;
+	CCriticalSection m_Lock;
+	std::set<wstring> m_Files;
+};
+
+// Queues the matching files to the pool. Returns the number of errors.
+int ProcessFilePattern(const wchar_t* pattern, const CExcludeFilter& exclude_filter, int jobs, IFileJobSink& pool)
+{
+	CPathPattern path_pattern;
+	if (!path_pattern.Parse(pattern))
+	{
+		Error(L"Invalid file pattern: %s", pattern);
+		return 1;
+	}
+	if (path_pattern.IsRecursive())
+	{
+		CDirectoryWalker walker(path_pattern, exclude_filter, pool);
+		return walker.Walk(jobs);
+	}
+
 	wstring dir = DirName(pattern);
 	WIN32_FIND_DATA find_data;
 	SFindHandle hFind = FindFirstFile(pattern, &find_data);
@@ -83,9 +449,13 @@ int ProcessFilePattern(const wchar_t* pattern)
 	int error_count = 0;
 	do 
 	{
-		wstring path = dir + find_data.cFileName;
-		if (!ProcessFile(path.c_str()))
-			++error_count;
+		if (!exclude_filter.IsEmpty())
+		{
+			std::vector<wstring> relative_path(1, find_data.cFileName);
+			if (exclude_filter.IsExcluded(find_data.cFileName, relative_path))
+				continue;
+		}
+		pool.AddJob(dir + find_data.cFileName);
 	}
 	while (FindNextFile(hFind, &find_data));
 
@@ -100,6 +470,173 @@ int ProcessFilePattern(const wchar_t* pattern)
 	return error_count;
 }
 
+// Queues the paths of the file list while they are being read. Returns the number of errors.
+int ProcessFileList(const wchar_t* list_path, IFileJobSink& pool)
+{
+	CFileListReader reader;
+	if (!reader.Open(list_path))
+	{
+		Error(L"%s", reader.GetErrorMessage().c_str());
+		return 1;
+	}
+	wstring filepath;
+	while (reader.ReadPath(filepath))
+		pool.AddJob(filepath);
+	if (!reader.GetErrorMessage().empty())
+	{
+		Error(L"%s", reader.GetErrorMessage().c_str());
+		return 1;
+	}
+	return 0;
+}
+
+// Formats the files that match the patterns, the listed files and the files of the file lists
+// on options.jobs threads. Returns the number of errors.
+int FormatFiles(SFormatOptions& options, const CExcludeFilter& exclude_filter,
+				const std::vector<wstring>& patterns, const std::vector<wstring>& filepaths,
+				const std::vector<wstring>& file_lists)
+{
+	CFileCommitQueue commit_queue(options.manifest);
+	options.commit_queue = &commit_queue;
+
+	CFormatterJobProcessor processor(options);
+	CFileJobPool pool(&processor);
+	CFormatterPreloadFilter preload_filter(options);
+	CBatchedFileReader reader(&preload_filter, &pool);
+	int error_count = 0;
+	if (pool.Start(options.jobs))
+	{
+		IFileJobSink* sink = &pool;
+		if (options.batched_io)
+		{
+			if (reader.Start())
+			{
+				options.reader = &reader;
+				sink = &reader;
+				// the workers write the temp files themselves if this fails
+				commit_queue.EnableBatchedWrites();
+			}
+			else
+			{
+				WinError(L"Error starting the batched reader, falling back to -IO:BLOCKING!");
+			}
+		}
+		CUniqueFileJobSink unique_sink(sink);
+		sink = &unique_sink;
+
+		for (size_t i=0,e=patterns.size(); i<e; ++i)
+			error_count += ProcessFilePattern(patterns[i].c_str(), exclude_filter, options.jobs, *sink);
+		for (size_t i=0,e=filepaths.size(); i<e; ++i)
+			sink->AddJob(filepaths[i]);
+		for (size_t i=0,e=file_lists.size(); i<e; ++i)
+			error_count += ProcessFileList(file_lists[i].c_str(), *sink);
+	}
+	else
+	{
+		WinError(L"Error starting the worker threads!");
+		++error_count;
+	}
+	// the reader passes its last files to the pool before the pool is closed
+	reader.Finish();
+	error_count += pool.Finish();
+	options.reader = NULL;
+	error_count += commit_queue.Finish();
+
+	options.commit_queue = NULL;
+	return error_count;
+}
+
+#ifdef _WIN32
+static HANDLE g_StopEvent = NULL;
+
+static BOOL WINAPI ConsoleCtrlHandler(DWORD ctrl_type)
+{
+	// Ctrl+C and Ctrl+Break stop the watching after formatting the current files.
+	SetEvent(g_StopEvent);
+	return TRUE;
+}
+
+static void SetStopEventOnCtrlC(HANDLE stop_event)
+{
+	if (stop_event)
+		g_StopEvent = stop_event;
+	SetConsoleCtrlHandler(ConsoleCtrlHandler, stop_event!=NULL);
+	if (!stop_event)
+		g_StopEvent = NULL;
+}
+#else
+static void SetStopEventOnCtrlC(HANDLE stop_event)
+{
+	// SIGINT and SIGTERM stop the watching after formatting the current files.
+	SetConsoleCtrlEvent(stop_event, stop_event!=NULL);
+}
+#endif
+
+// Formats the changed vcproj files under the directory until Ctrl+C is pressed. The manifest
+// tells which files have been formatted, so the files written by the formatter don't trigger
+// formatting again. Returns the number of errors.
+int WatchDirectory(const wchar_t* dir, SFormatOptions& options, const CExcludeFilter& exclude_filter, bool save_manifest)
+{
+	assert(options.manifest);
+	SWinHandle stop_event = CreateEvent(NULL, TRUE, FALSE, NULL);
+	if (!stop_event)
+	{
+		WinError(L"Error creating event!");
+		return 1;
+	}
+	CDirectoryWatcher watcher(exclude_filter);
+	if (!watcher.Start(dir, stop_event))
+	{
+		Error(L"%s", watcher.GetErrorMessage().c_str());
+		return 1;
+	}
+	SetStopEventOnCtrlC(stop_event);
+	Log(L"Watching %s for changes, press Ctrl+C to stop...", watcher.GetDir().c_str());
+
+	int error_count = 0;
+	std::vector<wstring> changed_files, filepaths, patterns;
+	bool rescan;
+	while (watcher.WaitForChanges(changed_files, rescan))
+	{
+		filepaths.clear();
+		for (size_t i=0,e=changed_files.size(); i<e; ++i)
+		{
+			// skipping the deleted files and the files that are already formatted
+			WIN32_FILE_ATTRIBUTE_DATA file_data;
+			if (!GetFileAttributesEx(changed_files[i].c_str(), GetFileExInfoStandard, &file_data))
+				continue;
+			if (file_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+				continue;
+			if (options.manifest->IsUpToDate(changed_files[i].c_str(), SFileStat(file_data)))
+				continue;
+			filepaths.push_back(changed_files[i]);
+		}
+		patterns.clear();
+		if (rescan)
+		{
+			Log(L"Too many changes, checking all files under %s...", watcher.GetDir().c_str());
+			patterns.push_back(watcher.GetDir() + L"**\\*.vcproj");
+		}
+		if (filepaths.empty() && patterns.empty())
+			continue;
+
+		error_count += FormatFiles(options, exclude_filter, patterns, filepaths, std::vector<wstring>());
+		if (save_manifest && !options.manifest->Save())
+		{
+			++error_count;
+			Error(L"%s", options.manifest->GetErrorMessage().c_str());
+		}
+	}
+
+	if (!watcher.GetErrorMessage().empty())
+	{
+		++error_count;
+		Error(L"%s", watcher.GetErrorMessage().c_str());
+	}
+	SetStopEventOnCtrlC(NULL);
+	return error_count;
+}
+
 void PrintHelp()
 {
 	wchar_t module_filename[MAX_PATH];
@@ -120,9 +657,14 @@ void PrintHelp()
 	}
 
 	Log(
-		L"Usage: %s [options...] [-] vcproj1 [, vcproj2 [, ...]]\n"
+		L"Usage: %s [options...] [-] vcproj1|@listfile [, vcproj2|@listfile [, ...]]\n"
+		L"       %s [options...] -WATCH:dir [[-] vcproj1 [, vcproj2 [, ...]]]\n"
+		L"       %s [options...] -STDIN < input.vcproj > output.vcproj\n"
+		L"       %s [options...] -GIT_FILTER\n"
 		L"You can use wildcards to specify vcproj files. (Eg.: c:\\code\\*.vcproj)\n"
+		L"A ** directory matches any number of subdirectories. (Eg.: c:\\code\\**\\*.vcproj)\n"
 		L"The files must have .vcproj extension!\n"
+		L"A @listfile argument is a file that lists vcproj paths (see -FILES_FROM).\n"
 		L"\n"
 		L"OPTIONS:\n"
 		L"-DECIMAL_POINT:[.|,]  Specify a decimal point character that will be used in\n"
@@ -145,8 +687,51 @@ void PrintHelp()
 		L"                      example: char 0x81 on codepage Windows-1252. However\n"
 		L"                      these non-existing characters should not normally occur\n"
 		L"                      in a file with a codepage that doesn't define them.\n"
+		L"-JOBS:N               Formats N files at the same time. The default is the\n"
+		L"                      number of processors in your machine.\n"
+		L"-EXCLUDE:pattern      Skips the files and directories that match the pattern\n"
+		L"                      while expanding the wildcards. A pattern without path\n"
+		L"                      separators is matched against the names (Eg.: obj),\n"
+		L"                      other patterns are matched against the path relative\n"
+		L"                      to the directory where the search starts. Excluded\n"
+		L"                      directories are never listed. Can be used many times.\n"
+		L"-MANIFEST:file        Remembers the size, modification time and hash of the\n"
+		L"                      formatted files in the specified manifest file. The files\n"
+		L"                      that haven't been modified since the last run with the\n"
+		L"                      same options are skipped without reading them.\n"
+		L"-CHECK                Only checks whether the files are already formatted with\n"
+		L"                      the specified options. Reports the line and column of\n"
+		L"                      the first difference in each file and writes nothing.\n"
+		L"-WATCH:dir            Stays running and formats the vcproj files under the\n"
+		L"                      directory and its subdirectories when they are saved.\n"
+		L"                      The files specified on the commandline are formatted\n"
+		L"                      before the watching starts. Press Ctrl+C to stop.\n"
+		L"-STDIN                Reads a vcproj from stdin and writes the formatted vcproj\n"
+		L"                      to stdout. With -CHECK only the exit code and the\n"
+		L"                      messages on stderr tell the result.\n"
+		L"-GIT_FILTER           Serves git's long running filter process protocol on\n"
+		L"                      stdin and stdout so a single process formats all the\n"
+		L"                      vcproj blobs of a git command. Configure it with:\n"
+		L"                        git config filter.vcproj.process \"%s -GIT_FILTER\"\n"
+		L"                      and add \"*.vcproj filter=vcproj\" to .gitattributes.\n"
+		L"-FILES_FROM:listfile  Formats the vcproj files listed in the file, - reads the\n"
+		L"                      list from stdin. The UTF-8 paths are separated by\n"
+		L"                      newlines or NUL characters. The files are formatted\n"
+		L"                      while the list is being read, so the output of\n"
+		L"                      git ls-files -z or find -print0 can be piped in.\n"
+		L"                      Can be used many times.\n"
+		L"-IO:io_mode           How the files are read and written. BLOCKING reads and\n"
+		L"                      writes each file on its worker thread. BATCHED reads up\n"
+		L"                      to 64 files at the same time ahead of the workers and\n"
+		L"                      keeps at most 128MB of data that they haven't taken yet.\n"
+		L"                      Windows uses 8 opener threads and overlapped I/O. Linux\n"
+		L"                      uses io_uring, which also batches the writes of the\n"
+		L"                      temp files and the renames. Without io_uring it falls\n"
+		L"                      back to BLOCKING. It's meant for high latency storage\n"
+		L"                      like network drives. On a local disk with a warm cache\n"
+		L"                      it isn't faster. The default is BLOCKING.\n"
 		L"-LIST_ENCODINGS       Show the list of supported encodings.\n"
-		, fname, newline_modes.c_str()
+		, fname, fname, fname, fname, newline_modes.c_str(), fname
 		);
 }
 
@@ -184,15 +769,15 @@ void LogEncoding(IEncoding* encoding)
 
 void ListEncodings()
 {
-	const std::vector<IEncoding*>& encodings = CEncodings::GetInstance().GetAllEncodings();
+	const CEncodings& encodings = CEncodings::GetInstance();
 	// encodings that are supported by the windows
 	std::vector<IEncoding*> avail;
 	// encodings that aren't supported by the windows
 	std::vector<IEncoding*> unavail;
 
-	for (std::vector<IEncoding*>::const_iterator it=encodings.begin(),eit=encodings.end(); it!=eit; ++it)
+	for (int i=0,count=encodings.GetEncodingCount(); i<count; ++i)
 	{
-		IEncoding* e = *it;
+		IEncoding* e = encodings.GetEncoding(i);
 		if (e->IsAvailable())
 			avail.push_back(e);
 		else
@@ -210,6 +795,13 @@ void ListEncodings()
 
 int __cdecl wmain(int argc, wchar_t* argv[])
 {
+	SFormatOptions options;
+	CExcludeFilter exclude_filter;
+	const wchar_t* manifest_path = NULL;
+	const wchar_t* watch_dir = NULL;
+	bool use_stdin = false;
+	bool git_filter = false;
+	std::vector<wstring> file_lists;
 	int argi;
 	for (argi=1; argi<argc; ++argi)
 	{
@@ -227,10 +819,19 @@ int __cdecl wmain(int argc, wchar_t* argv[])
 		static const wchar_t PARAM_ENCODING[] = L"ENCODING:";
 		static const wchar_t PARAM_NEWLINE[] = L"NEWLINE:";
 		static const wchar_t PARAM_LIST_ENCODINGS[] = L"LIST_ENCODINGS";
+		static const wchar_t PARAM_JOBS[] = L"JOBS:";
+		static const wchar_t PARAM_EXCLUDE[] = L"EXCLUDE:";
+		static const wchar_t PARAM_MANIFEST[] = L"MANIFEST:";
+		static const wchar_t PARAM_CHECK[] = L"CHECK";
+		static const wchar_t PARAM_WATCH[] = L"WATCH:";
+		static const wchar_t PARAM_STDIN[] = L"STDIN";
+		static const wchar_t PARAM_GIT_FILTER[] = L"GIT_FILTER";
+		static const wchar_t PARAM_FILES_FROM[] = L"FILES_FROM:";
+		static const wchar_t PARAM_IO[] = L"IO:";
 
 		if (0 == _wcsicmp(p+1, PARAM_SAFE_ENCODING))
 		{
-			g_SafeEncoding = true;
+			options.safe_encoding = true;
 		}
 		else if (0 == _wcsnicmp(p+1, PARAM_DECIMAL_POINT, wcslen(PARAM_DECIMAL_POINT)))
 		{
@@ -240,24 +841,24 @@ int __cdecl wmain(int argc, wchar_t* argv[])
 				Error(L"Invalid decimal point: '%s' It must be either '.' or ','!!!", dp);
 				return 1;
 			}
-			g_DecimalPoint = dp[0];
+			options.decimal_point = dp[0];
 		}
 		else if (0 == _wcsnicmp(p+1, PARAM_ENCODING, wcslen(PARAM_ENCODING)))
 		{
 			const wchar_t* pencoding = p + 1 + wcslen(PARAM_ENCODING);
 			if (0 == _wcsicmp(pencoding, L"AUTO"))
 			{
-				g_XmlEncoding = NULL;
+				options.xml_encoding = NULL;
 			}
 			else
 			{
-				g_XmlEncoding = CEncodings::GetInstance().FindEncoding(pencoding);
-				if (!g_XmlEncoding)
+				options.xml_encoding = CEncodings::GetInstance().FindEncoding(pencoding);
+				if (!options.xml_encoding)
 				{
 					Error(L"Encoding \"%s\" isn't supported by this program.", pencoding);
 					return 1;
 				}
-				if (!g_XmlEncoding->IsAvailable())
+				if (!options.xml_encoding->IsAvailable())
 				{
 					Error(L"Encoding \"%s\" isn't supported by your Windows.", pencoding);
 					return 1;
@@ -267,13 +868,87 @@ int __cdecl wmain(int argc, wchar_t* argv[])
 		else if (0 == _wcsnicmp(p+1, PARAM_NEWLINE, wcslen(PARAM_NEWLINE)))
 		{
 			const wchar_t* pnewline = p + 1 + wcslen(PARAM_NEWLINE);
-			g_NewLineMode = NewLineModeFromName(pnewline);
-			if (g_NewLineMode == eNLM_Last)
+			options.newline_mode = NewLineModeFromName(pnewline);
+			if (options.newline_mode == eNLM_Last)
 			{
 				Error(L"Invalid newline mode: %s", pnewline);
 				return 1;
 			}
 		}
+		else if (0 == _wcsnicmp(p+1, PARAM_JOBS, wcslen(PARAM_JOBS)))
+		{
+			const wchar_t* pjobs = p + 1 + wcslen(PARAM_JOBS);
+			wchar_t* pjobs_end;
+			long jobs = wcstol(pjobs, &pjobs_end, 10);
+			if (pjobs_end==pjobs || *pjobs_end || jobs<1 || jobs>MAX_JOBS)
+			{
+				Error(L"Invalid number of jobs: '%s' It must be between 1 and %d!!!", pjobs, MAX_JOBS);
+				return 1;
+			}
+			options.jobs = (int)jobs;
+		}
+		else if (0 == _wcsnicmp(p+1, PARAM_EXCLUDE, wcslen(PARAM_EXCLUDE)))
+		{
+			const wchar_t* pexclude = p + 1 + wcslen(PARAM_EXCLUDE);
+			if (!exclude_filter.AddPattern(pexclude))
+			{
+				Error(L"Invalid exclude pattern: '%s'", pexclude);
+				return 1;
+			}
+		}
+		else if (0 == _wcsnicmp(p+1, PARAM_MANIFEST, wcslen(PARAM_MANIFEST)))
+		{
+			manifest_path = p + 1 + wcslen(PARAM_MANIFEST);
+			if (!manifest_path[0])
+			{
+				Error(L"Missing manifest file path!");
+				return 1;
+			}
+		}
+		else if (0 == _wcsicmp(p+1, PARAM_CHECK))
+		{
+			options.check = true;
+		}
+		else if (0 == _wcsicmp(p+1, PARAM_STDIN))
+		{
+			use_stdin = true;
+		}
+		else if (0 == _wcsicmp(p+1, PARAM_GIT_FILTER))
+		{
+			git_filter = true;
+		}
+		else if (0 == _wcsnicmp(p+1, PARAM_FILES_FROM, wcslen(PARAM_FILES_FROM)))
+		{
+			const wchar_t* list_path = p + 1 + wcslen(PARAM_FILES_FROM);
+			if (!list_path[0])
+			{
+				Error(L"Missing file list path!");
+				return 1;
+			}
+			file_lists.push_back(list_path);
+		}
+		else if (0 == _wcsnicmp(p+1, PARAM_IO, wcslen(PARAM_IO)))
+		{
+			const wchar_t* pio = p + 1 + wcslen(PARAM_IO);
+			if (0 == _wcsicmp(pio, L"BATCHED"))
+				options.batched_io = true;
+			else if (0 == _wcsicmp(pio, L"BLOCKING"))
+				options.batched_io = false;
+			else
+			{
+				Error(L"Invalid I/O mode: %s", pio);
+				return 1;
+			}
+		}
+		else if (0 == _wcsnicmp(p+1, PARAM_WATCH, wcslen(PARAM_WATCH)))
+		{
+			watch_dir = p + 1 + wcslen(PARAM_WATCH);
+			if (!watch_dir[0])
+			{
+				Error(L"Missing directory to watch!");
+				return 1;
+			}
+		}
 		else if (0 == _wcsicmp(p+1, PARAM_LIST_ENCODINGS))
 		{
 			ListEncodings();
@@ -286,15 +961,82 @@ int __cdecl wmain(int argc, wchar_t* argv[])
 		}
 	}
 
-	if (argi >= argc)
+	if (git_filter)
+	{
+		if (argi<argc || !file_lists.empty() || watch_dir || manifest_path || use_stdin || options.check)
+		{
+			Error(L"-GIT_FILTER can't be used with files, -WATCH, -MANIFEST, -STDIN or -CHECK!");
+			return 1;
+		}
+		SetTranscodeThreadCount(CFileJobPool::GetDefaultThreadCount());
+		return ProcessGitFilter(options) ? 0 : 1;
+	}
+
+	if (use_stdin)
+	{
+		if (argi<argc || !file_lists.empty() || watch_dir || manifest_path)
+		{
+			Error(L"-STDIN can't be used with files, -WATCH or -MANIFEST!");
+			return 1;
+		}
+		SetTranscodeThreadCount(CFileJobPool::GetDefaultThreadCount());
+		return ProcessStdin(options) ? 0 : 1;
+	}
+
+	// the @listfile arguments are read the same way as -FILES_FROM
+	std::vector<wstring> patterns;
+	for (; argi<argc; ++argi)
+	{
+		if (argv[argi][0] == L'@')
+			file_lists.push_back(argv[argi]+1);
+		else
+			patterns.push_back(argv[argi]);
+	}
+
+	if (patterns.empty() && file_lists.empty() && !watch_dir)
 	{
 		PrintHelp();
 		return 1;
 	}
+	if (watch_dir && options.check)
+	{
+		Error(L"-CHECK can't be used with -WATCH!");
+		return 1;
+	}
 
-	int error_count = 0;
-	for (; argi<argc; ++argi)
-		error_count += ProcessFilePattern(argv[argi]);
+	int processor_count = CFileJobPool::GetDefaultThreadCount();
+	if (!options.jobs)
+		options.jobs = min(processor_count, MAX_JOBS);
+	// The big texts are converted on the processors that the file jobs leave idle. A single file
+	// without wildcards gets all of them.
+	bool single_file = patterns.size()==1 && file_lists.empty() && !watch_dir && !wcspbrk(patterns[0].c_str(), L"*?");
+	SetTranscodeThreadCount(single_file ? processor_count : max(1, processor_count/options.jobs));
+
+	CFormatManifest manifest;
+	if (manifest_path)
+	{
+		if (!manifest.Load(manifest_path, options.GetSignature()))
+		{
+			Error(L"%s", manifest.GetErrorMessage().c_str());
+			return 1;
+		}
+		options.manifest = &manifest;
+	}
+	// the watching needs a manifest even if it isn't saved
+	if (watch_dir)
+		options.manifest = &manifest;
+
+	int error_count = FormatFiles(options, exclude_filter, patterns, std::vector<wstring>(), file_lists);
+
+	// the manifest is only read in check mode
+	if (manifest_path && !options.check && !manifest.Save())
+	{
+		++error_count;
+		Error(L"%s", manifest.GetErrorMessage().c_str());
+	}
+
+	if (watch_dir)
+		error_count += WatchDirectory(watch_dir, options, exclude_filter, manifest_path!=NULL);
 
 	if (error_count)
 		Error(L"Number of errors: %d", error_count);
@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "VcprojParser.h"
+#include "UTF8.h"
 
 
 ILINE static void UnicodeCharToUTF16(int c, wstring& str)
@@ -21,7 +22,8 @@ ILINE static void UnicodeCharToUTF16(int c, wstring& str)
 }
 
 // appends the result char(s) to str
-ILINE static bool HexStrToChar(const wchar_t* s, const wchar_t* s_end, wstring& str)
+template <typename CharType>
+ILINE static bool HexStrToChar(const CharType* s, const CharType* s_end, wstring& str)
 {
 	if (s >= s_end)
 		return false;
@@ -47,7 +49,8 @@ ILINE static bool HexStrToChar(const wchar_t* s, const wchar_t* s_end, wstring&
 }
 
 // appends the result char(s) to str
-ILINE static bool DecStrToChar(const wchar_t* s, const wchar_t* s_end, wstring& str)
+template <typename CharType>
+ILINE static bool DecStrToChar(const CharType* s, const CharType* s_end, wstring& str)
 {
 	if (s >= s_end)
 		return false;
@@ -66,7 +69,8 @@ ILINE static bool DecStrToChar(const wchar_t* s, const wchar_t* s_end, wstring&
 }
 
 // appends the unescaped character sequence to str
-ILINE static bool UnEscape(const wchar_t* s, const wchar_t* s_end, wstring& str)
+template <typename CharType>
+ILINE static bool UnEscape(const CharType* s, const CharType* s_end, wstring& str)
 {
 	size_t size = s_end - s;
 	assert(size >= 2);
@@ -139,32 +143,100 @@ ILINE static bool IsXmlTokenChar(wchar_t c)
 	return (c==L'<') | (c==L'=') | (c==L'/') | (c==L'>');
 }
 
+// The code unit as a character for the comparisons, the bytes above 0x7F aren't sign extended.
+ILINE static wchar_t CodeUnit(wchar_t c)
+{
+	return c;
+}
+
+ILINE static wchar_t CodeUnit(char c)
+{
+	return (wchar_t)(unsigned char)c;
+}
+
+// True for the code units that continue a character, they don't count in the column.
+ILINE static bool IsTrailingCodeUnit(wchar_t c)
+{
+	return (c>=0xDC00) & (c<=0xDFFF);
+}
+
+ILINE static bool IsTrailingCodeUnit(char c)
+{
+	return ((unsigned char)c & 0xC0) == 0x80;
+}
+
+// Appends the text to the utf16 string of a name or value.
+ILINE static void AppendText(wstring& str, const wchar_t* s_begin, const wchar_t* s_end)
+{
+	str.append(s_begin, s_end);
+}
+
+ILINE static void AppendText(wstring& str, const char* s_begin, const char* s_end)
+{
+	// the UTF-8 body has been validated by CXmlTextCodec::DecodeXmlFileData()
+	AppendUTF8ToUTF16(str, s_begin, s_end);
+}
+
+// True if the map writes the text as it is.
+ILINE static bool IsVerbatimText(const wchar_t* s_begin, const wchar_t* s_end, const CXmlCharacterReferenceMap& crm)
+{
+	for (const wchar_t* s=s_begin; s<s_end; ++s)
+	{
+		if (!crm.IsVerbatim(*s))
+			return false;
+	}
+	return true;
+}
+
+// The map of UTF-8 references only control characters so the non-ASCII bytes are verbatim.
+ILINE static bool IsVerbatimText(const char* s_begin, const char* s_end, const CXmlCharacterReferenceMap& crm)
+{
+	for (const char* s=s_begin; s<s_end; ++s)
+	{
+		if (!(*s & 0x80) && !crm.IsVerbatim((wchar_t)*s))
+			return false;
+	}
+	return true;
+}
+
 
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 
 
-CVcprojParser::CVcprojParser()
+template <typename CharType>
+CVcprojParser<CharType>::CVcprojParser()
 : m_Begin(NULL)
 , m_End(NULL)
 , m_Pos(NULL)
+, m_Source(NULL)
 , m_CurrentLineBegin(NULL)
+, m_LineBeginColumn(0)
 , m_CurrentLineNumber(0)
 , m_PrevNewLineChar(NEWLINE_NONE)
+, m_VerbatimMap(NULL)
 {
 }
 
-SXmlElement* CVcprojParser::Parse(const wchar_t* vcproj_contents, const wchar_t* vcproj_contents_end)
+template <typename CharType>
+void CVcprojParser<CharType>::Reset(const CharType* vcproj_contents, const CharType* vcproj_contents_end)
 {
 	m_Begin = vcproj_contents;
 	m_Pos = m_Begin;
 	m_End = vcproj_contents_end;
+	m_Source = NULL;
 	m_CurrentLineBegin = m_Begin;
+	m_LineBeginColumn = 0;
 
 	m_Error.clear();
 	m_CurrentLineNumber = 0;
 	m_PrevNewLineChar = NEWLINE_NONE;
+}
 
+template <typename CharType>
+SXmlElement* CVcprojParser<CharType>::Parse(const CharType* vcproj_contents, const CharType* vcproj_contents_end)
+{
+	Reset(vcproj_contents, vcproj_contents_end);
 	TXmlElementPtr root = new SXmlElement;
 	SkipSpaces();
 	if (!Element(*root))
@@ -172,24 +244,78 @@ SXmlElement* CVcprojParser::Parse(const wchar_t* vcproj_contents, const wchar_t*
 	return root.ReleasePtr();
 }
 
-void CVcprojParser::GetError(wstring& error_message, SXmlFileCursor& file_pos) const
+template <typename CharType>
+SXmlElement* CVcprojParser<CharType>::Parse(IXmlTextSource<CharType>& source)
+{
+	m_Window.clear();
+	Reset(m_Window.data(), m_Window.data());
+	m_Source = &source;
+	TXmlElementPtr root = new SXmlElement;
+	SkipSpaces();
+	bool parsed = Element(*root);
+	m_Source = NULL;
+	if (!parsed)
+		return NULL;
+	return root.ReleasePtr();
+}
+
+template <typename CharType>
+bool CVcprojParser<CharType>::ReadMore(const CharType*& p)
+{
+	if (!m_Source)
+		return false;
+	size_t p_offset = p - m_Pos;
+	// the dropped part of the current line still counts in the columns
+	m_LineBeginColumn = CalculateColumn(m_LineBeginColumn, m_CurrentLineBegin, m_Pos);
+	m_Window.erase(0, m_Pos - m_Window.data());
+	bool read;
+	do
+	{
+		read = m_Source->ReadChunk(m_Window);
+	} while (read && m_Window.size()<=p_offset);
+	m_Begin = m_Pos = m_CurrentLineBegin = m_Window.data();
+	m_End = m_Begin + m_Window.size();
+	p = m_Pos + p_offset;
+	return p < m_End;
+}
+
+template <typename CharType>
+bool CVcprojParser<CharType>::ParseStream(const CharType* vcproj_contents, const CharType* vcproj_contents_end, IXmlTagHandler<CharType>& handler)
+{
+	Reset(vcproj_contents, vcproj_contents_end);
+	SkipSpaces();
+	return StreamElement(handler);
+}
+
+template <typename CharType>
+void CVcprojParser<CharType>::GetFilePos(const CharType* text_begin, const CharType* pos, SXmlFileCursor& file_pos)
+{
+	CVcprojParser<CharType> parser;
+	parser.Reset(text_begin, pos);
+	parser.SetPos(pos);
+	parser.GetCurrentFilePos(file_pos);
+}
+
+template <typename CharType>
+void CVcprojParser<CharType>::GetError(wstring& error_message, SXmlFileCursor& file_pos) const
 {
 	error_message = m_Error;
 	GetCurrentFilePos(file_pos);
 }
 
-bool CVcprojParser::Error(const wchar_t* error_message)
+template <typename CharType>
+bool CVcprojParser<CharType>::Error(const wchar_t* error_message)
 {
 	if (m_Error.empty())
 		m_Error = error_message;
 	return false;
 }
 
-int CVcprojParser::CalculateCurrentColumn() const
+template <typename CharType>
+int CVcprojParser<CharType>::CalculateColumn(int column, const CharType* line_begin, const CharType* pos)
 {
 	const int TAB_SIZE = 4;
-	int column = 0;
-	for (const wchar_t* p=m_CurrentLineBegin; p<m_Pos; ++p)
+	for (const CharType* p=line_begin; p<pos; ++p)
 	{
 		if (p[0] == '\t')
 		{
@@ -198,37 +324,43 @@ int CVcprojParser::CalculateCurrentColumn() const
 		}
 		else
 		{
-			if ((p[0]<0xDC00) | (p[0]>0xDFFF))
+			if (!IsTrailingCodeUnit(p[0]))
 				++column;
 		}
 	}
 	return column;
 }
 
-void CVcprojParser::GetCurrentFilePos(SXmlFileCursor& file_pos) const
+template <typename CharType>
+void CVcprojParser<CharType>::GetCurrentFilePos(SXmlFileCursor& file_pos) const
 {
 	file_pos.line = m_CurrentLineNumber;
-	file_pos.column = CalculateCurrentColumn();
+	file_pos.column = CalculateColumn(m_LineBeginColumn, m_CurrentLineBegin, m_Pos);
 }
 
-wchar_t CVcprojParser::PreviewChar() const
+template <typename CharType>
+wchar_t CVcprojParser<CharType>::PreviewChar()
 {
-	if (m_Pos < m_End)
-		return m_Pos[0];
+	const CharType* p = m_Pos;
+	if (p<m_End || ReadMore(p))
+		return CodeUnit(p[0]);
 	return 0xFFFF;
 }
 
-wchar_t CVcprojParser::PreviewChar2() const
+template <typename CharType>
+wchar_t CVcprojParser<CharType>::PreviewChar2()
 {
-	if (m_Pos+1 < m_End)
-		return m_Pos[1];
+	const CharType* p = m_Pos + 1;
+	if (p<m_End || ReadMore(p))
+		return CodeUnit(p[0]);
 	return 0xFFFF;
 }
 
-void CVcprojParser::SetPos(const wchar_t* pos)
+template <typename CharType>
+void CVcprojParser<CharType>::SetPos(const CharType* pos)
 {
 	// maintaining the current line
-	for (const wchar_t* p=m_Pos; p<pos; ++p)
+	for (const CharType* p=m_Pos; p<pos; ++p)
 	{
 		if (p[0] == L'\r')
 		{
@@ -242,6 +374,7 @@ void CVcprojParser::SetPos(const wchar_t* pos)
 				m_PrevNewLineChar = NEWLINE_CR;
 			}
 			m_CurrentLineBegin = p + 1;
+			m_LineBeginColumn = 0;
 		}
 		else if (p[0] == L'\n')
 		{
@@ -255,6 +388,7 @@ void CVcprojParser::SetPos(const wchar_t* pos)
 				m_PrevNewLineChar = NEWLINE_LF;
 			}
 			m_CurrentLineBegin = p + 1;
+			m_LineBeginColumn = 0;
 		}
 		else
 		{
@@ -264,15 +398,18 @@ void CVcprojParser::SetPos(const wchar_t* pos)
 	m_Pos = pos;
 }
 
-bool CVcprojParser::SkipChar()
+template <typename CharType>
+bool CVcprojParser<CharType>::SkipChar()
 {
-	if (m_Pos >= m_End)
+	const CharType* p = m_Pos;
+	if (p>=m_End && !ReadMore(p))
 		return false;
-	SetPos(m_Pos + 1);
+	SetPos(p + 1);
 	return true;
 }
 
-bool CVcprojParser::ConsumeChar(wchar_t c)
+template <typename CharType>
+bool CVcprojParser<CharType>::ConsumeChar(wchar_t c)
 {
 	if (PreviewChar() != c)
 		return false;
@@ -280,10 +417,11 @@ bool CVcprojParser::ConsumeChar(wchar_t c)
 	return true;
 }
 
-void CVcprojParser::SkipSpaces()
+template <typename CharType>
+void CVcprojParser<CharType>::SkipSpaces()
 {
-	const wchar_t* p;
-	for (p=m_Pos; p<m_End; ++p)
+	const CharType* p;
+	for (p=m_Pos; p<m_End || ReadMore(p); ++p)
 	{
 		if (!IsSpace(p[0]))
 			break;
@@ -291,30 +429,34 @@ void CVcprojParser::SkipSpaces()
 	SetPos(p);
 }
 
-bool CVcprojParser::SkipSpacesAndConsumeChar(wchar_t c)
+template <typename CharType>
+bool CVcprojParser<CharType>::SkipSpacesAndConsumeChar(wchar_t c)
 {
 	SkipSpaces();
 	return ConsumeChar(c);
 }
 
-bool CVcprojParser::Name(wstring& name)
+template <typename CharType>
+bool CVcprojParser<CharType>::Name(wstring& name)
 {
-	const wchar_t* p;
-	for (p=m_Pos; p<m_End; ++p)
+	const CharType* p;
+	for (p=m_Pos; p<m_End || ReadMore(p); ++p)
 	{
 		if (IsSpace(p[0]) || IsXmlTokenChar(p[0]))
 			break;
 	}
 	if (p == m_Pos)
 		return false;
-	name.assign(m_Pos, p);
+	name.clear();
+	AppendText(name, m_Pos, p);
 	SetPos(p);
 	return true;
 }
 
-bool CVcprojParser::DerefAttribValueString(const wchar_t* val_begin, const wchar_t* val_end, wstring& s)
+template <typename CharType>
+bool CVcprojParser<CharType>::DerefAttribValueString(const CharType* val_begin, const CharType* val_end, wstring& s)
 {
-	const wchar_t* p = val_begin;
+	const CharType* p = val_begin;
 	while (p < val_end)
 	{
 		for (p=val_begin; p<val_end; ++p)
@@ -322,7 +464,7 @@ bool CVcprojParser::DerefAttribValueString(const wchar_t* val_begin, const wchar
 			if (p[0] == L'&')
 				break;
 		}
-		s.append(val_begin, p);
+		AppendText(s, val_begin, p);
 		if (p >= val_end)
 			return true;
 
@@ -348,17 +490,25 @@ bool CVcprojParser::DerefAttribValueString(const wchar_t* val_begin, const wchar
 	return true;
 }
 
-bool CVcprojParser::AttribValue(wstring& value)
+template <typename CharType>
+bool CVcprojParser<CharType>::AttribValue(wstring& value, bool* verbatim)
 {
 	if (!SkipSpacesAndConsumeChar(L'"'))
 		return Error(L"Expected '\"'");
-	const wchar_t* p;
-	for (p=m_Pos; p<m_End; ++p)
+	const CharType* p;
+	for (p=m_Pos; p<m_End || ReadMore(p); ++p)
 	{
 		if (p[0] == L'"')
 		{
-			if (!DerefAttribValueString(m_Pos, p, value))
+			// A verbatim value has no references as '&' is always escaped, so the scan for
+			// the references is skipped.
+			bool is_verbatim = m_VerbatimMap && IsVerbatimText(m_Pos, p, *m_VerbatimMap);
+			if (is_verbatim)
+				AppendText(value, m_Pos, p);
+			else if (!DerefAttribValueString(m_Pos, p, value))
 				return false;
+			if (verbatim)
+				*verbatim = is_verbatim;
 			SetPos(p+1);
 			return true;
 		}
@@ -366,18 +516,30 @@ bool CVcprojParser::AttribValue(wstring& value)
 	return Error(L"Expected a closing '\"'");
 }
 
-bool CVcprojParser::Attrib(SXmlAttrib& attrib)
+template <typename CharType>
+bool CVcprojParser<CharType>::Attrib(wstring& name, wstring& value, bool* verbatim)
 {
-	GetCurrentFilePos(attrib.file_pos);
-	if (!Name(attrib.name))
+	if (!Name(name))
 		return Error(L"Expected an attribute name");
 	if (!SkipSpacesAndConsumeChar(L'='))
 		return Error(L"Expected '='");
 	SkipSpaces();
-	return AttribValue(attrib.value);
+	return AttribValue(value, verbatim);
 }
 
-bool CVcprojParser::ElementContents(SXmlElement& element)
+template <typename CharType>
+bool CVcprojParser<CharType>::Attrib(SXmlAttrib& attrib)
+{
+	GetCurrentFilePos(attrib.file_pos);
+	bool verbatim = false;
+	if (!Attrib(attrib.name, attrib.value, &verbatim))
+		return false;
+	attrib.verbatim_map = verbatim ? m_VerbatimMap : NULL;
+	return true;
+}
+
+template <typename CharType>
+bool CVcprojParser<CharType>::ElementContents(SXmlElement& element)
 {
 	while (1)
 	{
@@ -393,20 +555,22 @@ bool CVcprojParser::ElementContents(SXmlElement& element)
 	return false;
 }
 
-bool CVcprojParser::ElementCloseTag(SXmlElement& element)
+template <typename CharType>
+bool CVcprojParser<CharType>::ElementCloseTag(const wstring& element_name)
 {
 	if (!ConsumeChar(L'<') || !ConsumeChar(L'/'))
 		return Error(L"Expected \"</\"");
 	SkipSpaces();
 	wstring name;
-	if (!Name(name) || name!=element.name)
+	if (!Name(name) || name!=element_name)
 		return Error(L"Expected element name");
 	if (!SkipSpacesAndConsumeChar(L'>'))
 		return Error(L"Expected '>'");
 	return true;
 }
 
-bool CVcprojParser::Element(SXmlElement& element)
+template <typename CharType>
+bool CVcprojParser<CharType>::Element(SXmlElement& element)
 {
 	GetCurrentFilePos(element.file_pos);
 	if (!ConsumeChar(L'<'))
@@ -441,7 +605,7 @@ bool CVcprojParser::Element(SXmlElement& element)
 		SkipChar();
 		if (!ElementContents(element))
 			return false;
-		return ElementCloseTag(element);
+		return ElementCloseTag(element.name);
 
 	default:
 		return Error(L"Expected \">\" or \"/>\".");
@@ -449,3 +613,79 @@ bool CVcprojParser::Element(SXmlElement& element)
 
 	return false;
 }
+
+template <typename CharType>
+bool CVcprojParser<CharType>::StreamElement(IXmlTagHandler<CharType>& handler)
+{
+	const CharType* tag_begin = m_Pos;
+	if (!ConsumeChar(L'<'))
+		return Error(L"Expected '<'");
+
+	SXmlElementKey& key = m_StreamKey;
+	SkipSpaces();
+	if (!Name(key.name))
+		return Error(L"Expected an element name.");
+
+	size_t attrib_count = 0;
+	while (1)
+	{
+		SkipSpaces();
+		if (IsXmlTokenChar(PreviewChar()))
+			break;
+		if (attrib_count >= key.attrib_names.size())
+		{
+			key.attrib_names.resize(attrib_count+1);
+			key.attrib_values.resize(attrib_count+1);
+		}
+		key.attrib_names[attrib_count].clear();
+		key.attrib_values[attrib_count].clear();
+		if (!Attrib(key.attrib_names[attrib_count], key.attrib_values[attrib_count]))
+			return false;
+		++attrib_count;
+	}
+	key.attrib_names.resize(attrib_count);
+	key.attrib_values.resize(attrib_count);
+
+	switch (PreviewChar())
+	{
+	case L'/':
+		// no children
+		SkipChar();
+		if (!ConsumeChar(L'>'))
+			return Error(L"Expected and '>' char.");
+		return handler.StartTag(key, true, tag_begin, m_Pos);
+
+	case L'>':
+		{
+			// possible element content and/or child elements
+			SkipChar();
+			if (!handler.StartTag(key, false, tag_begin, m_Pos))
+				return false;
+			// the key is overwritten by the children
+			wstring name = key.name;
+			while (1)
+			{
+				SkipSpaces();
+				if (PreviewChar() != L'<')
+					return Error(L"Expected '<'");
+				if (PreviewChar2() == L'/')
+					break;
+				if (!StreamElement(handler))
+					return false;
+			}
+			tag_begin = m_Pos;
+			if (!ElementCloseTag(name))
+				return false;
+			return handler.EndTag(name, tag_begin, m_Pos);
+		}
+
+	default:
+		return Error(L"Expected \">\" or \"/>\".");
+	}
+
+	return false;
+}
+
+// the utf16 and the UTF-8 parsers
+template class CVcprojParser<wchar_t>;
+template class CVcprojParser<char>;
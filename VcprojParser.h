@@ -4,8 +4,22 @@
 #include "Vcproj.h"
 
 
-// A class that parses the vcproj xml. At this point the xml declaration is already processed
-// and the remaining xml data is converted to utf16 because this class works with utf16 only!!!
+// Receives the tags from CVcprojParser::ParseStream() in document order. The pointers point into
+// the parsed text: tag_begin to the '<' and tag_end after the closing '>'. Returning false stops
+// the parsing.
+template <typename CharType>
+struct IXmlTagHandler
+{
+	virtual bool StartTag(const SXmlElementKey& element, bool empty_element, const CharType* tag_begin, const CharType* tag_end) = 0;
+	virtual bool EndTag(const wstring& name, const CharType* tag_begin, const CharType* tag_end) = 0;
+};
+
+
+// A class that parses the vcproj xml. At this point the xml declaration is already processed.
+// CharType is wchar_t for text decoded to utf16 and char for UTF-8 text that is parsed directly
+// from the bytes of the file. The names and values of the tree are stored as utf16 either way.
+// Instantiated for these two types in VcprojParser.cpp.
+template <typename CharType>
 class CVcprojParser
 {
 public:
@@ -13,39 +27,68 @@ public:
 	// Returns NULL on error, in this case you can call GetError() to find out more.
 	// The text content pointed by vcproj_contents should not contain the encoding
 	// <?xml version="1.0" encoding="Windows-1252"?>
-	SXmlElement* Parse(const wchar_t* vcproj_contents, const wchar_t* vcproj_contents_end);
+	SXmlElement* Parse(const CharType* vcproj_contents, const CharType* vcproj_contents_end);
+	// Parses the text of the source while it reads it. Only the part of the text from the
+	// current token is kept so the whole text is never in memory at once.
+	SXmlElement* Parse(IXmlTextSource<CharType>& source);
+	// Parses the same xml as Parse() without building a tree. Returns false on error or if the
+	// handler stopped the parsing, GetError() returns an empty message in the latter case.
+	bool ParseStream(const CharType* vcproj_contents, const CharType* vcproj_contents_end, IXmlTagHandler<CharType>& handler);
+	// Parse() sets SXmlAttrib::verbatim_map to this map for the values that it writes as they
+	// are. The char parser works with the map of UTF-8 only.
+	void SetVerbatimMap(const CXmlCharacterReferenceMap* crm)	{ m_VerbatimMap = crm; }
 	// Call this if Parse() returns NULL.
 	void GetError(wstring& error_message, SXmlFileCursor& file_pos) const;
 
+	// Calculates the line and column of pos the same way as the parser does for its errors.
+	static void GetFilePos(const CharType* text_begin, const CharType* pos, SXmlFileCursor& file_pos);
+
 private:
 	bool Error(const wchar_t* error_message);
-	int CalculateCurrentColumn() const;
+	void Reset(const CharType* vcproj_contents, const CharType* vcproj_contents_end);
+	// Continues the tab stops from the column of line_begin.
+	static int CalculateColumn(int column, const CharType* line_begin, const CharType* pos);
 	void GetCurrentFilePos(SXmlFileCursor& file_pos) const;
+	// Reads from the source until p, which points at or after m_End, is within the text.
+	// Drops the text before m_Pos and moves p with the rest. False at the end of the text.
+	bool ReadMore(const CharType*& p);
 
-	wchar_t PreviewChar() const;
-	wchar_t PreviewChar2() const;
-	void SetPos(const wchar_t* pos);
+	wchar_t PreviewChar();
+	wchar_t PreviewChar2();
+	void SetPos(const CharType* pos);
 	bool SkipChar();
 	bool ConsumeChar(wchar_t c);
 	void SkipSpaces();
 	bool SkipSpacesAndConsumeChar(wchar_t c);
 
 	bool Name(wstring& name);
-	bool DerefAttribValueString(const wchar_t* val_begin, const wchar_t* val_end, wstring& s);
-	bool AttribValue(wstring& value);
+	bool DerefAttribValueString(const CharType* val_begin, const CharType* val_end, wstring& s);
+	// verbatim is set if m_VerbatimMap writes the value as it is
+	bool AttribValue(wstring& value, bool* verbatim=NULL);
+	bool Attrib(wstring& name, wstring& value, bool* verbatim=NULL);
 	bool Attrib(SXmlAttrib& attrib);
 	bool ElementContents(SXmlElement& element);
-	bool ElementCloseTag(SXmlElement& element);
+	bool ElementCloseTag(const wstring& name);
 	bool Element(SXmlElement& element);
+	bool StreamElement(IXmlTagHandler<CharType>& handler);
 
 private:
-	const wchar_t* m_Begin;
-	const wchar_t* m_End;
-	const wchar_t* m_Pos;
+	const CharType* m_Begin;
+	const CharType* m_End;
+	const CharType* m_Pos;
+
+	// The text read by Parse() from m_Source, m_Begin points into it.
+	IXmlTextSource<CharType>* m_Source;
+	std::basic_string<CharType> m_Window;
 
-	const wchar_t* m_CurrentLineBegin;
+	const CharType* m_CurrentLineBegin;
+	// the column of m_CurrentLineBegin, not zero if the start of the line was dropped from m_Window
+	int m_LineBeginColumn;
 	int m_CurrentLineNumber;
 	enum { NEWLINE_NONE, NEWLINE_CR, NEWLINE_LF } m_PrevNewLineChar;
 
+	const CXmlCharacterReferenceMap* m_VerbatimMap;
 	wstring m_Error;
+	// reused by StreamElement() to avoid reallocating the strings for each tag
+	SXmlElementKey m_StreamKey;
 };
@@ -1,5 +1,10 @@
 #include "stdafx.h"
 #include "XmlEncoding.h"
+#include "UTF8.h"
+#include "SingleByteCodec.h"
+#include "MultiByteCodec.h"
+#include "EncodingNameHash.h"
+#include "ParallelTranscoder.h"
 
 
 const wchar_t* GetName(ENewLineMode newline_mode)
@@ -38,9 +43,10 @@ const wchar_t* ToString(ENewLineMode newline_mode)
 	}
 }
 
-ENewLineMode DetectNewLineMode(const wchar_t* s_begin, const wchar_t* s_end)
+template <typename CharType>
+static ENewLineMode DetectNewLineModeT(const CharType* s_begin, const CharType* s_end)
 {
-	for (const wchar_t* s=s_begin; s<s_end; ++s)
+	for (const CharType* s=s_begin; s<s_end; ++s)
 	{
 		if (s[0] == 10)
 		{
@@ -64,11 +70,60 @@ ENewLineMode DetectNewLineMode(const wchar_t* s_begin, const wchar_t* s_end)
 	return eNLM_Auto;
 }
 
+ENewLineMode DetectNewLineMode(const wchar_t* s_begin, const wchar_t* s_end)
+{
+	return DetectNewLineModeT(s_begin, s_end);
+}
+
+ENewLineMode DetectNewLineMode(const char* s_begin, const char* s_end)
+{
+	return DetectNewLineModeT(s_begin, s_end);
+}
+
 
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 
 
+// The trail bytes of the multibyte codepages are never '\n', splitting after a newline
+// also keeps the shift state of the stateful codepages at its initial value.
+size_t IEncoding::GetDecodeChunkSize(const char* bytes, size_t byte_count, size_t max_bytes) const
+{
+	if (byte_count <= max_bytes)
+		return byte_count;
+	for (size_t i=max_bytes; i>0; --i)
+	{
+		if (bytes[i-1] == '\n')
+			return i;
+	}
+	return 0;
+}
+
+size_t IEncoding::GetEncodeChunkSize(const wchar_t* utf16le_str, size_t utf16_chars, size_t max_chars) const
+{
+	if (utf16_chars <= max_chars)
+		return utf16_chars;
+	for (size_t i=max_chars; i>0; --i)
+	{
+		if (utf16le_str[i-1] == L'\n')
+			return i;
+	}
+	return 0;
+}
+
+// For the encodings that convert every character on its own.
+static size_t GetCharacterChunkSize(const wchar_t* utf16le_str, size_t utf16_chars, size_t max_chars)
+{
+	if (utf16_chars <= max_chars)
+		return utf16_chars;
+	// not splitting surrogate pairs
+	if (utf16le_str[max_chars-1]>=0xD800 && utf16le_str[max_chars-1]<0xDC00)
+		return max_chars - 1;
+	return max_chars;
+}
+
+//-------------------------------------------------------------------------------------------------
+
 static const wchar_t* UTF16LE_NAMES[] = { L"UTF-16", L"UTF16" };
 class UTF16LE_Encoding : public IEncoding
 {
@@ -76,19 +131,23 @@ public:
 	virtual int GetNameCount() const							{ return sizeof(UTF16LE_NAMES) / sizeof(UTF16LE_NAMES[0]); }
 	virtual const wchar_t* GetName(int name_index) const		{ return UTF16LE_NAMES[name_index]; }
 	virtual bool IsAvailable() const							{ return true; }
-	virtual int UTF16ToBytes(const wchar_t* utf16le_str, int utf16_chars, char* bytes, int byte_count, wstring* error_message=NULL) const;
-	virtual int BytesToUTF16(const char* bytes, int byte_count, wchar_t* utf16le_str, int utf16_chars, wstring* error_message=NULL) const;
+	virtual LONGLONG UTF16ToBytes(const wchar_t* utf16le_str, size_t utf16_chars, char* bytes, size_t byte_count, wstring* error_message=NULL) const;
+	virtual LONGLONG BytesToUTF16(const char* bytes, size_t byte_count, wchar_t* utf16le_str, size_t utf16_chars, wstring* error_message=NULL, size_t* invalid_offset=NULL) const;
+	virtual size_t GetMaxByteCount(size_t utf16_chars) const	{ return utf16_chars * 2; }
+	virtual size_t GetMaxUTF16Chars(size_t byte_count) const	{ return byte_count / 2; }
+	virtual size_t GetDecodeChunkSize(const char* bytes, size_t byte_count, size_t max_bytes) const;
+	virtual size_t GetEncodeChunkSize(const wchar_t* utf16le_str, size_t utf16_chars, size_t max_chars) const	{ return GetCharacterChunkSize(utf16le_str, utf16_chars, max_chars); }
 	virtual int GetBOMSizeBytes() const				{ return 2; }
 	virtual const char* GetBOM() const				{ return "\xFF\xFE"; }
 	virtual int GetFlags() const					{ return eF_CanRepresentAllUniChars; }
 };
 
-int UTF16LE_Encoding::UTF16ToBytes(const wchar_t* utf16le_str, int utf16_chars, char* bytes, int byte_count, wstring* error_message) const
+LONGLONG UTF16LE_Encoding::UTF16ToBytes(const wchar_t* utf16le_str, size_t utf16_chars, char* bytes, size_t byte_count, wstring* error_message) const
 {
-	if (utf16_chars <= 0)
-		return utf16_chars;
-	int res = utf16_chars * 2;
-	if (byte_count > 0)
+	if (!utf16_chars)
+		return 0;
+	size_t res = utf16_chars * 2;
+	if (byte_count)
 	{
 		if (byte_count < res)
 		{
@@ -96,17 +155,36 @@ int UTF16LE_Encoding::UTF16ToBytes(const wchar_t* utf16le_str, int utf16_chars,
 				*error_message = L"Destination buffer is too small!";
 			return -1;
 		}
+#if WCHAR_MAX > 0xFFFF
+		for (size_t i=0; i<utf16_chars; ++i)
+		{
+			bytes[i*2] = (char)(utf16le_str[i] & 0xFF);
+			bytes[i*2+1] = (char)((utf16le_str[i] >> 8) & 0xFF);
+		}
+#else
 		memcpy(bytes, utf16le_str, res);
+#endif
 	}
-	return res;
+	return (LONGLONG)res;
 }
 
-int UTF16LE_Encoding::BytesToUTF16(const char* bytes, int byte_count, wchar_t* utf16le_str, int utf16_chars, wstring* error_message) const
+// Not splitting surrogate pairs, an odd trailing byte is left to the last chunk.
+size_t UTF16LE_Encoding::GetDecodeChunkSize(const char* bytes, size_t byte_count, size_t max_bytes) const
 {
-	if (byte_count <= 0)
+	if (byte_count <= max_bytes)
 		return byte_count;
-	int res = byte_count / 2;
-	if (utf16_chars > 0)
+	size_t size = max_bytes & ~(size_t)1;
+	if (size>=2 && (bytes[size-1] & 0xFC)==0xD8)
+		size -= 2;
+	return size;
+}
+
+LONGLONG UTF16LE_Encoding::BytesToUTF16(const char* bytes, size_t byte_count, wchar_t* utf16le_str, size_t utf16_chars, wstring* error_message, size_t* invalid_offset) const
+{
+	if (!byte_count)
+		return 0;
+	size_t res = byte_count / 2;
+	if (utf16_chars)
 	{
 		if (utf16_chars < res)
 		{
@@ -114,487 +192,498 @@ int UTF16LE_Encoding::BytesToUTF16(const char* bytes, int byte_count, wchar_t* u
 				*error_message = L"Destination buffer is too small!";
 			return -1;
 		}
-		memcpy(utf16le_str, bytes, byte_count & ~1);
+#if WCHAR_MAX > 0xFFFF
+		const unsigned char* p = (const unsigned char*)bytes;
+		for (size_t i=0; i<res; ++i)
+			utf16le_str[i] = (wchar_t)(p[i*2] | (p[i*2+1] << 8));
+#else
+		memcpy(utf16le_str, bytes, res * 2);
+#endif
 	}
-	return res;
+	return (LONGLONG)res;
 }
 
 //-------------------------------------------------------------------------------------------------
 
+// The codepages that have built-in tables are converted with CSingleByteCodec or CMultiByteCodec,
+// the others with the conversion functions of the system.
 class Codepage_Encoding : public IEncoding
 {
 public:
-	Codepage_Encoding(UINT codepage=0, const wchar_t** names=NULL, int name_count=0)
-		: m_Codepage(codepage), m_Names(names), m_NameCount(name_count) {}
+	Codepage_Encoding(UINT codepage=0, const wchar_t** names=NULL, int name_count=0);
 	virtual int GetNameCount() const							{ return m_NameCount; }
 	virtual const wchar_t* GetName(int name_index) const		{ return m_Names[name_index]; }
 	virtual bool IsAvailable() const;
-	virtual int UTF16ToBytes(const wchar_t* utf16le_str, int utf16_chars, char* bytes, int byte_count, wstring* error_message=NULL) const;
-	virtual int BytesToUTF16(const char* bytes, int byte_count, wchar_t* utf16le_str, int utf16_chars, wstring* error_message=NULL) const;
+	virtual LONGLONG UTF16ToBytes(const wchar_t* utf16le_str, size_t utf16_chars, char* bytes, size_t byte_count, wstring* error_message=NULL) const;
+	virtual LONGLONG BytesToUTF16(const char* bytes, size_t byte_count, wchar_t* utf16le_str, size_t utf16_chars, wstring* error_message=NULL, size_t* invalid_offset=NULL) const;
+	virtual size_t GetMaxByteCount(size_t utf16_chars) const;
+	virtual size_t GetMaxUTF16Chars(size_t byte_count) const	{ return byte_count; }
+	virtual size_t GetDecodeChunkSize(const char* bytes, size_t byte_count, size_t max_bytes) const;
+	virtual size_t GetEncodeChunkSize(const wchar_t* utf16le_str, size_t utf16_chars, size_t max_chars) const;
+	virtual const unsigned short* GetSingleByteTable() const;
+
+private:
+	// True if the codepage has no lead bytes and no shift states.
+	bool IsSingleByte() const;
+
+	LONGLONG CodecToBytes(const wchar_t* utf16le_str, size_t utf16_chars, char* bytes, size_t byte_count, wstring* error_message) const;
+	LONGLONG CodecToUTF16(const char* bytes, size_t byte_count, wchar_t* utf16le_str, size_t utf16_chars, wstring* error_message, size_t* invalid_offset) const;
 
 private:
 	UINT m_Codepage;
 	const wchar_t** m_Names;
 	int m_NameCount;
+	// NULL if the codepage doesn't have built-in tables, never deleted like the encodings
+	ICodepageCodec* m_Codec;
 };
 
+Codepage_Encoding::Codepage_Encoding(UINT codepage, const wchar_t** names, int name_count)
+: m_Codepage(codepage)
+, m_Names(names)
+, m_NameCount(name_count)
+, m_Codec(NULL)
+{
+	const SSingleByteTable* table = FindSingleByteTable(codepage);
+	if (table)
+	{
+		m_Codec = new CSingleByteCodec(*table);
+		return;
+	}
+	switch (codepage)
+	{
+	case 932: m_Codec = new CMultiByteCodec(CMultiByteCodec::eT_SHIFT_JIS); break;
+	case 936: m_Codec = new CMultiByteCodec(CMultiByteCodec::eT_GBK); break;
+	case 949: m_Codec = new CMultiByteCodec(CMultiByteCodec::eT_UHC); break;
+	case 950: m_Codec = new CMultiByteCodec(CMultiByteCodec::eT_BIG5); break;
+	case 51932: m_Codec = new CMultiByteCodec(CMultiByteCodec::eT_EUC_JP); break;
+	case 51949: m_Codec = new CMultiByteCodec(CMultiByteCodec::eT_EUC_KR); break;
+	case 52936: m_Codec = new CMultiByteCodec(CMultiByteCodec::eT_HZ); break;
+	case 54936: m_Codec = new CMultiByteCodec(CMultiByteCodec::eT_GB18030); break;
+	}
+}
+
+const unsigned short* Codepage_Encoding::GetSingleByteTable() const
+{
+	return m_Codec ? m_Codec->GetSingleByteTable() : NULL;
+}
+
 bool Codepage_Encoding::IsAvailable() const
 {
+	if (m_Codec)
+		return true;
 	wchar_t c = L' ';
 	int res = WideCharToMultiByte(m_Codepage, 0, &c, 1, NULL, 0, NULL, NULL);
 	return res > 0;
 }
 
-int Codepage_Encoding::UTF16ToBytes(const wchar_t* utf16le_str, int utf16_chars, char* bytes, int byte_count, wstring* error_message) const
+// WideCharToMultiByte() and MultiByteToWideChar() work with int sizes so big texts are converted
+// in chunks. A chunk is encoded to at most 4 bytes per UTF-16 character and it is decoded to at
+// most one UTF-16 character per byte, so the results of the chunks fit in an int.
+static const size_t MAX_ENCODE_CHUNK_CHARS = 0x10000000;
+static const size_t MAX_DECODE_CHUNK_BYTES = 0x40000000;
+
+// A character takes at most 4 bytes, and the stateful codepages may switch their shift state
+// with an escape sequence of at most 4 bytes before every character and at the end of the text.
+size_t Codepage_Encoding::GetMaxByteCount(size_t utf16_chars) const
+{
+	if (m_Codec)
+		return m_Codec->GetMaxByteCount(utf16_chars);
+	return utf16_chars*8 + 8;
+}
+
+// Returns -1 like the conversion functions on error.
+static LONGLONG DestinationTooSmall(wstring* error_message)
+{
+	if (error_message)
+		*error_message = L"Destination buffer is too small!";
+	return -1;
+}
+
+static wstring InvalidCodepageMessage(ULONGLONG byte_offset)
 {
-	if (utf16_chars <= 0)
+	wchar_t buf[0x100];
+	swprintf(buf, sizeof(buf)/sizeof(buf[0]), L"Error decoding to UTF-16 with the specified encoding! Invalid or undefined byte sequence at byte offset %llu.", byte_offset);
+	return buf;
+}
+
+LONGLONG Codepage_Encoding::CodecToBytes(const wchar_t* utf16le_str, size_t utf16_chars, char* bytes, size_t byte_count, wstring* error_message) const
+{
+	// the size is calculated in a separate pass only if the buffer is smaller than the upper bound
+	if (!byte_count || byte_count<m_Codec->GetMaxByteCount(utf16_chars))
 	{
-		if (utf16_chars<0 && error_message)
-			*error_message = L"Negative destination buffer size!!!";
-		return utf16_chars;
+		size_t res = m_Codec->GetEncodedSize(utf16le_str, utf16le_str+utf16_chars);
+		if (!byte_count)
+			return (LONGLONG)res;
+		if (byte_count < res)
+			return DestinationTooSmall(error_message);
 	}
-	int res = WideCharToMultiByte(m_Codepage, 0, utf16le_str, utf16_chars, bytes, byte_count, NULL, NULL);
-	if (res <= 0)
+	return (LONGLONG)(m_Codec->Encode(utf16le_str, utf16le_str+utf16_chars, bytes) - bytes);
+}
+
+LONGLONG Codepage_Encoding::CodecToUTF16(const char* bytes, size_t byte_count, wchar_t* utf16le_str, size_t utf16_chars, wstring* error_message, size_t* invalid_offset) const
+{
+	const char* invalid = bytes + byte_count;
+	wchar_t* dst = utf16le_str;
+	// the size is calculated in a separate pass only if the buffer is smaller than the upper bound
+	if (!utf16_chars || utf16_chars<byte_count)
 	{
-		if (error_message)
+		size_t res;
+		invalid = m_Codec->Validate(bytes, bytes+byte_count, res);
+		if (invalid == bytes+byte_count)
 		{
-			*error_message = L"Error encoding UTF-16 text with the specified encoding! ";
-			*error_message += LastErrorToString(GetLastError());
+			if (!utf16_chars)
+				return (LONGLONG)res;
+			if (utf16_chars < res)
+				return DestinationTooSmall(error_message);
 		}
+	}
+	if (invalid == bytes+byte_count)
+		invalid = m_Codec->Decode(bytes, bytes+byte_count, dst);
+	if (invalid != bytes+byte_count)
+	{
+		if (error_message)
+			*error_message = InvalidCodepageMessage(invalid - bytes);
+		if (invalid_offset)
+			*invalid_offset = invalid - bytes;
 		return -1;
 	}
-	return res;
+	return (LONGLONG)(dst - utf16le_str);
 }
 
-int Codepage_Encoding::BytesToUTF16(const char* bytes, int byte_count, wchar_t* utf16le_str, int utf16_chars, wstring* error_message) const
+LONGLONG Codepage_Encoding::UTF16ToBytes(const wchar_t* utf16le_str, size_t utf16_chars, char* bytes, size_t byte_count, wstring* error_message) const
 {
-	if (byte_count <= 0)
+	if (m_Codec)
+		return CodecToBytes(utf16le_str, utf16_chars, bytes, byte_count, error_message);
+	size_t converted = 0;
+	while (utf16_chars)
 	{
-		if (byte_count<0 && error_message)
-			*error_message = L"Negative destination buffer size!!!";
-		return byte_count;
+		size_t chunk_chars = utf16_chars;
+		if (chunk_chars > MAX_ENCODE_CHUNK_CHARS)
+		{
+			chunk_chars = MAX_ENCODE_CHUNK_CHARS;
+			// not splitting surrogate pairs
+			if (utf16le_str[chunk_chars-1]>=0xD800 && utf16le_str[chunk_chars-1]<0xDC00)
+				--chunk_chars;
+		}
+		int dst_size = 0;
+		if (byte_count)
+		{
+			if (converted >= byte_count)
+				return DestinationTooSmall(error_message);
+			dst_size = (int)min(byte_count-converted, (size_t)0x7FFFFFFF);
+		}
+		int res = WideCharToMultiByte(m_Codepage, 0, utf16le_str, (int)chunk_chars, byte_count ? bytes+converted : NULL, dst_size, NULL, NULL);
+		if (res <= 0)
+		{
+			if (error_message)
+			{
+				*error_message = L"Error encoding UTF-16 text with the specified encoding! ";
+				*error_message += LastErrorToString(GetLastError());
+			}
+			return -1;
+		}
+		converted += (size_t)res;
+		utf16le_str += chunk_chars;
+		utf16_chars -= chunk_chars;
 	}
-	int res = MultiByteToWideChar(m_Codepage, MB_ERR_INVALID_CHARS, bytes, byte_count, utf16le_str, utf16_chars);
-	if (res <= 0)
+	return (LONGLONG)converted;
+}
+
+bool Codepage_Encoding::IsSingleByte() const
+{
+	if (m_Codec)
+		return GetSingleByteTable() != NULL;
+	CPINFO cp_info;
+	return GetCPInfo(m_Codepage, &cp_info) && cp_info.MaxCharSize==1;
+}
+
+size_t Codepage_Encoding::GetDecodeChunkSize(const char* bytes, size_t byte_count, size_t max_bytes) const
+{
+	if (byte_count <= max_bytes)
+		return byte_count;
+	if (IsSingleByte())
+		return max_bytes;
+	return IEncoding::GetDecodeChunkSize(bytes, byte_count, max_bytes);
+}
+
+size_t Codepage_Encoding::GetEncodeChunkSize(const wchar_t* utf16le_str, size_t utf16_chars, size_t max_chars) const
+{
+	if (utf16_chars <= max_chars)
+		return utf16_chars;
+	if (IsSingleByte())
+		return GetCharacterChunkSize(utf16le_str, utf16_chars, max_chars);
+	return IEncoding::GetEncodeChunkSize(utf16le_str, utf16_chars, max_chars);
+}
+
+LONGLONG Codepage_Encoding::BytesToUTF16(const char* bytes, size_t byte_count, wchar_t* utf16le_str, size_t utf16_chars, wstring* error_message, size_t* invalid_offset) const
+{
+	if (m_Codec)
+		return CodecToUTF16(bytes, byte_count, utf16le_str, utf16_chars, error_message, invalid_offset);
+	size_t converted = 0;
+	while (byte_count)
 	{
-		if (error_message)
+		size_t chunk_bytes = GetDecodeChunkSize(bytes, byte_count, MAX_DECODE_CHUNK_BYTES);
+		if (!chunk_bytes)
 		{
-			*error_message = L"Error decoding to UTF-16 with the specified encoding! ";
-			*error_message += LastErrorToString(GetLastError());
+			if (error_message)
+				*error_message = L"The text contains a line that is too long to decode with the specified encoding!";
+			return -1;
 		}
-		return -1;
+		int dst_size = 0;
+		if (utf16_chars)
+		{
+			if (converted >= utf16_chars)
+				return DestinationTooSmall(error_message);
+			dst_size = (int)min(utf16_chars-converted, (size_t)0x7FFFFFFF);
+		}
+		int res = MultiByteToWideChar(m_Codepage, MB_ERR_INVALID_CHARS, bytes, (int)chunk_bytes, utf16_chars ? utf16le_str+converted : NULL, dst_size);
+		if (res <= 0)
+		{
+			if (error_message)
+			{
+				*error_message = L"Error decoding to UTF-16 with the specified encoding! ";
+				*error_message += LastErrorToString(GetLastError());
+			}
+			return -1;
+		}
+		converted += (size_t)res;
+		bytes += chunk_bytes;
+		byte_count -= chunk_bytes;
 	}
-	return res;
+	return (LONGLONG)converted;
 }
 
 //-------------------------------------------------------------------------------------------------
 
 static const wchar_t* UTF8_NAMES[] = { L"UTF-8", L"UTF8", L"Windows-65001" };
-class UTF8_Encoding : public Codepage_Encoding
+// Uses the validating transcoder of UTF8.h instead of the 65001 codepage of the system.
+class UTF8_Encoding : public IEncoding
 {
 public:
-	UTF8_Encoding() : Codepage_Encoding(65001, UTF8_NAMES, sizeof(UTF8_NAMES)/sizeof(UTF8_NAMES[0])) {}
+	virtual int GetNameCount() const							{ return sizeof(UTF8_NAMES) / sizeof(UTF8_NAMES[0]); }
+	virtual const wchar_t* GetName(int name_index) const		{ return UTF8_NAMES[name_index]; }
+	virtual bool IsAvailable() const							{ return true; }
+	virtual LONGLONG UTF16ToBytes(const wchar_t* utf16le_str, size_t utf16_chars, char* bytes, size_t byte_count, wstring* error_message=NULL) const;
+	virtual LONGLONG BytesToUTF16(const char* bytes, size_t byte_count, wchar_t* utf16le_str, size_t utf16_chars, wstring* error_message=NULL, size_t* invalid_offset=NULL) const;
+	// a surrogate pair takes 4 bytes and any other code unit at most 3
+	virtual size_t GetMaxByteCount(size_t utf16_chars) const	{ return utf16_chars * 3; }
+	virtual size_t GetMaxUTF16Chars(size_t byte_count) const	{ return byte_count; }
+	virtual size_t GetDecodeChunkSize(const char* bytes, size_t byte_count, size_t max_bytes) const;
+	virtual size_t GetEncodeChunkSize(const wchar_t* utf16le_str, size_t utf16_chars, size_t max_chars) const	{ return GetCharacterChunkSize(utf16le_str, utf16_chars, max_chars); }
 	virtual int GetBOMSizeBytes() const				{ return 3; }
 	virtual const char* GetBOM() const				{ return "\xEF\xBB\xBF"; }
 	virtual int GetFlags() const					{ return eF_CanRepresentAllUniChars; }
 };
 
-//-------------------------------------------------------------------------------------------------
+// The size of the result is calculated in a separate pass only if the destination buffer
+// is smaller than the upper bound.
+LONGLONG UTF8_Encoding::UTF16ToBytes(const wchar_t* utf16le_str, size_t utf16_chars, char* bytes, size_t byte_count, wstring* error_message) const
+{
+	if (!byte_count || byte_count<GetMaxByteCount(utf16_chars))
+	{
+		size_t res = GetUTF8Length(utf16le_str, utf16le_str+utf16_chars);
+		if (!byte_count)
+			return (LONGLONG)res;
+		if (byte_count < res)
+			return DestinationTooSmall(error_message);
+	}
+	return (LONGLONG)(UTF16ToUTF8(utf16le_str, utf16le_str+utf16_chars, bytes) - bytes);
+}
+
+// Returns -1 like the conversion functions on error.
+static LONGLONG InvalidSequence(const char* bytes, const char* invalid, wstring* error_message, size_t* invalid_offset)
+{
+	if (error_message)
+		*error_message = InvalidUTF8Message(invalid - bytes);
+	if (invalid_offset)
+		*invalid_offset = invalid - bytes;
+	return -1;
+}
+
+LONGLONG UTF8_Encoding::BytesToUTF16(const char* bytes, size_t byte_count, wchar_t* utf16le_str, size_t utf16_chars, wstring* error_message, size_t* invalid_offset) const
+{
+	if (!utf16_chars || utf16_chars<GetMaxUTF16Chars(byte_count))
+	{
+		size_t res;
+		const char* invalid = ValidateUTF8(bytes, bytes+byte_count, &res);
+		if (invalid != bytes+byte_count)
+			return InvalidSequence(bytes, invalid, error_message, invalid_offset);
+		if (!utf16_chars)
+			return (LONGLONG)res;
+		if (utf16_chars < res)
+			return DestinationTooSmall(error_message);
+	}
+	wchar_t* dst = utf16le_str;
+	const char* invalid = UTF8ToUTF16(bytes, bytes+byte_count, dst);
+	if (invalid != bytes+byte_count)
+		return InvalidSequence(bytes, invalid, error_message, invalid_offset);
+	return (LONGLONG)(dst - utf16le_str);
+}
 
-CEncodings::CEncodings()
+// Not splitting the sequences, a chunk ends before the lead byte of the last sequence.
+size_t UTF8_Encoding::GetDecodeChunkSize(const char* bytes, size_t byte_count, size_t max_bytes) const
 {
-	static UTF16LE_Encoding utf16le_encoding;
-	AddEncoding(&utf16le_encoding);
-	static UTF8_Encoding utf8_encoding;
-	AddEncoding(&utf8_encoding);
+	if (byte_count <= max_bytes)
+		return byte_count;
+	size_t size = max_bytes;
+	// an invalid sequence is found by the decoder in any case, backing off at most 3 bytes
+	for (int i=0; i<3 && size>0 && (bytes[size] & 0xC0)==0x80; ++i)
+		--size;
+	return size;
+}
+
+//-------------------------------------------------------------------------------------------------
 
 #define REGISTER_CODEPAGE(codepage, ...) \
-	static const wchar_t* CP##codepage##_names[] = { __VA_ARGS__ }; \
-	static Codepage_Encoding CP##codepage##_encoding(codepage, CP##codepage##_names, \
-		sizeof(CP##codepage##_names)/sizeof(CP##codepage##_names[0])); \
-	AddEncoding(&CP##codepage##_encoding);
-
-	 REGISTER_CODEPAGE(20127, L"ASCII", L"us", L"US-ASCII", L"csASCII", L"Windows-20127", L"646", L"ANSI_X3.4-1968", L"ANSI_X3.4-1986", L"ascii7", L"cp367", L"ibm-367", L"IBM367", L"iso-ir-6", L"ISO646-US", L"iso_646.irv:1983", L"ISO_646.irv:1991");
-	 REGISTER_CODEPAGE(1250, L"Windows-1250", L"cp1250", L"ibm-1250", L"ibm-1250_P100-1995", L"ibm-5346", L"ibm-5346_P100-1998");
-	 REGISTER_CODEPAGE(1251, L"Windows-1251", L"cp1251", L"ibm-1251", L"ibm-1251_P100-1995", L"ibm-5347", L"ibm-5347_P100-1998");
-	 REGISTER_CODEPAGE(1252, L"Windows-1252", L"cp1252", L"ibm-1252", L"ibm-1252_P100-2000", L"ibm-5348", L"ibm-5348_P100-1997");
-	 REGISTER_CODEPAGE(1253, L"Windows-1253", L"cp1253", L"ibm-1253", L"ibm-1253_P100-1995", L"ibm-5349", L"ibm-5349_P100-1998");
-	 REGISTER_CODEPAGE(1254, L"Windows-1254", L"cp1254", L"ibm-1254", L"ibm-1254_P100-1995", L"ibm-5350", L"ibm-5350_P100-1998");
-	 REGISTER_CODEPAGE(1255, L"Windows-1255", L"cp1255", L"ibm-1255", L"ibm-1255_P100-1995", L"ibm-9447", L"ibm-9447_P100-2002");
-	 REGISTER_CODEPAGE(1256, L"Windows-1256", L"cp1256", L"ibm-1256", L"ibm-1256_P110-1997", L"ibm-9448", L"ibm-9448_X100-2005", L"x-windows-1256S");
-	 REGISTER_CODEPAGE(1257, L"Windows-1257", L"cp1257", L"ibm-1257", L"ibm-1257_P100-1995", L"ibm-9449", L"ibm-9449_P100-2002");
-	 REGISTER_CODEPAGE(1258, L"Windows-1258", L"cp1258", L"ibm-1258", L"ibm-1258_P100-1997", L"ibm-5354", L"ibm-5354_P100-1998");
-	 REGISTER_CODEPAGE(37, L"IBM037", L"037", L"cp037", L"cpibm37", L"csIBM037", L"ebcdic-cp-ca", L"ebcdic-cp-nl", L"ebcdic-cp-us", L"ebcdic-cp-wt", L"ibm-37", L"ibm-37_P100-1995");
-	REGISTER_CODEPAGE(256, L"ibm-256", L"ibm-256_P100-1995");
-	REGISTER_CODEPAGE(259, L"csIBMSymbols", L"ibm-259", L"ibm-259_P100-1995", L"IBM-Symbols");
-	//REGISTER_CODEPAGE(273, L"IBM273", L"273", L"CP273", L"csIBM273", L"ibm-273", L"ibm-273_P100-1995");
-	REGISTER_CODEPAGE(274, L"IBM274", L"CP274", L"csIBM274", L"EBCDIC-BE", L"ibm-274", L"ibm-274_P100-2000");
-	REGISTER_CODEPAGE(275, L"IBM275", L"cp275", L"csIBM275", L"EBCDIC-BR", L"ibm-275", L"ibm-275_P100-1995");
-	//REGISTER_CODEPAGE(277, L"IBM277", L"277", L"cp277", L"csIBM277", L"EBCDIC-CP-DK", L"EBCDIC-CP-NO", L"ibm-277", L"ibm-277_P100-1995");
-	//REGISTER_CODEPAGE(278, L"IBM278", L"278", L"cp278", L"csIBM278", L"ebcdic-cp-fi", L"ebcdic-cp-se", L"ebcdic-sv", L"ibm-278", L"ibm-278_P100-1995");
-	//REGISTER_CODEPAGE(280, L"IBM280", L"280", L"CP280", L"csIBM280", L"ebcdic-cp-it", L"ibm-280", L"ibm-280_P100-1995");
-	//REGISTER_CODEPAGE(284, L"IBM284", L"284", L"CP284", L"cpibm284", L"csIBM284", L"ebcdic-cp-es", L"ibm-284", L"ibm-284_P100-1995");
-	//REGISTER_CODEPAGE(285, L"IBM285", L"285", L"CP285", L"cpibm285", L"csIBM285", L"ebcdic-cp-gb", L"ebcdic-gb", L"ibm-285", L"ibm-285_P100-1995");
-	REGISTER_CODEPAGE(286, L"ibm-286", L"csEBCDICATDEA", L"EBCDIC-AT-DE-A", L"ibm-286_P100-2003");
-	//REGISTER_CODEPAGE(290, L"IBM290", L"cp290", L"csIBM290", L"EBCDIC-JP-kana", L"ibm-290", L"ibm-290_P100-1995");
-	REGISTER_CODEPAGE(293, L"ibm-293", L"ibm-293_P100-1995");
-	//REGISTER_CODEPAGE(297, L"IBM297", L"297", L"cp297", L"cpibm297", L"csIBM297", L"ebcdic-cp-fr", L"ibm-297", L"ibm-297_P100-1995");
-	REGISTER_CODEPAGE(300, L"ibm-300", L"ibm-300_P120-2006", L"x-IBM300");
-	REGISTER_CODEPAGE(301, L"ibm-301", L"ibm-301_P110-1997", L"x-IBM301");
-	//REGISTER_CODEPAGE(420, L"IBM420", L"420", L"cp420", L"csIBM420", L"ebcdic-cp-ar1", L"ibm-420", L"ibm-420_X120-1999");
-	//REGISTER_CODEPAGE(424, L"IBM424", L"424", L"cp424", L"csIBM424", L"ebcdic-cp-he", L"ibm-424", L"ibm-424_P100-1995");
-	REGISTER_CODEPAGE(425, L"ibm-425", L"ibm-425_P101-2000");
-	 REGISTER_CODEPAGE(437, L"IBM437", L"Windows-437", L"437", L"cp437", L"csPC8CodePage437", L"ibm-437", L"ibm-437_P100-1995");
-	 REGISTER_CODEPAGE(500, L"IBM500", L"CP500", L"csIBM500", L"ebcdic-cp-be", L"ebcdic-cp-ch", L"ibm-500", L"ibm-500_P100-1995");
-	 REGISTER_CODEPAGE(708, L"ASMO-708");
-	 REGISTER_CODEPAGE(720, L"DOS-720", L"Windows-720", L"ibm-720", L"ibm-720_P100-1997", L"x-IBM720");
-	 REGISTER_CODEPAGE(737, L"IBM737", L"Windows-737", L"737", L"cp737", L"ibm-737", L"ibm-737_P100-1997", L"x-IBM737");
-	 REGISTER_CODEPAGE(775, L"IBM775", L"Windows-775", L"775", L"cp775", L"csPC775Baltic", L"ibm-775", L"ibm-775_P100-1996");
-	REGISTER_CODEPAGE(803, L"ibm-803", L"ibm-803_P100-1999");
-	REGISTER_CODEPAGE(806, L"ibm-806", L"ibm-806_P100-1998");
-	REGISTER_CODEPAGE(808, L"ibm-808", L"ibm-808_P100-1999", L"x-IBM808");
-	REGISTER_CODEPAGE(813, L"813", L"8859_7", L"cp813", L"ibm-813", L"ibm-813_P100-1995");
-	//REGISTER_CODEPAGE(819, L"ISO-8859-1", L"819", L"8859_1", L"cp819", L"csISOLatin1", L"ibm-819", L"IBM819", L"iso-ir-100", L"ISO_8859-1:1987", L"l1", L"latin1");
-	REGISTER_CODEPAGE(833, L"ibm-833", L"ibm-833_P100-1995", L"x-IBM833");
-	REGISTER_CODEPAGE(834, L"ibm-834", L"ibm-834_P100-1995", L"x-IBM834");
-	REGISTER_CODEPAGE(835, L"ibm-835", L"ibm-835_P100-1995", L"x-IBM835");
-	REGISTER_CODEPAGE(836, L"ibm-836", L"ibm-836_P100-1995", L"x-IBM836");
-	REGISTER_CODEPAGE(837, L"ibm-837", L"ibm-837_P100-1995", L"x-IBM837");
-	REGISTER_CODEPAGE(848, L"ibm-848", L"ibm-848_P100-1999");
-	REGISTER_CODEPAGE(849, L"ibm-849", L"ibm-849_P100-1999");
-	 REGISTER_CODEPAGE(850, L"IBM850", L"Windows-850", L"850", L"cp850", L"csPC850Multilingual", L"ibm-850", L"ibm-850_P100-1995");
-	 REGISTER_CODEPAGE(851, L"IBM851", L"851", L"cp851", L"csPC851", L"ibm-851", L"ibm-851_P100-1995");
-	 REGISTER_CODEPAGE(852, L"IBM852", L"Windows-852", L"852", L"cp852", L"csPCp852", L"ibm-852", L"ibm-852_P100-1995");
-	 REGISTER_CODEPAGE(855, L"IBM855", L"Windows-855", L"855", L"cp855", L"csIBM855", L"csPCp855", L"ibm-855", L"ibm-855_P100-1995");
-	 REGISTER_CODEPAGE(856, L"IBM856", L"856", L"cp856", L"ibm-856", L"ibm-856_P100-1995", L"x-IBM856");
-	 REGISTER_CODEPAGE(857, L"IBM857", L"Windows-857", L"857", L"cp857", L"csIBM857", L"ibm-857", L"ibm-857_P100-1995");
-	 REGISTER_CODEPAGE(858, L"IBM00858", L"Windows-858", L"CCSID00858", L"CP00858", L"cp858", L"ibm-858", L"ibm-858_P100-1997", L"PC-Multilingual-850+euro");
-	REGISTER_CODEPAGE(859, L"ibm-859", L"ibm-859_P100-1999", L"x-IBM859");
-	 REGISTER_CODEPAGE(860, L"IBM860", L"860", L"cp860", L"csIBM860", L"ibm-860", L"ibm-860_P100-1995");
-	 REGISTER_CODEPAGE(861, L"IBM861", L"Windows-861", L"861", L"cp-is", L"cp861", L"csIBM861", L"ibm-861", L"ibm-861_P100-1995");
-	 REGISTER_CODEPAGE(862, L"DOS-862", L"Windows-862", L"862", L"cp862", L"csPC862LatinHebrew", L"ibm-862", L"ibm-862_P100-1995", L"IBM862");
-	 REGISTER_CODEPAGE(863, L"IBM863", L"863", L"cp863", L"csIBM863", L"ibm-863", L"ibm-863_P100-1995");
-	 REGISTER_CODEPAGE(864, L"IBM864", L"cp864", L"csIBM864", L"ibm-864", L"ibm-864_X110-1999");
-	 REGISTER_CODEPAGE(865, L"IBM865", L"865", L"cp865", L"csIBM865", L"ibm-865", L"ibm-865_P100-1995");
-	 REGISTER_CODEPAGE(866, L"cp866", L"IBM866", L"Windows-866", L"866", L"csIBM866", L"ibm-866", L"ibm-866_P100-1995");
-	REGISTER_CODEPAGE(867, L"ibm-867", L"ibm-867_P100-1998", L"x-IBM867");
-	 REGISTER_CODEPAGE(868, L"IBM868", L"868", L"cp-ar", L"CP868", L"csIBM868", L"ibm-868", L"ibm-868_P100-1995");
-	 REGISTER_CODEPAGE(869, L"IBM869", L"Windows-869", L"869", L"cp-gr", L"cp869", L"csIBM869", L"ibm-869", L"ibm-869_P100-1995");
-	 REGISTER_CODEPAGE(870, L"IBM870", L"CP870", L"csIBM870", L"ebcdic-cp-roece", L"ebcdic-cp-yu", L"ibm-870", L"ibm-870_P100-1995");
-	//REGISTER_CODEPAGE(871, L"IBM871", L"871", L"CP871", L"csIBM871", L"ebcdic-cp-is", L"ebcdic-is", L"ibm-871", L"ibm-871_P100-1995");
-	REGISTER_CODEPAGE(872, L"ibm-872", L"ibm-872_P100-1999");
-	 REGISTER_CODEPAGE(874, L"Windows-874", L"Windows-874-2000", L"MS874", L"TIS-620", L"x-windows-874");
-	 REGISTER_CODEPAGE(875, L"cp875", L"875", L"ibm-875", L"ibm-875_P100-1995", L"IBM875", L"x-IBM875");
-	REGISTER_CODEPAGE(896, L"ibm-896", L"ibm-896_P100-1995");
-	REGISTER_CODEPAGE(897, L"ibm-897", L"csHalfWidthKatakana", L"ibm-897_P100-1995", L"JIS_X0201", L"x-IBM897", L"X0201");
-	REGISTER_CODEPAGE(901, L"ibm-901", L"ibm-901_P100-1999");
-	REGISTER_CODEPAGE(902, L"ibm-902", L"ibm-902_P100-1999");
-	REGISTER_CODEPAGE(916, L"cp916", L"916", L"ibm-916", L"ibm-916_P100-1995");
-	REGISTER_CODEPAGE(918, L"IBM918", L"CP918", L"csIBM918", L"ebcdic-cp-ar2", L"ibm-918", L"ibm-918_P100-1995");
-	REGISTER_CODEPAGE(922, L"IBM922", L"cp922", L"922", L"ibm-922", L"ibm-922_P100-1999", L"x-IBM922");
-	//REGISTER_CODEPAGE(924, L"IBM00924", L"ibm-924", L"CCSID00924", L"CP00924", L"ebcdic-Latin9--euro", L"ibm-924_P100-1998");
-	REGISTER_CODEPAGE(926, L"ibm-926", L"ibm-926_P100-2000");
-	REGISTER_CODEPAGE(927, L"ibm-927", L"ibm-927_P100-1995", L"x-IBM927");
-	REGISTER_CODEPAGE(928, L"ibm-928", L"ibm-928_P100-1995");
-	 REGISTER_CODEPAGE(932, L"shift_jis", L"shift-jis", L"Windows-932", L"cp932", L"Windows-31j", L"cp943c", L"csShiftJIS", L"csWindows31J", L"ibm-932", L"ibm-942", L"ibm-942_P12A-1999", L"ibm-943_P15A-2003", L"MS_Kanji", L"x-IBM942", L"x-IBM942C", L"x-JISAutoDetect", L"x-ms-cp932", L"x-MS932_0213", L"x-sjis");
-	REGISTER_CODEPAGE(933, L"ibm-933", L"933", L"cp933", L"ibm-933_P110-1995", L"x-IBM933");
-	REGISTER_CODEPAGE(935, L"ibm-935", L"935", L"cp935", L"ibm-935_P110-1999", L"x-IBM935");
-	 REGISTER_CODEPAGE(936, L"gb2312", L"csGB2312", L"Windows-936", L"Windows-936-2000", L"CP936", L"GBK", L"MS936");
-	REGISTER_CODEPAGE(937, L"ibm-937", L"937", L"cp937", L"ibm-937_P110-1999", L"x-IBM937");
-	REGISTER_CODEPAGE(941, L"ibm-941", L"ibm-941_P13A-2001");
-	REGISTER_CODEPAGE(943, L"ibm-943", L"943", L"cp943", L"ibm-943_P130-1999", L"x-IBM943");
-	REGISTER_CODEPAGE(944, L"ibm-944", L"ibm-944_P100-1995");
-	REGISTER_CODEPAGE(946, L"ibm-946", L"ibm-946_P100-1995");
-	REGISTER_CODEPAGE(947, L"ibm-947", L"ibm-947_P100-1995", L"x-IBM947");
-	REGISTER_CODEPAGE(948, L"ibm-948", L"ibm-948_P110-1999", L"x-IBM948");
-	 REGISTER_CODEPAGE(949, L"ks_c_5601-1987", L"Windows-949", L"Windows-949-2000", L"949", L"cp949", L"csKSC56011987", L"ibm-949", L"ibm-949_P110-1999", L"iso-ir-149", L"korean", L"KS_C_5601-1989", L"KSC_5601", L"ms949", L"x-IBM949", L"x-KSC5601");
-	 REGISTER_CODEPAGE(950, L"big5", L"Windows-950", L"Windows-950-2000", L"950", L"cp950", L"csBig5", L"ibm-950", L"ibm-950_P110-1999", L"x-IBM950", L"x-windows-950");
-	REGISTER_CODEPAGE(951, L"ibm-951", L"ibm-951_P100-1995", L"x-IBM951");
-	REGISTER_CODEPAGE(952, L"ibm-952", L"ibm-952_P110-1997");
-	REGISTER_CODEPAGE(953, L"ibm-953", L"ibm-953_P100-2000", L"JIS_X0212-1990");
-	REGISTER_CODEPAGE(954, L"ibm-954", L"eucjis", L"ibm-954_P101-2007", L"x-IBM954", L"x-IBM954C");
-	REGISTER_CODEPAGE(955, L"ibm-955", L"ibm-955_P110-1997");
-	REGISTER_CODEPAGE(964, L"ibm-964", L"964", L"cp964", L"ibm-964_P110-1999", L"x-IBM964");
-	REGISTER_CODEPAGE(971, L"ibm-971", L"x-IBM971");
-	REGISTER_CODEPAGE(1004, L"ibm-1004", L"ibm-1004_P100-1995");
-	REGISTER_CODEPAGE(1006, L"IBM1006", L"1006", L"cp1006", L"ibm-1006", L"ibm-1006_P100-1995", L"x-IBM1006");
-	REGISTER_CODEPAGE(1008, L"ibm-1008", L"ibm-1008_P100-1995");
-	REGISTER_CODEPAGE(1009, L"ibm-1009", L"ibm-1009_P100-1995");
-	REGISTER_CODEPAGE(1010, L"ibm-1010", L"csISO69French", L"fr", L"ibm-1010_P100-1995", L"iso-ir-69", L"ISO646-FR", L"NF_Z_62-010");
-	REGISTER_CODEPAGE(1011, L"ibm-1011", L"csISO21German", L"de", L"DIN_66003", L"ibm-1011_P100-1995", L"iso-ir-21", L"ISO646-DE");
-	REGISTER_CODEPAGE(1012, L"ibm-1012", L"csISO15Italian", L"ibm-1012_P100-1995", L"iso-ir-15", L"ISO646-IT", L"IT");
-	REGISTER_CODEPAGE(1013, L"ibm-1013", L"BS_4730", L"csISO4UnitedKingdom", L"gb", L"ibm-1013_P100-1995", L"iso-ir-4", L"ISO646-GB", L"uk");
-	REGISTER_CODEPAGE(1014, L"ibm-1014", L"csISO85Spanish2", L"ES2", L"ibm-1014_P100-1995", L"iso-ir-85", L"ISO646-ES2");
-	REGISTER_CODEPAGE(1015, L"ibm-1015", L"csISO84Portuguese2", L"ibm-1015_P100-1995", L"iso-ir-84", L"ISO646-PT2", L"PT2");
-	REGISTER_CODEPAGE(1016, L"ibm-1016", L"csISO60DanishNorwegian", L"csISO60Norwegian1", L"ibm-1016_P100-1995", L"iso-ir-60", L"ISO646-NO", L"no", L"NS_4551-1");
-	REGISTER_CODEPAGE(1017, L"ibm-1017", L"ibm-1017_P100-1995");
-	REGISTER_CODEPAGE(1018, L"ibm-1018", L"csISO10Swedish", L"FI", L"ibm-1018_P100-1995", L"iso-ir-10", L"ISO646-FI", L"ISO646-SE", L"se", L"SEN_850200_B");
-	REGISTER_CODEPAGE(1019, L"ibm-1019", L"ibm-1019_P100-1995");
-	REGISTER_CODEPAGE(1020, L"ibm-1020", L"ca", L"csa7-1", L"CSA_Z243.4-1985-1", L"csISO121Canadian1", L"ibm-1020_P100-2003", L"iso-ir-121", L"ISO646-CA");
-	REGISTER_CODEPAGE(1021, L"ibm-1021", L"ibm-1021_P100-2003");
-	REGISTER_CODEPAGE(1023, L"ibm-1023", L"csISO17Spanish", L"ES", L"ibm-1023_P100-2003", L"iso-ir-17", L"ISO646-ES");
-	//REGISTER_CODEPAGE(1025, L"cp1025", L"ibm-1025", L"1025", L"ibm-1025_P100-1995", L"x-IBM1025");
-	 REGISTER_CODEPAGE(1026, L"IBM1026", L"ibm-1026", L"1026", L"CP1026", L"csIBM1026", L"ibm-1026_P100-1995");
-	REGISTER_CODEPAGE(1027, L"ibm-1027", L"ibm-1027_P100-1995", L"x-IBM1027");
-	REGISTER_CODEPAGE(1041, L"ibm-1041", L"ibm-1041_P100-1995", L"x-IBM1041");
-	REGISTER_CODEPAGE(1043, L"ibm-1043", L"ibm-1043_P100-1995", L"x-IBM1043");
-	REGISTER_CODEPAGE(1046, L"ibm-1046", L"ibm-1046_X110-1999", L"x-IBM1046", L"x-IBM1046S");
-	 REGISTER_CODEPAGE(1047, L"IBM1047", L"ibm01047", L"1047", L"cp1047", L"ibm-1047", L"ibm-1047_P100-1995");
-	REGISTER_CODEPAGE(1051, L"ibm-1051", L"csHPRoman8", L"hp-roman8", L"ibm-1051_P100-1995", L"r8", L"roman8");
-	REGISTER_CODEPAGE(1088, L"ibm-1088", L"ibm-1088_P100-1995", L"x-IBM1088");
-	REGISTER_CODEPAGE(1097, L"ibm-1097", L"1097", L"cp1097", L"ibm-1097_P100-1995", L"x-IBM1097");
-	REGISTER_CODEPAGE(1098, L"ibm-1098", L"1098", L"cp1098", L"ibm-1098_P100-1995", L"IBM1098", L"x-IBM1098");
-	REGISTER_CODEPAGE(1100, L"ibm-1100", L"csDECMCS", L"dec", L"DEC-MCS", L"ibm-1100_P100-2003");
-	REGISTER_CODEPAGE(1101, L"ibm-1101", L"ibm-1101_P100-2003");
-	REGISTER_CODEPAGE(1102, L"ibm-1102", L"ibm-1102_P100-2003");
-	REGISTER_CODEPAGE(1103, L"ibm-1103", L"ibm-1103_P100-2003");
-	REGISTER_CODEPAGE(1104, L"ibm-1104", L"csISO25French", L"ibm-1104_P100-2003", L"iso-ir-25", L"ISO646-FR1");
-	REGISTER_CODEPAGE(1105, L"ibm-1105", L"ibm-1105_P100-2003");
-	REGISTER_CODEPAGE(1106, L"ibm-1106", L"ibm-1106_P100-2003");
-	REGISTER_CODEPAGE(1107, L"ibm-1107", L"csISO646Danish", L"dk", L"DS_2089", L"ibm-1107_P100-2003", L"ISO646-DK");
-	REGISTER_CODEPAGE(1112, L"ibm-1112", L"1112", L"cp1112", L"ibm-1112_P100-1995", L"x-IBM1112");
-	REGISTER_CODEPAGE(1114, L"ibm-1114", L"ibm-1114_P100-2001", L"x-IBM1114");
-	REGISTER_CODEPAGE(1115, L"ibm-1115", L"ibm-1115_P100-1995", L"x-IBM1115");
-	REGISTER_CODEPAGE(1122, L"ibm-1122", L"1122", L"cp1122", L"ibm-1122_P100-1999", L"x-IBM1122");
-	REGISTER_CODEPAGE(1123, L"ibm-1123", L"1123", L"cp1123", L"ibm-1123_P100-1995", L"x-IBM1123");
-	REGISTER_CODEPAGE(1124, L"ibm-1124", L"cp1124", L"1124", L"ibm-1124_P100-1996", L"x-IBM1124");
-	REGISTER_CODEPAGE(1125, L"ibm-1125", L"ibm-1125_P100-1997");
-	REGISTER_CODEPAGE(1127, L"ibm-1127", L"ibm-1127_P100-2004");
-	REGISTER_CODEPAGE(1129, L"ibm-1129", L"ibm-1129_P100-1997");
-	REGISTER_CODEPAGE(1130, L"ibm-1130", L"ibm-1130_P100-1997");
-	REGISTER_CODEPAGE(1131, L"ibm-1131", L"ibm-1131_P100-1997");
-	REGISTER_CODEPAGE(1132, L"ibm-1132", L"ibm-1132_P100-1998");
-	REGISTER_CODEPAGE(1133, L"ibm-1133", L"ibm-1133_P100-1997");
-	REGISTER_CODEPAGE(1137, L"ibm-1137", L"ibm-1137_P100-1999");
-	 REGISTER_CODEPAGE(1140, L"IBM01140", L"CCSID01140", L"CP01140", L"cp1140", L"ebcdic-us-37+euro", L"ibm-1140", L"ibm-1140_P100-1997");
-	 REGISTER_CODEPAGE(1141, L"IBM01141", L"CCSID01141", L"CP01141", L"cp1141", L"ebcdic-de-273+euro", L"ibm-1141", L"ibm-1141_P100-1997");
-	 REGISTER_CODEPAGE(1142, L"IBM01142", L"CCSID01142", L"CP01142", L"cp1142", L"ebcdic-dk-277+euro", L"ebcdic-no-277+euro", L"ibm-1142", L"ibm-1142_P100-1997");
-	 REGISTER_CODEPAGE(1143, L"IBM01143", L"CCSID01143", L"CP01143", L"cp1143", L"ebcdic-fi-278+euro", L"ebcdic-se-278+euro", L"ibm-1143", L"ibm-1143_P100-1997");
-	 REGISTER_CODEPAGE(1144, L"IBM01144", L"CCSID01144", L"CP01144", L"cp1144", L"ebcdic-it-280+euro", L"ibm-1144", L"ibm-1144_P100-1997");
-	 REGISTER_CODEPAGE(1145, L"IBM01145", L"CCSID01145", L"CP01145", L"cp1145", L"ebcdic-es-284+euro", L"ibm-1145", L"ibm-1145_P100-1997");
-	 REGISTER_CODEPAGE(1146, L"IBM01146", L"CCSID01146", L"CP01146", L"cp1146", L"ebcdic-gb-285+euro", L"ibm-1146", L"ibm-1146_P100-1997");
-	 REGISTER_CODEPAGE(1147, L"IBM01147", L"CCSID01147", L"CP01147", L"cp1147", L"ebcdic-fr-297+euro", L"ibm-1147", L"ibm-1147_P100-1997");
-	 REGISTER_CODEPAGE(1148, L"IBM01148", L"CCSID01148", L"CP01148", L"cp1148", L"ebcdic-international-500+euro", L"ibm-1148", L"ibm-1148_P100-1997");
-	 REGISTER_CODEPAGE(1149, L"IBM01149", L"CCSID01149", L"CP01149", L"cp1149", L"ebcdic-is-871+euro", L"ibm-1149", L"ibm-1149_P100-1997");
-	REGISTER_CODEPAGE(1153, L"ibm-1153", L"ibm-1153_P100-1999", L"IBM1153", L"x-IBM1153");
-	REGISTER_CODEPAGE(1154, L"ibm-1154", L"ibm-1154_P100-1999");
-	REGISTER_CODEPAGE(1155, L"ibm-1155", L"ibm-1155_P100-1999");
-	REGISTER_CODEPAGE(1156, L"ibm-1156", L"ibm-1156_P100-1999");
-	REGISTER_CODEPAGE(1157, L"ibm-1157", L"ibm-1157_P100-1999");
-	REGISTER_CODEPAGE(1158, L"ibm-1158", L"ibm-1158_P100-1999");
-	REGISTER_CODEPAGE(1160, L"ibm-1160", L"ibm-1160_P100-1999");
-	REGISTER_CODEPAGE(1161, L"ibm-1161", L"ibm-1161_P100-1999");
-	REGISTER_CODEPAGE(1162, L"ibm-1162", L"ibm-1162_P100-1999");
-	REGISTER_CODEPAGE(1163, L"ibm-1163", L"ibm-1163_P100-1999");
-	REGISTER_CODEPAGE(1164, L"ibm-1164", L"ibm-1164_P100-1999");
-	REGISTER_CODEPAGE(1165, L"ibm-1165", L"ibm-1165_P101-2000");
-	REGISTER_CODEPAGE(1166, L"ibm-1166", L"ibm-1166_P100-2002");
-	REGISTER_CODEPAGE(1167, L"ibm-1167", L"ibm-1167_P100-2002", L"x-KOI8_RU");
-	REGISTER_CODEPAGE(1174, L"ibm-1174", L"csKZ1048", L"ibm-1174_X100-2007", L"KZ-1048", L"RK1048", L"STRK1048-2002");
-	//REGISTER_CODEPAGE(1200, L"utf-16", L"Windows-1200", L"ibm-1202", L"ibm-1203", L"ibm-13490", L"ibm-13491", L"ibm-17586", L"ibm-17587", L"ibm-21682", L"ibm-21683", L"ibm-25778", L"ibm-25779", L"ibm-29874", L"ibm-29875", L"UnicodeLittleUnmarked");
-	//REGISTER_CODEPAGE(1201, L"unicodeFFFE", L"Windows-1201", L"ibm-1200", L"ibm-1201", L"ibm-13488", L"ibm-13489", L"ibm-17584", L"ibm-17585", L"ibm-21680", L"ibm-21681", L"ibm-25776", L"ibm-25777", L"ibm-29872", L"ibm-29873", L"ibm-61955", L"ibm-61956", L"UnicodeBigUnmarked");
-	REGISTER_CODEPAGE(1205, L"ibm-1204", L"ibm-1205", L"ISO-10646-UCS-2");
-	REGISTER_CODEPAGE(1213, L"ibm-1212", L"ibm-1213", L"SCSU");
-	REGISTER_CODEPAGE(1215, L"ibm-1215", L"ibm-1214", L"BOCU-1", L"csBOCU-1");
-	REGISTER_CODEPAGE(1235, L"ibm-1235", L"ibm-1234");
-	REGISTER_CODEPAGE(1237, L"ibm-1237", L"ibm-1236", L"ISO-10646-UCS-4");
-	REGISTER_CODEPAGE(1276, L"ibm-1276", L"Adobe-Standard-Encoding", L"csAdobeStandardEncoding", L"ibm-1276_P100-1995");
-	REGISTER_CODEPAGE(1277, L"ibm-1277", L"ibm-1277_P100-1995");
-	REGISTER_CODEPAGE(1350, L"ibm-1350", L"eucJP-Open", L"ibm-1350_P110-1997", L"x-eucJP-Open");
-	REGISTER_CODEPAGE(1351, L"ibm-1351", L"ibm-1351_P110-1997", L"x-IBM1351");
-	 REGISTER_CODEPAGE(1361, L"Johab");
-	REGISTER_CODEPAGE(1362, L"ibm-1362", L"ibm-1362_P110-1999", L"x-IBM1362");
-	REGISTER_CODEPAGE(1363, L"ibm-1363", L"cp1363", L"ibm-1363_P110-1997", L"ibm-1363_P11B-1998", L"x-IBM1363", L"x-IBM1363C");
-	REGISTER_CODEPAGE(1364, L"ibm-1364", L"ibm-1364_P110-2007", L"x-IBM1364");
-	REGISTER_CODEPAGE(1370, L"ibm-1370", L"ibm-1370_P100-1999", L"x-IBM1370");
-	REGISTER_CODEPAGE(1371, L"ibm-1371", L"ibm-1371_P100-1999", L"x-IBM1371");
-	REGISTER_CODEPAGE(1373, L"ibm-1373", L"ibm-1373_P100-2002");
-	REGISTER_CODEPAGE(1375, L"ibm-1375", L"Big5-HKSCS", L"big5hk", L"ibm-1375_P100-2007");
-	REGISTER_CODEPAGE(1380, L"ibm-1380", L"ibm-1380_P100-1995", L"x-IBM1380");
-	REGISTER_CODEPAGE(1381, L"ibm-1381", L"1381", L"cp1381", L"ibm-1381_P110-1999", L"x-IBM1381");
-	REGISTER_CODEPAGE(1382, L"ibm-1382", L"ibm-1382_P100-1995", L"x-IBM1382");
-	REGISTER_CODEPAGE(1383, L"ibm-1383", L"1383", L"cp1383", L"ibm-1383_P110-1999");
-	REGISTER_CODEPAGE(1385, L"ibm-1385", L"ibm-9577", L"ibm-9577_P100-2001", L"x-IBM1385");
-	REGISTER_CODEPAGE(1386, L"ibm-1386", L"ibm-1386_P100-2001");
-	REGISTER_CODEPAGE(1390, L"ibm-1390", L"ibm-1390_P110-2003", L"x-IBM1390");
-	REGISTER_CODEPAGE(1399, L"ibm-1399", L"ibm-1399_P110-2003", L"x-IBM1399");
-	REGISTER_CODEPAGE(4517, L"ibm-4517", L"ibm-4517_P100-2005");
-	REGISTER_CODEPAGE(4899, L"ibm-4899", L"ibm-4899_P100-1998");
-	REGISTER_CODEPAGE(4909, L"ibm-4909", L"ibm-4909_P100-1999");
-	REGISTER_CODEPAGE(4930, L"ibm-4930", L"ibm-4930_P110-1999");
-	REGISTER_CODEPAGE(4933, L"ibm-4933", L"ibm-4933_P100-2002");
-	REGISTER_CODEPAGE(4948, L"ibm-4948", L"ibm-4948_P100-1995");
-	REGISTER_CODEPAGE(4951, L"ibm-4951", L"ibm-4951_P100-1995");
-	REGISTER_CODEPAGE(4952, L"ibm-4952", L"ibm-4952_P100-1995");
-	REGISTER_CODEPAGE(4960, L"ibm-4960", L"ibm-4960_P100-1995");
-	REGISTER_CODEPAGE(4971, L"ibm-4971", L"ibm-4971_P100-1999");
-	REGISTER_CODEPAGE(5026, L"ibm-5026", L"930", L"cp930", L"ibm-930", L"ibm-930_P120-1999", L"IBM930", L"x-IBM930", L"x-IBM930A");
-	REGISTER_CODEPAGE(5035, L"ibm-5035", L"939", L"cp939", L"ibm-931", L"ibm-939", L"ibm-939_P120-1999", L"IBM939", L"x-IBM939", L"x-IBM939A");
-	REGISTER_CODEPAGE(5039, L"ibm-5039", L"ibm-5039_P11A-1998");
-	REGISTER_CODEPAGE(5048, L"ibm-5048", L"ibm-5048_P100-1995");
-	REGISTER_CODEPAGE(5049, L"ibm-5049", L"ibm-5049_P100-1995");
-	REGISTER_CODEPAGE(5050, L"ibm-5050", L"33722", L"cp33722", L"ibm-33722", L"ibm-33722_P120-1999", L"x-IBM33722", L"x-IBM33722A", L"x-IBM33722C");
-	REGISTER_CODEPAGE(5054, L"ibm-5054", L"csJISEncoding", L"ISO-2022-JP-1", L"JIS_Encoding", L"x-windows-50221");
-	REGISTER_CODEPAGE(5067, L"ibm-5067", L"ibm-5067_P100-1995");
-	REGISTER_CODEPAGE(5104, L"ibm-5104", L"ibm-5104_X110-1999");
-	REGISTER_CODEPAGE(5123, L"ibm-5123", L"ibm-5123_P100-1999");
-	REGISTER_CODEPAGE(5351, L"ibm-5351", L"ibm-5351_P100-1998");
-	REGISTER_CODEPAGE(5352, L"ibm-5352", L"ibm-5352_P100-1998");
-	REGISTER_CODEPAGE(5353, L"ibm-5353", L"ibm-5353_P100-1998");
-	REGISTER_CODEPAGE(5471, L"ibm-5471", L"ibm-5471_P100-2006", L"MS950_HKSCS", L"x-MS950-HKSCS");
-	REGISTER_CODEPAGE(5478, L"ibm-5478", L"chinese", L"csISO58GB231280", L"GB_2312-80", L"ibm-5478_P100-1995", L"iso-ir-58");
-	REGISTER_CODEPAGE(8482, L"ibm-8482", L"ibm-8482_P100-1999");
-	REGISTER_CODEPAGE(8612, L"ibm-8612", L"ibm-8612_P100-1995");
-	REGISTER_CODEPAGE(9027, L"ibm-9027", L"ibm-9027_P100-1999");
-	REGISTER_CODEPAGE(9048, L"ibm-9048", L"ibm-9048_P100-1998");
-	REGISTER_CODEPAGE(9056, L"ibm-9056", L"ibm-9056_P100-1995");
-	REGISTER_CODEPAGE(9061, L"ibm-9061", L"ibm-9061_P100-1999");
-	REGISTER_CODEPAGE(9066, L"ibm-9066", L"cp874", L"ibm-874", L"ibm-874_P100-1995", L"tis620.2533", L"x-IBM874");
-	REGISTER_CODEPAGE(9067, L"ibm-9067", L"ibm-9067_X100-2005");
-	REGISTER_CODEPAGE(9145, L"ibm-9145", L"ibm-9145_P110-1997");
-	REGISTER_CODEPAGE(9238, L"ibm-9238", L"ibm-9238_X110-1999");
-	REGISTER_CODEPAGE(9400, L"CESU-8", L"ibm-9400");
-	REGISTER_CODEPAGE(9424, L"ibm-1232", L"ibm-1233", L"ibm-9424");
-	REGISTER_CODEPAGE(9580, L"ibm-1388", L"ibm-1388_P103-2001", L"ibm-9580", L"x-IBM1388");
-	 REGISTER_CODEPAGE(10000, L"macintosh", L"Windows-10000", L"csMacintosh", L"mac", L"macos-0_2-10.2", L"macroman", L"x-macroman");
-	 REGISTER_CODEPAGE(10001, L"x-mac-japanese");
-	 REGISTER_CODEPAGE(10002, L"x-mac-chinesetrad");
-	 REGISTER_CODEPAGE(10003, L"x-mac-korean");
-	 REGISTER_CODEPAGE(10004, L"x-mac-arabic");
-	 REGISTER_CODEPAGE(10005, L"x-mac-hebrew");
-	 REGISTER_CODEPAGE(10006, L"x-mac-greek", L"Windows-10006", L"macos-6_2-10.4", L"x-MacGreek");
-	 REGISTER_CODEPAGE(10007, L"x-mac-cyrillic", L"Windows-10007", L"macos-7_3-10.2", L"x-MacCyrillic", L"x-MacUkraine");
-	 REGISTER_CODEPAGE(10008, L"x-mac-chinesesimp");
-	 REGISTER_CODEPAGE(10010, L"x-mac-romanian");
-	 REGISTER_CODEPAGE(10017, L"x-mac-ukrainian");
-	 REGISTER_CODEPAGE(10021, L"x-mac-thai");
-	 REGISTER_CODEPAGE(10029, L"x-mac-ce", L"Windows-10029", L"macos-29-10.2", L"x-mac-centraleurroman", L"x-MacCentralEurope");
-	 REGISTER_CODEPAGE(10079, L"x-mac-icelandic");
-	 REGISTER_CODEPAGE(10081, L"x-mac-turkish", L"Windows-10081", L"macos-35-10.2", L"x-MacTurkish");
-	 REGISTER_CODEPAGE(10082, L"x-mac-croatian");
-	 //REGISTER_CODEPAGE(12000, L"utf-32");
-	 //REGISTER_CODEPAGE(12001, L"utf-32BE");
-	REGISTER_CODEPAGE(12712, L"ibm-12712", L"ibm-12712_P100-1998");
-	REGISTER_CODEPAGE(13125, L"ibm-13125", L"ibm-13125_P100-1997");
-	REGISTER_CODEPAGE(13140, L"ibm-13140", L"ibm-13140_P101-2000");
-	REGISTER_CODEPAGE(13218, L"ibm-13218", L"ibm-13218_P100-1996");
-	REGISTER_CODEPAGE(13676, L"ibm-13676", L"ibm-13676_P102-2001");
-	REGISTER_CODEPAGE(16804, L"ibm-16804", L"ibm-16804_X110-1999");
-	REGISTER_CODEPAGE(17221, L"ibm-17221", L"ibm-17221_P100-2001");
-	REGISTER_CODEPAGE(17248, L"ibm-17248", L"ibm-17248_X110-1999");
-	 REGISTER_CODEPAGE(20000, L"x-chinese-cns", L"x-Chinese_CNS");
-	 REGISTER_CODEPAGE(20001, L"x-cp20001");
-	 REGISTER_CODEPAGE(20002, L"x-chinese-eten", L"x_Chinese-Eten");
-	 REGISTER_CODEPAGE(20003, L"x-cp20003");
-	 REGISTER_CODEPAGE(20004, L"x-cp20004");
-	 REGISTER_CODEPAGE(20005, L"x-cp20005");
-	 REGISTER_CODEPAGE(20105, L"x-IA5");
-	 REGISTER_CODEPAGE(20106, L"x-IA5-German");
-	 REGISTER_CODEPAGE(20107, L"x-IA5-Swedish");
-	 REGISTER_CODEPAGE(20108, L"x-IA5-Norwegian");
-	 //REGISTER_CODEPAGE(20261, L"x-cp20261");
-	 //REGISTER_CODEPAGE(20269, L"x-cp20269");
-	 REGISTER_CODEPAGE(20273, L"IBM273");
-	 REGISTER_CODEPAGE(20277, L"IBM277");
-	 REGISTER_CODEPAGE(20278, L"IBM278");
-	 REGISTER_CODEPAGE(20280, L"IBM280");
-	 REGISTER_CODEPAGE(20284, L"IBM284");
-	 REGISTER_CODEPAGE(20285, L"IBM285");
-	 REGISTER_CODEPAGE(20290, L"IBM290");
-	 REGISTER_CODEPAGE(20297, L"IBM297");
-	 REGISTER_CODEPAGE(20420, L"IBM420");
-	 REGISTER_CODEPAGE(20423, L"IBM423");
-	 REGISTER_CODEPAGE(20424, L"IBM424");
-	 REGISTER_CODEPAGE(20780, L"ibm-16684", L"ibm-16684_P110-2003", L"ibm-20780");
-	 REGISTER_CODEPAGE(20833, L"x-EBCDIC-KoreanExtended");
-	 REGISTER_CODEPAGE(20838, L"IBM-Thai");
-	 REGISTER_CODEPAGE(20866, L"koi8-r", L"koi", L"koi8r", L"ibm-878", L"Windows-20866", L"csKOI8R", L"ibm-878_P100-1996", L"koi8");
-	 REGISTER_CODEPAGE(20871, L"IBM871");
-	 REGISTER_CODEPAGE(20880, L"IBM880", L"ibm-880", L"Windows-20880", L"cp880", L"csIBM880", L"EBCDIC-Cyrillic", L"ibm-880_P100-1995");
-	 REGISTER_CODEPAGE(20905, L"IBM905", L"ibm-905", L"Windows-20905", L"CP905", L"csIBM905", L"ebcdic-cp-tr", L"ibm-905_P100-1995");
-	 REGISTER_CODEPAGE(20924, L"IBM00924");
-	 REGISTER_CODEPAGE(20936, L"x-cp20936");
-	 REGISTER_CODEPAGE(20949, L"x-cp20949");
-	 REGISTER_CODEPAGE(21025, L"cp1025");
-	REGISTER_CODEPAGE(21344, L"ibm-21344", L"ibm-21344_P101-2000");
-	REGISTER_CODEPAGE(21427, L"ibm-21427", L"ibm-21427_P100-1999");
-	 REGISTER_CODEPAGE(21866, L"koi8-u", L"koi8-ru", L"Windows-21866", L"ibm-1168", L"ibm-1168_P100-2002");
-	REGISTER_CODEPAGE(25546, L"ibm-25546");
-	 REGISTER_CODEPAGE(28591, L"ISO-8859-1");
-	 REGISTER_CODEPAGE(28592, L"ISO-8859-2", L"Windows-28592", L"8859_2", L"912", L"cp912", L"csISOLatin2", L"ibm-912", L"ibm-912_P100-1995", L"iso-ir-101", L"ISO_8859-2:1987", L"l2", L"latin2");
-	 REGISTER_CODEPAGE(28593, L"ISO-8859-3", L"Windows-28593", L"8859_3", L"913", L"cp913", L"csISOLatin3", L"ibm-913", L"ibm-913_P100-2000", L"iso-ir-109", L"ISO_8859-3:1988", L"l3", L"latin3");
-	 REGISTER_CODEPAGE(28594, L"ISO-8859-4", L"Windows-28594", L"8859_4", L"914", L"cp914", L"csISOLatin4", L"ibm-914", L"ibm-914_P100-1995", L"iso-ir-110", L"ISO_8859-4:1988", L"l4", L"latin4");
-	 REGISTER_CODEPAGE(28595, L"ISO-8859-5", L"Windows-28595", L"8859_5", L"915", L"cp915", L"csISOLatinCyrillic", L"cyrillic", L"ibm-915", L"ibm-915_P100-1995", L"iso-ir-144", L"ISO_8859-5:1988");
-	 REGISTER_CODEPAGE(28596, L"ISO-8859-6", L"Windows-28596", L"1089", L"8859_6", L"arabic", L"cp1089", L"csISOLatinArabic", L"ECMA-114", L"ibm-1089", L"ibm-1089_P100-1995", L"ISO-8859-6-E", L"ISO-8859-6-I", L"iso-ir-127", L"ISO_8859-6:1987", L"x-ISO-8859-6S");
-	 REGISTER_CODEPAGE(28597, L"ISO-8859-7", L"Windows-28597", L"csISOLatinGreek", L"ECMA-118", L"ELOT_928", L"greek", L"greek8", L"ibm-9005", L"ibm-9005_X110-2007", L"iso-ir-126", L"ISO_8859-7:1987");
-	 REGISTER_CODEPAGE(28598, L"ISO-8859-8", L"Windows-28598", L"8859_8", L"csISOLatinHebrew", L"hebrew", L"ibm-5012", L"ibm-5012_P100-1999", L"ISO-8859-8-E", L"iso-ir-138", L"ISO_8859-8:1988");
-	 REGISTER_CODEPAGE(28599, L"ISO-8859-9", L"Windows-28599", L"8859_9", L"920", L"cp920", L"csISOLatin5", L"ibm-920", L"ibm-920_P100-1995", L"iso-ir-148", L"ISO_8859-9:1989", L"l5", L"latin5");
-	 REGISTER_CODEPAGE(28603, L"ISO-8859-13", L"Windows-28603", L"8859_13", L"ibm-921", L"ibm-921_P100-1995", L"x-IBM921");
-	 REGISTER_CODEPAGE(28605, L"ISO-8859-15", L"Windows-28605", L"8859_15", L"923", L"cp923", L"csisolatin0", L"csisolatin9", L"ibm-923", L"ibm-923_P100-1998", L"iso8859_15_fdis", L"l9", L"Latin-9", L"latin0");
-	 REGISTER_CODEPAGE(29001, L"x-Europa");
-	REGISTER_CODEPAGE(33058, L"ibm-33058", L"ibm-33058_P100-2000");
-	 REGISTER_CODEPAGE(38598, L"iso-8859-8-i");
-	 REGISTER_CODEPAGE(50220, L"iso-2022-jp");
-	 REGISTER_CODEPAGE(50221, L"csISO2022JP");
-	 REGISTER_CODEPAGE(50225, L"iso-2022-kr");
-	 REGISTER_CODEPAGE(50227, L"x-cp50227");
-	 REGISTER_CODEPAGE(50931, L"x-EBCDIC-JapaneseAndUSCanada");
-	 REGISTER_CODEPAGE(51932, L"euc-jp", L"Windows-51932", L"csEUCPkdFmtJapanese", L"Extended_UNIX_Code_Packed_Format_for_Japanese", L"ibm-33722_P12A_P12A-2004_U2", L"X-EUC-JP");
-	 REGISTER_CODEPAGE(51936, L"EUC-CN");
-	 REGISTER_CODEPAGE(51949, L"EUC-KR", L"Windows-51949", L"5601", L"970", L"cp970", L"csEUCKR", L"ibm-970", L"ibm-970_P110_P110-2006_U2", L"ibm-eucKR", L"x-IBM970");
-	 REGISTER_CODEPAGE(52936, L"hz-gb-2312");
-	 REGISTER_CODEPAGE(54936, L"gb18030", L"Windows-54936", L"ibm-1392");
-	 REGISTER_CODEPAGE(57002, L"x-iscii-de", L"Windows-57002", L"ibm-4902", L"x-ISCII91");
-	 REGISTER_CODEPAGE(57003, L"x-iscii-be");
-	 REGISTER_CODEPAGE(57004, L"x-iscii-ta", L"Windows-57004");
-	 REGISTER_CODEPAGE(57005, L"x-iscii-te", L"Windows-57005");
-	 REGISTER_CODEPAGE(57006, L"x-iscii-as", L"Windows-57003", L"Windows-57006");
-	 REGISTER_CODEPAGE(57007, L"x-iscii-or", L"Windows-57007");
-	 REGISTER_CODEPAGE(57008, L"x-iscii-ka", L"Windows-57008");
-	 REGISTER_CODEPAGE(57009, L"x-iscii-ma", L"Windows-57009");
-	 REGISTER_CODEPAGE(57010, L"x-iscii-gu", L"Windows-57010");
-	 REGISTER_CODEPAGE(57011, L"x-iscii-pa", L"Windows-57011");
-	// TODO: utf7 needs BOM detection
-	//REGISTER_CODEPAGE(65000, L"UTF-7", L"UTF7", L"Windows-65000");
-	REGISTER_CODEPAGE(65025, L"ibm-65025");
+	static const wchar_t* CP##codepage##_names[] = { __VA_ARGS__ };
+#include "EncodingList.h"
+#undef REGISTER_CODEPAGE
+
+struct SEncodingInfo
+{
+	UINT codepage;
+	const wchar_t** names;
+	int name_count;
+};
+
+#define NAME_COUNT(names) (int)(sizeof(names)/sizeof(names[0]))
 
+// Indexed like the encodings of EncodingNameHash.h.
+static const SEncodingInfo ENCODINGS[] =
+{
+	{ 1200, UTF16LE_NAMES, NAME_COUNT(UTF16LE_NAMES) },
+	{ 65001, UTF8_NAMES, NAME_COUNT(UTF8_NAMES) },
+#define REGISTER_CODEPAGE(codepage, ...) \
+	{ codepage, CP##codepage##_names, NAME_COUNT(CP##codepage##_names) },
+#include "EncodingList.h"
 #undef REGISTER_CODEPAGE
+};
+
+#undef NAME_COUNT
+
+static UTF16LE_Encoding g_UTF16LEEncoding;
+static UTF8_Encoding g_UTF8Encoding;
+
+// The codepage encodings are created on first use and never deleted.
+static IEncoding* volatile g_CodepageEncodings[ENCODING_COUNT];
+static CCriticalSection g_CodepageEncodingsLock;
+
+const CEncodings CEncodings::g_Instance;
+
+int CEncodings::GetEncodingCount() const
+{
+	assert(sizeof(ENCODINGS)/sizeof(ENCODINGS[0]) == ENCODING_COUNT);
+	return ENCODING_COUNT;
 }
 
-static void LowerWstring(const wchar_t* s, wstring& result)
+IEncoding* CEncodings::GetEncoding(int index) const
 {
-	int len = wcslen(s);
-	result.resize(len);
-	for (int i=0; i<len; ++i)
+	assert(index>=0 && index<ENCODING_COUNT);
+	if (index == 0)
+		return &g_UTF16LEEncoding;
+	if (index == 1)
+		return &g_UTF8Encoding;
+
+	IEncoding* encoding = g_CodepageEncodings[index];
+	if (encoding)
+		return encoding;
+	SAutoLock lock(g_CodepageEncodingsLock);
+	encoding = g_CodepageEncodings[index];
+	if (!encoding)
 	{
-		if (s[i]>=L'A' && s[i]<='Z')
-			result[i] = s[i]-L'A'+L'a';
-		else
-			result[i] = s[i];
+		const SEncodingInfo& info = ENCODINGS[index];
+		encoding = new Codepage_Encoding(info.codepage, info.names, info.name_count);
+		// the object has to be complete before the other threads can see it
+		MemoryBarrier();
+		g_CodepageEncodings[index] = encoding;
 	}
+	return encoding;
 }
 
-void CEncodings::AddEncoding(IEncoding* encoding)
+// Compares the names like the lookup, only the ASCII letters are case insensitive.
+static bool EqualEncodingNames(const wchar_t* name, const wchar_t* lower_name)
 {
-	assert(encoding->GetNameCount() >= 1);
-	for (int i=0,e=encoding->GetNameCount(); i<e; ++i)
+	for (;; ++name, ++lower_name)
 	{
-		wstring name;
-		LowerWstring(encoding->GetName(i), name);
-		assert(m_NameToEncoding.count(name) == 0);
-		m_NameToEncoding[name] = encoding;
+		unsigned c1 = (unsigned)*name;
+		unsigned c2 = (unsigned)*lower_name;
+		if (c1>='A' && c1<='Z')
+			c1 += 'a' - 'A';
+		if (c2>='A' && c2<='Z')
+			c2 += 'a' - 'A';
+		if (c1 != c2)
+			return false;
+		if (!c1)
+			return true;
 	}
-	m_Encodings.push_back(encoding);
 }
 
+// The only slot that can hold the name.
+static const SEncodingNameSlot& GetEncodingNameSlot(const wchar_t* name)
+{
+	unsigned seed = ENCODING_NAME_SEEDS[HashEncodingName(0, name) % ENCODING_NAME_BUCKETS];
+	return ENCODING_NAME_SLOTS[HashEncodingName(seed, name) % ENCODING_NAME_COUNT];
+}
+
+#ifndef NDEBUG
+// Checks at startup that EncodingNameHash.cpp has been regenerated after editing EncodingList.h.
+static struct SEncodingNameHashCheck
+{
+	SEncodingNameHashCheck()
+	{
+		assert(sizeof(ENCODINGS)/sizeof(ENCODINGS[0]) == ENCODING_COUNT);
+		for (int i=0; i<ENCODING_COUNT; ++i)
+		{
+			for (int j=0; j<ENCODINGS[i].name_count; ++j)
+			{
+				const SEncodingNameSlot& slot = GetEncodingNameSlot(ENCODINGS[i].names[j]);
+				assert(slot.encoding==i && slot.name==j);
+			}
+		}
+	}
+} g_EncodingNameHashCheck;
+#endif
+
 IEncoding* CEncodings::FindEncoding(const wchar_t* name) const
 {
-	wstring lower_name;
-	LowerWstring(name, lower_name);
-	std::map<wstring,IEncoding*>::const_iterator it = m_NameToEncoding.find(lower_name);
-	if (it == m_NameToEncoding.end())
+	const SEncodingNameSlot& slot = GetEncodingNameSlot(name);
+	if (!EqualEncodingNames(name, ENCODINGS[slot.encoding].names[slot.name]))
 		return NULL;
-	return it->second;
+	return GetEncoding(slot.encoding);
+}
+
+bool DecodeToUTF16(const IEncoding* encoding, const char* bytes, size_t byte_count, wstring& utf16_str, wstring* error_message, size_t* invalid_offset)
+{
+	if (ParallelDecodeToUTF16(encoding, bytes, byte_count, utf16_str))
+		return true;
+	utf16_str.resize(encoding->GetMaxUTF16Chars(byte_count));
+	if (utf16_str.empty())
+		return true;
+	LONGLONG res = encoding->BytesToUTF16(bytes, byte_count, &utf16_str[0], utf16_str.size(), error_message, invalid_offset);
+	if (res < 0)
+	{
+		utf16_str.clear();
+		return false;
+	}
+	utf16_str.resize((size_t)res);
+	return true;
+}
+
+bool EncodeFromUTF16(const IEncoding* encoding, const wchar_t* utf16le_str, size_t utf16_chars, std::vector<char>& bytes, wstring* error_message)
+{
+	if (ParallelEncodeFromUTF16(encoding, utf16le_str, utf16_chars, bytes))
+		return true;
+	bytes.resize(encoding->GetMaxByteCount(utf16_chars));
+	if (bytes.empty())
+		return true;
+	LONGLONG res = encoding->UTF16ToBytes(utf16le_str, utf16_chars, &bytes[0], bytes.size(), error_message);
+	if (res < 0)
+	{
+		bytes.clear();
+		return false;
+	}
+	bytes.resize((size_t)res);
+	return true;
 }
 
 
@@ -614,7 +703,7 @@ enum ETextFileEncoding
 	eTFE_Unspecified,	// no BOM specified, will search for the xml declaration and its encoding attribute as if the file had single byte character set
 };
 
-ETextFileEncoding DetectFileEncoding(const void* data, int data_size, const void*& first_text_byte)
+ETextFileEncoding DetectFileEncoding(const void* data, size_t data_size, const void*& first_text_byte)
 {
 	const unsigned char* p = (const unsigned char*)data;
 	if (data_size >= 4)
@@ -676,7 +765,7 @@ const CharType* SkipSpaces(const CharType* p, const CharType* p_end)
 	return p;
 }
 template <typename CharType>
-bool ParseXmlDeclaration(const CharType* text, int num_chars, SXmlDeclarationAttribs& attributes, const CharType*& xml_data)
+bool ParseXmlDeclaration(const CharType* text, size_t num_chars, SXmlDeclarationAttribs& attributes, const CharType*& xml_data)
 {
 	const CharType* text_end = text + num_chars;
 	text = SkipSpaces(text, text_end);
@@ -782,21 +871,43 @@ wstring SXmlDeclarationAttribs::GetAsXmlDeclaration() const
 
 
 CXmlTextCodec::CXmlTextCodec()
-: m_Encoding(NULL)
+: m_XmlBodyBegin(NULL)
+, m_XmlBodyEnd(NULL)
+, m_UTF8BodyBegin(NULL)
+, m_UTF8BodyEnd(NULL)
+, m_EncodedBodyBegin(NULL)
+, m_EncodedBodyEnd(NULL)
+, m_Encoding(NULL)
+{
+}
+
+void CXmlTextCodec::SetXmlBody(const wstring& s)
 {
+	m_XmlBody = s;
+	m_XmlBodyBegin = m_XmlBody.data();
+	m_XmlBodyEnd = m_XmlBodyBegin + m_XmlBody.size();
 }
 
 
-static IEncoding* const UTF8_ENCODING = CEncodings::GetInstance().FindEncoding(L"UTF-8");
-static IEncoding* const UTF16_ENCODING = CEncodings::GetInstance().FindEncoding(L"UTF-16");
+static IEncoding* const UTF8_ENCODING = &g_UTF8Encoding;
+static IEncoding* const UTF16_ENCODING = &g_UTF16LEEncoding;
 
-bool CXmlTextCodec::DecodeXmlFileData(const void* data, int data_size)
+// The message of an invalid sequence at an offset in the file.
+static wstring InvalidSequenceMessage(const IEncoding* encoding, ULONGLONG byte_offset)
 {
-	assert(UTF8_ENCODING);
-	assert(UTF16_ENCODING);
+	if (encoding == UTF8_ENCODING)
+		return InvalidUTF8Message(byte_offset);
+	return InvalidCodepageMessage(byte_offset);
+}
 
+bool CXmlTextCodec::DecodeXmlFileData(const void* data, size_t data_size, bool keep_utf8_body, bool defer_decoding)
+{
 	m_ErrorMessage.clear();
 	m_XmlDeclarationAttributes.clear();
+	m_XmlBody.clear();
+	m_XmlBodyBegin = m_XmlBodyEnd = NULL;
+	m_UTF8BodyBegin = m_UTF8BodyEnd = NULL;
+	m_EncodedBodyBegin = m_EncodedBodyEnd = NULL;
 
 	const void* first_text_byte;
 	ETextFileEncoding text_file_encoding = DetectFileEncoding(data, data_size, first_text_byte);
@@ -806,7 +917,7 @@ bool CXmlTextCodec::DecodeXmlFileData(const void* data, int data_size)
 	case eTFE_Unspecified: // Encoding is specified by the encoding attribute of the xml declaration. We assume single byte character set or utf8.
 		{
 			const char* xml_decl_and_data = (const char*)first_text_byte;
-			int num_chars = data_size - (xml_decl_and_data - (const char*)data);
+			size_t num_chars = data_size - (xml_decl_and_data - (const char*)data);
 			const char* xml_body;
 			if (!ParseXmlDeclaration(xml_decl_and_data, num_chars, m_XmlDeclarationAttributes, xml_body))
 				return Error(L"Error parsing xml declaration!");
@@ -843,23 +954,63 @@ bool CXmlTextCodec::DecodeXmlFileData(const void* data, int data_size)
 				}
 			}
 
-			int byte_count = (int)(data_size - (xml_body - (const char*)data));
-			int res = m_Encoding->BytesToUTF16(xml_body, byte_count, NULL, 0, &m_ErrorMessage);
-			if (res < 0)
-				return false;
-			m_XmlBody.resize(res);
-			if (res)
+			size_t byte_count = data_size - (xml_body - (const char*)data);
+			if (m_Encoding == UTF8_ENCODING)
 			{
-				if (res != m_Encoding->BytesToUTF16(xml_body, byte_count, &m_XmlBody[0], res, &m_ErrorMessage))
+				// validated here to report the offset of an invalid sequence within the file
+				size_t utf16_length;
+				const char* invalid = ValidateUTF8(xml_body, xml_body+byte_count, &utf16_length);
+				if (invalid != xml_body+byte_count)
+				{
+					m_ErrorMessage = InvalidUTF8Message(invalid - (const char*)data);
 					return false;
+				}
+				if (keep_utf8_body)
+				{
+					// the parser reads the UTF-8 bytes directly
+					m_UTF8BodyBegin = xml_body;
+					m_UTF8BodyEnd = xml_body + byte_count;
+					return true;
+				}
+				m_XmlBody.resize(utf16_length);
+				if (utf16_length)
+				{
+					wchar_t* dst = &m_XmlBody[0];
+					UTF8ToUTF16(xml_body, xml_body+byte_count, dst);
+				}
 			}
+			else if (defer_decoding)
+			{
+				m_EncodedBodyBegin = xml_body;
+				m_EncodedBodyEnd = xml_body + byte_count;
+				return true;
+			}
+			else
+			{
+				size_t invalid_offset = (size_t)-1;
+				if (!DecodeToUTF16(m_Encoding, xml_body, byte_count, m_XmlBody, &m_ErrorMessage, &invalid_offset))
+				{
+					if (invalid_offset != (size_t)-1)
+						m_ErrorMessage = InvalidSequenceMessage(m_Encoding, (ULONGLONG)(xml_body - (const char*)data) + invalid_offset);
+					return false;
+				}
+			}
+			m_XmlBodyBegin = m_XmlBody.data();
+			m_XmlBodyEnd = m_XmlBodyBegin + m_XmlBody.size();
 		}
 		return true;
 	case eTFE_UTF16_LE: // the encoding attribute of the xml declaration must be "UTF-16"
 		{
 			const wchar_t* xml_decl_and_data = (const wchar_t*)first_text_byte;
-			int size_bytes = data_size - ((char*)first_text_byte - (char*)data);
-			int num_chars = size_bytes / 2;
+			size_t size_bytes = data_size - ((char*)first_text_byte - (char*)data);
+			size_t num_chars = size_bytes / 2;
+#if WCHAR_MAX > 0xFFFF
+			// the UTF-16 units are widened to the 4 byte wchar_t of the platform before parsing
+			m_XmlBody.resize(num_chars);
+			if (num_chars)
+				UTF16_ENCODING->BytesToUTF16((const char*)first_text_byte, num_chars*2, &m_XmlBody[0], num_chars);
+			xml_decl_and_data = m_XmlBody.data();
+#endif
 			const wchar_t* xml_body;
 			if (!ParseXmlDeclaration(xml_decl_and_data, num_chars, m_XmlDeclarationAttributes, xml_body))
 				return Error(L"Error parsing xml declaration!");
@@ -885,7 +1036,21 @@ bool CXmlTextCodec::DecodeXmlFileData(const void* data, int data_size)
 				m_Encoding = UTF16_ENCODING;
 			}
 
-			m_XmlBody.assign(xml_body, xml_decl_and_data + num_chars);
+			// The body is parsed in place unless it is misaligned in a buffer that doesn't come
+			// from the allocator or from a file mapping.
+			if ((size_t)xml_body & (sizeof(wchar_t)-1))
+			{
+				m_XmlBody.resize(xml_decl_and_data + num_chars - xml_body);
+				if (!m_XmlBody.empty())
+					memcpy(&m_XmlBody[0], xml_body, m_XmlBody.size()*sizeof(wchar_t));
+				m_XmlBodyBegin = m_XmlBody.data();
+				m_XmlBodyEnd = m_XmlBodyBegin + m_XmlBody.size();
+			}
+			else
+			{
+				m_XmlBodyBegin = xml_body;
+				m_XmlBodyEnd = xml_decl_and_data + num_chars;
+			}
 		}
 		return true;
 	case eTFE_UTF16_BE: return Error(L"UTF16_BE is unsupported!!!");
@@ -895,34 +1060,119 @@ bool CXmlTextCodec::DecodeXmlFileData(const void* data, int data_size)
 	}
 }
 
-bool CXmlTextCodec::EncodeXmlFileData(const SXmlDeclarationAttribs& _attribs, const wstring& xml_body,
-				IEncoding* encoding, ENewLineMode newline_mode, std::vector<char>& data, wstring* error_message)
+bool CXmlTextCodec::Error(const wchar_t* error_mesasge)
 {
-	SXmlDeclarationAttribs attribs = _attribs;
-	attribs.SetAttrib(L"encoding", encoding->GetName(0));
-	wstring xml_data = attribs.GetAsXmlDeclaration();
-	xml_data.append(ToString(newline_mode));
-	xml_data.append(xml_body);
+	m_ErrorMessage = error_mesasge;
+	return false;
+}
 
-	if (int bom_size = encoding->GetBOMSizeBytes())
+
+CXmlBodyDecoder::CXmlBodyDecoder(const IEncoding* encoding, const char* body, const char* body_end, ULONGLONG body_offset, size_t chunk_bytes)
+: m_Encoding(encoding)
+, m_Body(body)
+, m_BodyOffset(body_offset)
+, m_Pos(body)
+, m_End(body_end)
+, m_ChunkBytes(chunk_bytes)
+, m_Failed(false)
+, m_NewLineMode(eNLM_Auto)
+, m_PendingNewLine(0)
+{
+}
+
+// A line that is longer than the chunk size gets a bigger chunk.
+size_t CXmlBodyDecoder::GetChunkSize() const
+{
+	size_t byte_count = m_End - m_Pos;
+	for (size_t max_bytes=m_ChunkBytes; ; max_bytes*=2)
 	{
-		const char* bom = encoding->GetBOM();
-		data.insert(data.end(), bom, bom+bom_size);
+		size_t size = m_Encoding->GetDecodeChunkSize(m_Pos, byte_count, max_bytes);
+		if (size)
+			return size;
 	}
+}
 
-	int encoded_size = encoding->UTF16ToBytes(xml_data.data(), xml_data.size(), NULL, 0, error_message);
-	if (encoded_size < 0)
-		return false;
+// The failing chunk at m_Pos is decoded again to get the position of the invalid sequence.
+void CXmlBodyDecoder::Fail(size_t chunk_bytes)
+{
+	m_Failed = true;
+	m_ErrorMessage.clear();
+	size_t invalid_offset = (size_t)-1;
+	if (m_Encoding->BytesToUTF16(m_Pos, chunk_bytes, NULL, 0, &m_ErrorMessage, &invalid_offset) >= 0 || m_ErrorMessage.empty())
+		m_ErrorMessage = L"Error decoding to UTF-16 with the specified encoding!";
+	else if (invalid_offset != (size_t)-1)
+		m_ErrorMessage = InvalidSequenceMessage(m_Encoding, m_BodyOffset + (m_Pos - m_Body) + invalid_offset);
+}
 
-	size_t offs = data.size();
-	data.resize(offs + (size_t)encoded_size);
-	return encoded_size == encoding->UTF16ToBytes(xml_data.data(), xml_data.size(), &data[offs], encoded_size, error_message);
+void CXmlBodyDecoder::DetectNewLine(const wchar_t* s, const wchar_t* s_end)
+{
+	if (m_NewLineMode!=eNLM_Auto || s==s_end)
+		return;
+	if (m_PendingNewLine)
+	{
+		if (m_PendingNewLine == 10)
+			m_NewLineMode = s[0]==13 ? eNLM_LFCR : eNLM_LF;
+		else
+			m_NewLineMode = s[0]==10 ? eNLM_CRLF : eNLM_CR;
+		return;
+	}
+	for (; s<s_end; ++s)
+	{
+		if (s[0]==10 || s[0]==13)
+		{
+			if (s+1 == s_end)
+				m_PendingNewLine = s[0];
+			else
+				m_NewLineMode = DetectNewLineMode(s, s_end);
+			return;
+		}
+	}
 }
 
-bool CXmlTextCodec::Error(const wchar_t* error_mesasge)
+bool CXmlBodyDecoder::ReadChunk(wstring& text)
 {
-	m_ErrorMessage = error_mesasge;
-	return false;
+	if (m_Failed || m_Pos==m_End)
+		return false;
+	size_t chunk_bytes = GetChunkSize();
+	size_t size = text.size();
+	size_t max_chars = m_Encoding->GetMaxUTF16Chars(chunk_bytes);
+	if (max_chars)
+	{
+		text.resize(size + max_chars);
+		LONGLONG res = m_Encoding->BytesToUTF16(m_Pos, chunk_bytes, &text[size], max_chars);
+		if (res < 0)
+		{
+			text.resize(size);
+			Fail(chunk_bytes);
+			return false;
+		}
+		text.resize(size + (size_t)res);
+	}
+	m_Pos += chunk_bytes;
+	DetectNewLine(text.data()+size, text.data()+text.size());
+	return true;
+}
+
+bool CXmlBodyDecoder::Finish()
+{
+	wstring chunk;
+	while (!m_Failed && m_Pos!=m_End)
+	{
+		if (m_NewLineMode == eNLM_Auto)
+		{
+			// the newline mode still needs the decoded text
+			chunk.clear();
+			ReadChunk(chunk);
+			continue;
+		}
+		size_t chunk_bytes = GetChunkSize();
+		if (m_Encoding->BytesToUTF16(m_Pos, chunk_bytes, NULL, 0) < 0)
+			Fail(chunk_bytes);
+		m_Pos += chunk_bytes;
+	}
+	if (m_NewLineMode==eNLM_Auto && m_PendingNewLine)
+		m_NewLineMode = m_PendingNewLine==10 ? eNLM_LF : eNLM_CR;
+	return !m_Failed;
 }
 
 
@@ -930,55 +1180,209 @@ bool CXmlTextCodec::Error(const wchar_t* error_mesasge)
 //-------------------------------------------------------------------------------------------------
 
 
-static IEncoding* const ASCII_ENCODING = CEncodings::GetInstance().FindEncoding(L"ASCII");
-CXmlCharacterReferenceMap::CXmlCharacterReferenceMap()
+// 64K of utf16 text is encoded at once, the buffer grows up to 8M for the parallel encoding.
+static const size_t WRITER_BUFFER_CHARS = 0x8000;
+static const size_t MAX_WRITER_BUFFER_CHARS = 0x400000;
+
+CXmlTextWriter::CXmlTextWriter(IEncoding* encoding, IXmlByteSink* sink)
+: m_Encoding(encoding)
+, m_Sink(sink)
+, m_Buffer(WRITER_BUFFER_CHARS)
+, m_MaxBufferSize(GetTranscodeThreadCount()>1 ? MAX_WRITER_BUFFER_CHARS : WRITER_BUFFER_CHARS)
+, m_Used(0)
+, m_Encoded(encoding->GetMaxByteCount(WRITER_BUFFER_CHARS))
+, m_Failed(false)
 {
-	SetEncoding(ASCII_ENCODING, true);
 }
 
-void CXmlCharacterReferenceMap::SetupStaticRefTypes(bool can_represent_all_unichars)
+void CXmlTextWriter::WriteXmlDeclaration(const SXmlDeclarationAttribs& _attribs, ENewLineMode newline_mode)
 {
-	for (int i=0; i<0x20; ++i)
-		m_Map[i] = eCRM_RefDecimal;
+	assert(!m_Used);
+	if (int bom_size = m_Encoding->GetBOMSizeBytes())
+		WriteBytes(m_Encoding->GetBOM(), bom_size);
 
-	ECharRefMode non_char = can_represent_all_unichars ? eCRM_NoRefNonCharacter : eCRM_RefHexNonCharacter;
-	for (int i=0xFDD0; i<=0xFDEF; ++i)
-		m_Map[i] = non_char;
-	m_Map[0xFFFE] = non_char;
-	m_Map[0xFFFF] = non_char;
-	for (int i=0xDC00; i<0xE000; ++i)
-		m_Map[i] = non_char;
-	ECharRefMode surrogate = can_represent_all_unichars ? eCRM_NoRefSurrogate : eCRM_RefSurrogate;
-	for (int i=0xD800; i<0xDC00; ++i)
-		m_Map[i] = surrogate;
+	SXmlDeclarationAttribs attribs = _attribs;
+	attribs.SetAttrib(L"encoding", m_Encoding->GetName(0));
+	append(attribs.GetAsXmlDeclaration());
+	append(ToString(newline_mode));
 }
 
-void CXmlCharacterReferenceMap::SetEncoding(IEncoding* encoding, bool safe_encoding)
+void CXmlTextWriter::append(const wchar_t* s, size_t len)
 {
-	assert(ASCII_ENCODING && UTF8_ENCODING && UTF16_ENCODING);
-	if (encoding->GetFlags() & IEncoding::eF_CanRepresentAllUniChars)
+	while (len)
 	{
-		// UTF encodings
-		memset(&m_Map, eCRM_NoRef, sizeof(m_Map));
-		SetupStaticRefTypes(true);
-		return;
+		if (m_Used == m_Buffer.size())
+			Flush(false);
+		size_t count = min(len, m_Buffer.size()-m_Used);
+		memcpy(&m_Buffer[m_Used], s, count*sizeof(wchar_t));
+		m_Used += count;
+		s += count;
+		len -= count;
 	}
+}
 
-	memset(&m_Map[0x20], eCRM_NoRef, 0x80-0x20);
-	memset(&m_Map[0x80], eCRM_RefHex, sizeof(m_Map)-0x80);
-	if (safe_encoding)
+bool CXmlTextWriter::Finish()
+{
+	Flush(true);
+	return !m_Failed;
+}
+
+void CXmlTextWriter::Flush(bool final)
+{
+	size_t count = m_Used;
+	// the two halves of a surrogate pair are encoded together
+	if (!final && count>1 && m_Buffer[count-1]>=0xD800 && m_Buffer[count-1]<0xDC00)
+		--count;
+
+	if (count && !m_Failed)
 	{
-		SetupStaticRefTypes(false);
+		LONGLONG size;
+		if (ParallelEncodeFromUTF16(m_Encoding, &m_Buffer[0], count, m_Encoded))
+		{
+			size = (LONGLONG)m_Encoded.size();
+		}
+		else
+		{
+			// m_Encoded has the worst case size of the whole buffer so it is encoded in one pass
+			size_t max_size = m_Encoding->GetMaxByteCount(count);
+			if (m_Encoded.size() < max_size)
+				m_Encoded.resize(max_size);
+			size = m_Encoding->UTF16ToBytes(&m_Buffer[0], count, &m_Encoded[0], m_Encoded.size(), &m_ErrorMessage);
+		}
+		if (size < 0)
+			m_Failed = true;
+		else if (size)
+			WriteBytes(&m_Encoded[0], (size_t)size);
+	}
+
+	m_Used -= count;
+	if (m_Used)
+		m_Buffer[0] = m_Buffer[count];
+	if (!final && m_Buffer.size()<m_MaxBufferSize)
+		m_Buffer.resize(m_Buffer.size()*2);
+}
+
+void CXmlTextWriter::WriteBytes(const char* data, size_t size)
+{
+	if (m_Failed || !size)
 		return;
+	if (!m_Sink->WriteBytes(data, size, m_ErrorMessage))
+		m_Failed = true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+
+#define REPEAT_2(x)		x, x
+#define REPEAT_4(x)		REPEAT_2(x), REPEAT_2(x)
+#define REPEAT_8(x)		REPEAT_4(x), REPEAT_4(x)
+#define REPEAT_16(x)	REPEAT_8(x), REPEAT_8(x)
+#define REPEAT_32(x)	REPEAT_16(x), REPEAT_16(x)
+#define REPEAT_64(x)	REPEAT_32(x), REPEAT_32(x)
+#define REPEAT_128(x)	REPEAT_64(x), REPEAT_64(x)
+#define REPEAT_256(x)	REPEAT_128(x), REPEAT_128(x)
+
+typedef CXmlCharacterReferenceMap CRM;
+
+// The pages of the UTF encodings that can represent every character.
+static const unsigned char UTF_CONTROL_PAGE[0x100] = { REPEAT_32(CRM::eCRM_RefDecimal) };
+static const unsigned char UTF_NOREF_PAGE[0x100] = { CRM::eCRM_NoRef };
+static const unsigned char UTF_SURROGATE_PAGE[0x100] = { REPEAT_256(CRM::eCRM_NoRefSurrogate) };
+static const unsigned char UTF_NON_CHARACTER_PAGE[0x100] = { REPEAT_256(CRM::eCRM_NoRefNonCharacter) };
+// U+FDD0-U+FDEF are non-characters
+static const unsigned char UTF_PAGE_FD[0x100] = { REPEAT_128(CRM::eCRM_NoRef), REPEAT_64(CRM::eCRM_NoRef), REPEAT_16(CRM::eCRM_NoRef), REPEAT_32(CRM::eCRM_NoRefNonCharacter) };
+// U+FFFE and U+FFFF are non-characters
+static const unsigned char UTF_PAGE_FF[0x100] = { REPEAT_128(CRM::eCRM_NoRef), REPEAT_64(CRM::eCRM_NoRef), REPEAT_32(CRM::eCRM_NoRef), REPEAT_16(CRM::eCRM_NoRef),
+	REPEAT_8(CRM::eCRM_NoRef), REPEAT_4(CRM::eCRM_NoRef), REPEAT_2(CRM::eCRM_NoRef), REPEAT_2(CRM::eCRM_NoRefNonCharacter) };
+
+// The pages of the safe map that references every character above 0x7F. It is the base of
+// the codepage maps too.
+static const unsigned char SAFE_ASCII_PAGE[0x100] = { REPEAT_32(CRM::eCRM_RefDecimal), REPEAT_64(CRM::eCRM_NoRef), REPEAT_32(CRM::eCRM_NoRef), REPEAT_128(CRM::eCRM_RefHex) };
+static const unsigned char SAFE_REF_PAGE[0x100] = { REPEAT_256(CRM::eCRM_RefHex) };
+static const unsigned char SAFE_SURROGATE_PAGE[0x100] = { REPEAT_256(CRM::eCRM_RefSurrogate) };
+static const unsigned char SAFE_NON_CHARACTER_PAGE[0x100] = { REPEAT_256(CRM::eCRM_RefHexNonCharacter) };
+static const unsigned char SAFE_PAGE_FD[0x100] = { REPEAT_128(CRM::eCRM_RefHex), REPEAT_64(CRM::eCRM_RefHex), REPEAT_16(CRM::eCRM_RefHex), REPEAT_32(CRM::eCRM_RefHexNonCharacter), REPEAT_16(CRM::eCRM_RefHex) };
+static const unsigned char SAFE_PAGE_FF[0x100] = { REPEAT_128(CRM::eCRM_RefHex), REPEAT_64(CRM::eCRM_RefHex), REPEAT_32(CRM::eCRM_RefHex), REPEAT_16(CRM::eCRM_RefHex),
+	REPEAT_8(CRM::eCRM_RefHex), REPEAT_4(CRM::eCRM_RefHex), REPEAT_2(CRM::eCRM_RefHex), REPEAT_2(CRM::eCRM_RefHexNonCharacter) };
+
+// Page 0x00, pages 0x01-0xD7, the high surrogate pages 0xD8-0xDB, the low surrogate pages
+// 0xDC-0xDF, pages 0xE0-0xFC, page 0xFD, page 0xFE and page 0xFF.
+#define PAGE_TABLE(page_00, page, high_surrogate_page, low_surrogate_page, page_fd, page_ff) \
+	{ \
+		page_00, REPEAT_128(page), REPEAT_64(page), REPEAT_16(page), REPEAT_4(page), REPEAT_2(page), page, \
+		REPEAT_4(high_surrogate_page), REPEAT_4(low_surrogate_page), \
+		REPEAT_16(page), REPEAT_8(page), REPEAT_4(page), page, \
+		page_fd, page, page_ff, \
 	}
 
+static const unsigned char* const UTF_PAGES[0x100] =
+	PAGE_TABLE(UTF_CONTROL_PAGE, UTF_NOREF_PAGE, UTF_SURROGATE_PAGE, UTF_NON_CHARACTER_PAGE, UTF_PAGE_FD, UTF_PAGE_FF);
+static const unsigned char* const SAFE_PAGES[0x100] =
+	PAGE_TABLE(SAFE_ASCII_PAGE, SAFE_REF_PAGE, SAFE_SURROGATE_PAGE, SAFE_NON_CHARACTER_PAGE, SAFE_PAGE_FD, SAFE_PAGE_FF);
+
+#undef PAGE_TABLE
+
+const CXmlCharacterReferenceMap CXmlCharacterReferenceMap::UTF_MAP(UTF_PAGES);
+const CXmlCharacterReferenceMap CXmlCharacterReferenceMap::SAFE_MAP(SAFE_PAGES);
+
+// The control characters, the surrogates and the non-characters are referenced the same way
+// in every codepage map.
+static bool HasStaticRefType(unsigned c)
+{
+	return c<0x20 || (c>=0xD800 && c<0xE000) || (c>=0xFDD0 && c<=0xFDEF) || c>=0xFFFE;
+}
+
+const CXmlCharacterReferenceMap* CXmlCharacterReferenceMap::CreateCodepageMap(IEncoding* encoding)
+{
+	const unsigned char** pages = new const unsigned char*[0x100];
+	memcpy(pages, SAFE_PAGES, sizeof(SAFE_PAGES));
+
+	const unsigned short* table = encoding->GetSingleByteTable();
 	for (int i=0x80; i<0x100; ++i)
 	{
-		char b = (char)i;
-		wchar_t w;
-		int res = encoding->BytesToUTF16(&b, 1, &w, 1, NULL);
-		if (res > 0)
-			m_Map[w] = eCRM_NoRef;
+		unsigned c;
+		if (table)
+		{
+			c = table[i];
+		}
+		else
+		{
+			char b = (char)i;
+			wchar_t w;
+			if (encoding->BytesToUTF16(&b, 1, &w, 1, NULL) <= 0)
+				continue;
+			c = (unsigned)w;
+		}
+		if (c>0xFFFF || HasStaticRefType(c))
+			continue;
+
+		const unsigned char*& page = pages[c >> 8];
+		if (page == SAFE_PAGES[c >> 8])
+		{
+			unsigned char* copy = new unsigned char[0x100];
+			memcpy(copy, page, 0x100);
+			page = copy;
+		}
+		const_cast<unsigned char*>(page)[c & 0xFF] = eCRM_NoRef;
 	}
-	SetupStaticRefTypes(false);
+	return new CXmlCharacterReferenceMap(pages);
+}
+
+static CCriticalSection g_CodepageMapsLock;
+static std::map<IEncoding*,const CXmlCharacterReferenceMap*> g_CodepageMaps;
+
+const CXmlCharacterReferenceMap& CXmlCharacterReferenceMap::Get(IEncoding* encoding, bool safe_encoding)
+{
+	if (encoding->GetFlags() & IEncoding::eF_CanRepresentAllUniChars)
+		return UTF_MAP;
+	if (safe_encoding)
+		return SAFE_MAP;
+
+	SAutoLock lock(g_CodepageMapsLock);
+	const CXmlCharacterReferenceMap*& map = g_CodepageMaps[encoding];
+	if (!map)
+		map = CreateCodepageMap(encoding);
+	return *map;
 }
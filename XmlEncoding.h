@@ -18,6 +18,7 @@ ENewLineMode NewLineModeFromName(const wchar_t* new_line_mode_name);
 const wchar_t* ToString(ENewLineMode);
 // Returns  eNLM_Auto if the specified text does not contain any newline characters.
 ENewLineMode DetectNewLineMode(const wchar_t* s_begin, const wchar_t* s_end);
+ENewLineMode DetectNewLineMode(const char* s_begin, const char* s_end);
 
 
 //-------------------------------------------------------------------------------------------------
@@ -37,10 +38,28 @@ struct IEncoding
 
 	// Returns -1 on error, the number of converted bytes otherwise. If byte_count is zero, then returns
 	// the number of bytes required for the conversion.
-	virtual int UTF16ToBytes(const wchar_t* utf16le_str, int utf16_chars, char* bytes, int byte_count, wstring* error_message=NULL) const = 0;
+	virtual LONGLONG UTF16ToBytes(const wchar_t* utf16le_str, size_t utf16_chars, char* bytes, size_t byte_count, wstring* error_message=NULL) const = 0;
 	// Returns -1 on error, the number of converted utf16_chars otherwise. If utf16_chars is zero, then
-	// returns the number of utf16_chars required for the conversion.
-	virtual int BytesToUTF16(const char* bytes, int byte_count, wchar_t* utf16le_str, int utf16_chars, wstring* error_message=NULL) const = 0;
+	// returns the number of utf16_chars required for the conversion. If the bytes contain an invalid
+	// or undefined sequence then its offset is returned in invalid_offset, it is left unchanged
+	// if the position isn't known.
+	virtual LONGLONG BytesToUTF16(const char* bytes, size_t byte_count, wchar_t* utf16le_str, size_t utf16_chars, wstring* error_message=NULL, size_t* invalid_offset=NULL) const = 0;
+
+	// Upper bounds of the conversion results. With a destination buffer of this size the text is
+	// converted in a single pass without querying the required size first.
+	virtual size_t GetMaxByteCount(size_t utf16_chars) const = 0;
+	virtual size_t GetMaxUTF16Chars(size_t byte_count) const = 0;
+
+	// Returns the size of the longest prefix of the first max_bytes bytes that can be decoded
+	// on its own and doesn't change the decoding of the rest, zero if there is no such prefix.
+	// The default implementation splits after the last '\n'.
+	virtual size_t GetDecodeChunkSize(const char* bytes, size_t byte_count, size_t max_bytes) const;
+	// The same for the encoding of UTF-16 text, splits after the last '\n' by default.
+	virtual size_t GetEncodeChunkSize(const wchar_t* utf16le_str, size_t utf16_chars, size_t max_chars) const;
+
+	// The 256 entry decode table of the single byte codepages that have a built-in table,
+	// NULL for the other encodings. The undefined bytes are decoded to 0xFFFF.
+	virtual const unsigned short* GetSingleByteTable() const	{ return NULL; }
 
 	virtual int GetBOMSizeBytes() const				{ return 0; }
 	virtual const char* GetBOM() const				{ return NULL; }
@@ -52,27 +71,28 @@ struct IEncoding
 	virtual int GetFlags() const					{ return 0; }
 };
 
+// The name lookup uses only static tables so it works during static initialization too.
+// The encodings can be used by the worker threads.
 class CEncodings
 {
 public:
-	static const CEncodings& GetInstance()
-	{
-		static const CEncodings g_Instance;
-		return g_Instance;
-	}
+	static const CEncodings& GetInstance() { return g_Instance; }
+	// Looks up the name in a generated perfect hash table, the ASCII letters of the name are
+	// case insensitive. Returns NULL if the name is unknown.
 	IEncoding* FindEncoding(const wchar_t* name) const;
-	const std::vector<IEncoding*>& GetAllEncodings() const { return m_Encodings; }
-
-private:
-	CEncodings();
-	void AddEncoding(IEncoding* encoding);
+	int GetEncodingCount() const;
+	// The codepage encodings are created on first use.
+	IEncoding* GetEncoding(int index) const;
 
 private:
-	// encoding names are stored in lowercase to this map
-	std::map<wstring,IEncoding*> m_NameToEncoding;
-	std::vector<IEncoding*> m_Encodings;
+	static const CEncodings g_Instance;
 };
 
+// Single pass conversions to a buffer of the worst case size that is shrunk to the result.
+// Big texts are converted on several threads with the functions of ParallelTranscoder.h.
+bool DecodeToUTF16(const IEncoding* encoding, const char* bytes, size_t byte_count, wstring& utf16_str, wstring* error_message=NULL, size_t* invalid_offset=NULL);
+bool EncodeFromUTF16(const IEncoding* encoding, const wchar_t* utf16le_str, size_t utf16_chars, std::vector<char>& bytes, wstring* error_message=NULL);
+
 
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
@@ -97,8 +117,15 @@ class CXmlTextCodec
 public:
 	CXmlTextCodec();
 
-	const wstring& GetXmlBody() const								{ return m_XmlBody; }
-	void SetXmlBody(const wstring& s)								{ m_XmlBody = s; }
+	// The decoded body. A UTF-16LE body isn't copied, it points into the data passed to
+	// DecodeXmlFileData() so that data must be kept alive while the body is used.
+	const wchar_t* GetXmlBodyBegin() const							{ return m_XmlBodyBegin; }
+	const wchar_t* GetXmlBodyEnd() const							{ return m_XmlBodyEnd; }
+	void SetXmlBody(const wstring& s);
+	// The validated UTF-8 body if keep_utf8_body was set and the file is UTF-8, otherwise NULL
+	// and the body is decoded to utf16. Points into the data passed to DecodeXmlFileData().
+	const char* GetUTF8BodyBegin() const							{ return m_UTF8BodyBegin; }
+	const char* GetUTF8BodyEnd() const								{ return m_UTF8BodyEnd; }
 
 	IEncoding* GetEncoding() const									{ return m_Encoding; }
 	void SetEncoding(IEncoding* encoding)							{ m_Encoding = encoding; }
@@ -106,12 +133,15 @@ public:
 	SXmlDeclarationAttribs& GetXmlDeclarationAttributes()			{ return m_XmlDeclarationAttributes; }
 	const SXmlDeclarationAttribs& GetXmlDeclarationAttributes() const	{ return m_XmlDeclarationAttributes; }
 
-	// Fills this object with the xml file data. Decodes the xml data to utf16.
-	bool DecodeXmlFileData(const void* data, int data_size);
-	// Encodes the current utf16 xml data and settings of this object and returns the encoded
-	// xml file data. The data contains the BOM if required, the xml declaration, and the xml data.
-	static bool EncodeXmlFileData(const SXmlDeclarationAttribs& attribs, const wstring& xml_body,
-		IEncoding* encoding, ENewLineMode newline_mode, std::vector<char>& data, wstring* error_message);
+	// The bytes of a body that is left encoded because defer_decoding was set, otherwise NULL.
+	// Points into the data passed to DecodeXmlFileData().
+	const char* GetEncodedBodyBegin() const							{ return m_EncodedBodyBegin; }
+	const char* GetEncodedBodyEnd() const							{ return m_EncodedBodyEnd; }
+
+	// Fills this object with the xml file data. Decodes the xml data to utf16 unless
+	// keep_utf8_body is set and the data is UTF-8, or defer_decoding is set and the data
+	// has a codepage encoding. A deferred body can be decoded with CXmlBodyDecoder.
+	bool DecodeXmlFileData(const void* data, size_t data_size, bool keep_utf8_body=false, bool defer_decoding=false);
 
 	const wstring& GetErrorMessage() const							{ return m_ErrorMessage; }
 
@@ -119,35 +149,162 @@ private:
 	bool Error(const wchar_t* error_mesasge);
 
 private:
+	// holds the body only if it had to be converted
 	wstring m_XmlBody;
+	const wchar_t* m_XmlBodyBegin;
+	const wchar_t* m_XmlBodyEnd;
+	const char* m_UTF8BodyBegin;
+	const char* m_UTF8BodyEnd;
+	const char* m_EncodedBodyBegin;
+	const char* m_EncodedBodyEnd;
 	IEncoding* m_Encoding;
 	SXmlDeclarationAttribs m_XmlDeclarationAttributes;
 	wstring m_ErrorMessage;
 };
 
 
+// Supplies text in chunks to a parser, see CVcprojParser::Parse().
+template <typename CharType>
+struct IXmlTextSource
+{
+	// Appends the next chunk to text. Returns false at the end of the text or on error.
+	virtual bool ReadChunk(std::basic_string<CharType>& text) = 0;
+};
+
+// Decodes a body in chunks that end at the boundaries returned by IEncoding::GetDecodeChunkSize()
+// so the parser can work on the decoded text while the rest is still encoded.
+class CXmlBodyDecoder : public IXmlTextSource<wchar_t>
+{
+public:
+	enum { DEFAULT_CHUNK_BYTES = 0x10000 };
+	// body_offset is the offset of the body in the file, it is added to the offsets of the errors.
+	CXmlBodyDecoder(const IEncoding* encoding, const char* body, const char* body_end, ULONGLONG body_offset, size_t chunk_bytes=DEFAULT_CHUNK_BYTES);
+
+	virtual bool ReadChunk(wstring& text);
+	// Validates the rest of the body without keeping the decoded text. Returns false if the
+	// body can't be decoded, including the part that was read already.
+	bool Finish();
+
+	bool Failed() const												{ return m_Failed; }
+	// The error message with the byte offset of the invalid sequence counted from the file begin.
+	const wstring& GetErrorMessage() const							{ return m_ErrorMessage; }
+	// The newline mode of the decoded text like DetectNewLineMode() returns it for the whole
+	// body. Final only after Finish().
+	ENewLineMode GetNewLineMode() const								{ return m_NewLineMode; }
+
+private:
+	// Returns the size of the next chunk.
+	size_t GetChunkSize() const;
+	void Fail(size_t chunk_bytes);
+	void DetectNewLine(const wchar_t* s, const wchar_t* s_end);
+
+private:
+	const IEncoding* m_Encoding;
+	const char* m_Body;
+	ULONGLONG m_BodyOffset;
+	const char* m_Pos;
+	const char* m_End;
+	size_t m_ChunkBytes;
+	bool m_Failed;
+	wstring m_ErrorMessage;
+	ENewLineMode m_NewLineMode;
+	// the newline character at the end of the text decoded so far if it decides the mode
+	wchar_t m_PendingNewLine;
+};
+
+
+// Receives the encoded bytes from CXmlTextWriter.
+struct IXmlByteSink
+{
+	// Returns false with an error message on error.
+	virtual bool WriteBytes(const char* data, size_t size, wstring& error_message) = 0;
+};
+
+
+// Encodes the serialized utf16 xml through a buffer. The buffer is encoded and passed to the sink
+// whenever it fills, so the document never exists in memory as a whole. The buffer grows with
+// big documents on multicore machines so it is encoded on several threads. append() and
+// push_back() are named like the methods of wstring so the same serializer code can write both.
+class CXmlTextWriter
+{
+public:
+	CXmlTextWriter(IEncoding* encoding, IXmlByteSink* sink);
+
+	// Writes the BOM if required and the xml declaration followed by a newline.
+	void WriteXmlDeclaration(const SXmlDeclarationAttribs& attribs, ENewLineMode newline_mode);
+
+	void push_back(wchar_t c)
+	{
+		if (m_Used == m_Buffer.size())
+			Flush(false);
+		m_Buffer[m_Used++] = c;
+	}
+	void append(const wchar_t* s, size_t len);
+	void append(const wchar_t* s)						{ append(s, wcslen(s)); }
+	void append(const wstring& s)						{ append(s.data(), s.size()); }
+
+	// Encodes the rest of the buffer. Returns false if the encoding or a write has failed.
+	bool Finish();
+	const wstring& GetErrorMessage() const				{ return m_ErrorMessage; }
+
+private:
+	void Flush(bool final);
+	void WriteBytes(const char* data, size_t size);
+
+private:
+	IEncoding* m_Encoding;
+	IXmlByteSink* m_Sink;
+	std::vector<wchar_t> m_Buffer;
+	size_t m_MaxBufferSize;
+	size_t m_Used;
+	std::vector<char> m_Encoded;
+	// nothing is written after the first error
+	bool m_Failed;
+	wstring m_ErrorMessage;
+};
+
+
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 
 
 // This can tell you which utf16 codepoints need to be stored as xml character references
-// in the xml when a specific codepage is used for encoding.
+// in the xml when a specific codepage is used for encoding. The maps are immutable and shared
+// by the threads. They are two level tables of 256 byte pages, the pages that have the same
+// content are shared so the pages used by a typical text fit in the L1 cache.
 class CXmlCharacterReferenceMap
 {
 public:
-	CXmlCharacterReferenceMap();
+	// Returns the map of the encoding. The maps of the UTF encodings and the safe map are
+	// static tables, the maps of the codepages are built on first use and never deleted.
 	// safe_encoding==true is used only with windows codepages and it forces character
 	// codes above 0x7F in the codepage to be encoded as xml character references.
-	void SetEncoding(IEncoding* encoding, bool safe_encoding=false);
+	static const CXmlCharacterReferenceMap& Get(IEncoding* encoding, bool safe_encoding=false);
+
 	// Tells you which utf16 codepoints have to be represented as xml
 	// character references in the value of xml attributes.
-
 	enum ECharRefMode { eCRM_NoRef, eCRM_NoRefNonCharacter, eCRM_RefDecimal, eCRM_RefHex, eCRM_RefHexNonCharacter, eCRM_RefSurrogate, eCRM_NoRefSurrogate };
-	char CharacterRefType(wchar_t c) const { return m_Map[c]; }
+	char CharacterRefType(wchar_t c) const { return (char)m_Pages[(unsigned)c >> 8][c & 0xFF]; }
+	// True if the code unit is written to the value of an attribute as it is.
+	bool IsVerbatim(wchar_t c) const
+	{
+		const unsigned VERBATIM_TYPES = (1<<eCRM_NoRef) | (1<<eCRM_NoRefNonCharacter) | (1<<eCRM_NoRefSurrogate);
+		if (c<=L'>' && (c==L'&' || c==L'\'' || c==L'"' || c==L'<' || c==L'>'))
+			return false;
+		return (VERBATIM_TYPES >> CharacterRefType(c)) & 1;
+	}
 
 private:
-	void SetupStaticRefTypes(bool can_represent_all_unichars);
+	CXmlCharacterReferenceMap(const unsigned char* const* pages) : m_Pages(pages) {}
+	static const CXmlCharacterReferenceMap* CreateCodepageMap(IEncoding* encoding);
+
+	// non-copyable
+	CXmlCharacterReferenceMap(const CXmlCharacterReferenceMap&);
+	CXmlCharacterReferenceMap& operator=(const CXmlCharacterReferenceMap&);
 
 private:
-	char m_Map[0x10000];
+	static const CXmlCharacterReferenceMap UTF_MAP;
+	static const CXmlCharacterReferenceMap SAFE_MAP;
+	// 256 pages indexed by the high byte of the UTF-16 unit
+	const unsigned char* const* m_Pages;
 };
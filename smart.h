@@ -168,6 +168,7 @@ inline bool operator!=(int null, const smartptr<T> &p)
 }
 
 
+// The reference counter is interlocked so objects can be shared between worker threads.
 class refcounted
 {
 public:
@@ -175,23 +176,24 @@ public:
 	virtual ~refcounted() {}
 	void AddRef()
 	{
-		++m_RefCount;
+		InterlockedIncrement(&m_RefCount);
 	}
 	void Release()
 	{
-		if (!--m_RefCount)
+		LONG ref_count = InterlockedDecrement(&m_RefCount);
+		if (!ref_count)
 		{
 			delete this;
 		}
 #ifdef _DEBUG
 		else
 		{
-			assert(m_RefCount > 0);
+			assert(ref_count > 0);
 		}
 #endif
 	}
 private:
-	int m_RefCount;
+	volatile LONG m_RefCount;
 };
 
 
@@ -306,3 +308,105 @@ struct SFindHandle
 
 	HANDLE handle;
 };
+
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+
+// Read only view of a whole file. The file handle can be closed after Map(), the view keeps
+// the file open until Close().
+struct SMappedFileView
+{
+	SMappedFileView()
+		: data(NULL)
+		, size(0)
+	{
+	}
+	~SMappedFileView()
+	{
+		Close();
+	}
+	// Zero sized files can't be mapped. Returns false on error, GetLastError() tells the reason.
+	bool Map(HANDLE file, size_t file_size)
+	{
+		Close();
+#ifdef _WIN32
+		SWinHandle mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (!mapping)
+			return false;
+		data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, file_size);
+		if (!data)
+			return false;
+#else
+		void* p = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, GetFileDescriptor(file), 0);
+		if (p == MAP_FAILED)
+			return false;
+		data = (const char*)p;
+#endif
+		size = file_size;
+		return true;
+	}
+	void Close()
+	{
+		if (data)
+		{
+#ifdef _WIN32
+			::UnmapViewOfFile(data);
+#else
+			munmap((void*)data, size);
+#endif
+			data = NULL;
+			size = 0;
+		}
+	}
+
+	const char* data;
+	size_t size;
+
+private:
+	// non-copyable
+	SMappedFileView(const SMappedFileView&);
+	SMappedFileView& operator=(const SMappedFileView&);
+};
+
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+
+class CCriticalSection
+{
+public:
+	CCriticalSection()		{ InitializeCriticalSection(&m_CriticalSection); }
+	~CCriticalSection()		{ DeleteCriticalSection(&m_CriticalSection); }
+	void Lock()				{ EnterCriticalSection(&m_CriticalSection); }
+	void Unlock()			{ LeaveCriticalSection(&m_CriticalSection); }
+
+private:
+	// non-copyable
+	CCriticalSection(const CCriticalSection&);
+	CCriticalSection& operator=(const CCriticalSection&);
+
+private:
+	CRITICAL_SECTION m_CriticalSection;
+};
+
+// Locks the critical section for the lifetime of this object.
+struct SAutoLock
+{
+	SAutoLock(CCriticalSection& _cs)
+		: cs(_cs)
+	{
+		cs.Lock();
+	}
+	~SAutoLock()
+	{
+		cs.Unlock();
+	}
+
+	CCriticalSection& cs;
+
+private:
+	SAutoLock& operator=(const SAutoLock&);
+};
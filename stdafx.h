@@ -1,16 +1,25 @@
 #pragma once
 
 #include <stdio.h>
+#ifdef _WIN32
 #include <tchar.h>
 
 #include <windows.h>
+#include <process.h>
+#endif
 #include <cassert>
 #include <algorithm>
 #include <vector>
+#include <deque>
 #include <map>
+#include <set>
 #include <string>
 typedef std::basic_string<wchar_t> wstring;
 
+#ifndef _WIN32
+#include "Posix.h"
+#endif
+
 #define ILINE __forceinline
 
 #include "smart.h"
@@ -30,10 +39,13 @@ inline void LogNoNewline(const wchar_t* fmtstr, ...)
 	va_end(args);
 }
 
+// Locking the stream keeps a line together when worker threads are logging at the same time.
 inline void Log(const wchar_t* fmtstr, va_list args)
 {
+	_lock_file(stdout);
 	vwprintf(fmtstr, args);
 	wprintf(L"\n");
+	_unlock_file(stdout);
 }
 
 inline void Log(const wchar_t* fmtstr, ...)
@@ -46,8 +58,10 @@ inline void Log(const wchar_t* fmtstr, ...)
 
 inline void Error(const wchar_t* fmtstr, va_list args)
 {
+	_lock_file(stderr);
 	vfwprintf(stderr, fmtstr, args);
 	fwprintf(stderr, L"\n");
+	_unlock_file(stderr);
 }
 
 inline void Error(const wchar_t* fmtstr, ...)
@@ -61,6 +75,7 @@ inline void Error(const wchar_t* fmtstr, ...)
 
 inline wstring LastErrorToString(DWORD last_error)
 {
+#ifdef _WIN32
 	wstring s;
 	s.resize(0x100);
 	DWORD msg_len = FormatMessage(FORMAT_MESSAGE_FROM_SYSTEM, NULL, last_error, MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT), &s[0], (DWORD)s.size(), NULL);
@@ -72,6 +87,19 @@ inline wstring LastErrorToString(DWORD last_error)
 		return s;
 	}
 	return L"Unknown LastError!";
+#else
+	switch (last_error)
+	{
+	case ERROR_NO_MORE_FILES: return L"There are no more files.";
+	case ERROR_INSUFFICIENT_BUFFER: return L"The data area passed to a system call is too small.";
+	}
+	char buf[0x100];
+	const char* msg = strerror_r((int)last_error, buf, sizeof(buf));
+	wstring s;
+	for (; *msg; ++msg)
+		s.push_back((wchar_t)(unsigned char)*msg);
+	return s;
+#endif
 }
 
 inline void WinError(const wchar_t* fmtstr, ...)
@@ -79,12 +107,14 @@ inline void WinError(const wchar_t* fmtstr, ...)
 	DWORD last_error = GetLastError();
 	wstring last_error_str = LastErrorToString(last_error);
 
+	_lock_file(stdout);
 	va_list args;
 	va_start(args, fmtstr);
 	vwprintf(fmtstr, args);
 	va_end(args);
 
 	wprintf(L" [LastError: %d] %s\n", last_error, last_error_str.c_str());
+	_unlock_file(stdout);
 }
 
 inline wstring DirName(const wchar_t* path)
@@ -109,3 +139,15 @@ inline wstring DirName(const wchar_t* path)
 	}
 	return dir;
 }
+
+// 64 bit FNV-1a hash. Pass the previous result as hash to continue hashing a stream.
+inline ULONGLONG HashBytes(const void* data, size_t size, ULONGLONG hash=14695981039346656037ULL)
+{
+	const unsigned char* p = (const unsigned char*)data;
+	for (size_t i=0; i<size; ++i)
+	{
+		hash ^= p[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}